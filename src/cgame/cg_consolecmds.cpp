@@ -1539,6 +1539,7 @@ static consoleCommand_t commands[] =
 	{ "mod_information", CG_ModInformation_f },
 	{ "incrementVar", CG_IncrementVar_f },
 	{ "extraTrace", CG_ExtraTrace_f },
+	{ "solidListStats", CG_SolidListStats_f },
 };
 
 
@@ -1552,45 +1553,47 @@ Cmd_Argc() / Cmd_Argv()
 */
 qboolean CG_ConsoleCommand(void)
 {
-	const char *cmd;
-	int        i;
-
 	// Arnout - don't allow console commands until a snapshot is present
 	if (!cg.snap)
 	{
 		return qfalse;
 	}
 
-	cmd = CG_Argv(0);
-
-	for (i = 0 ; i < sizeof(commands) / sizeof(commands[0]) ; i++)
+	auto found = ETJump::consoleCommandsHandler->check(CG_Argv(0), []
 	{
-		if (!Q_stricmp(cmd, commands[i].cmd))
+		std::vector<std::string> arguments;
+		for (auto i = 1, argc = trap_Argc(); i < argc; ++i)
 		{
-			commands[i].function();
-			return qtrue;
+			// Zero: cannot use CG_Argv here either. Check serverCommandsHandler on cg_servercommands.c for more info
+			char buf[MAX_TOKEN_CHARS]{};
+			trap_Argv(i, buf, sizeof(buf));
+			arguments.push_back(buf);
 		}
-	}
+		return arguments;
+	});
+
+	return found ? qtrue : qfalse;
+}
 
-	std::vector<std::string> arguments;
-	std::string command = cmd;
-	auto argc = trap_Argc();
-	for (i = 1; i < argc; ++i)
-	{
-		// Zero: cannot use CG_Argv here either. Check serverCommandsHandler on cg_servercommands.c for more info
-		char buf[MAX_TOKEN_CHARS]{};
-		trap_Argv(i, buf, sizeof(buf));
-		arguments.push_back(buf);
-	}
-	
-	bool found = ETJump::consoleCommandsHandler->check(command, arguments);
 
-	if (CG_ConsoleCommandExt(cmd))
+/*
+=================
+CG_RegisterConsoleCommands
+
+Registers the console commands handled by cgame, registering
+a command also lets the client know about it for tab completion
+=================
+*/
+void CG_RegisterConsoleCommands(void)
+{
+	int i;
+
+	for (i = 0 ; i < sizeof(commands) / sizeof(commands[0]) ; i++)
 	{
-		return qtrue;
+		ETJump::consoleCommandsHandler->subscribeRaw(commands[i].cmd, commands[i].function);
 	}
 
-	return found ? qtrue : qfalse;
+	CG_RegisterConsoleCommandsExt();
 }
 
 
@@ -1604,12 +1607,7 @@ so it can perform tab completion
 */
 void CG_InitConsoleCommands(void)
 {
-	int i;
-
-	for (i = 0 ; i < sizeof(commands) / sizeof(commands[0]) ; i++)
-	{
-		trap_AddCommand(commands[i].cmd);
-	}
+	// commands handled by cgame itself are added in CG_RegisterConsoleCommands
 
 	//
 	// the game server will interpret these commands, which will be automatically
@@ -1623,7 +1621,6 @@ void CG_InitConsoleCommands(void)
 	trap_AddCommand("give");
 	trap_AddCommand("god");
 	trap_AddCommand("notarget");
-	trap_AddCommand("noclip");
 	trap_AddCommand("team");
 	trap_AddCommand("follow");
 	trap_AddCommand("addbot");
@@ -1662,7 +1659,6 @@ void CG_InitConsoleCommands(void)
 	trap_AddCommand("speclock");
 	trap_AddCommand("specunlock");
 	trap_AddCommand("statsall");
-	trap_AddCommand("statsdump");
 	trap_AddCommand("timein");
 	trap_AddCommand("timeout");
 	trap_AddCommand("topshots");
@@ -1680,7 +1676,6 @@ void CG_InitConsoleCommands(void)
 	trap_AddCommand("unignore");
 
 	trap_AddCommand("addtt");
-	trap_AddCommand("selectbuddy");
 	trap_AddCommand("selectNextBuddy");     // xkan 9/26/2002
 
 	trap_AddCommand("loadgame");
@@ -1699,46 +1694,18 @@ void CG_InitConsoleCommands(void)
 	trap_AddCommand("call");
 	trap_AddCommand("nogoto");
 	trap_AddCommand("nocall");
-	trap_AddCommand("resetmaxspeed");
 	trap_AddCommand("class");
-	trap_AddCommand("startTimer");
-	trap_AddCommand("stopTimer");
 	trap_AddCommand("vsay");
 	trap_AddCommand("vsay_team");
 	trap_AddCommand("vsay_buddy");
 	trap_AddCommand("info");
-	trap_AddCommand("portal");
 	trap_AddCommand("setspawnpt");
-	trap_AddCommand("minimize");
-	trap_AddCommand("min");
-	trap_AddCommand("man");
-	trap_AddCommand("manual");
-	trap_AddCommand("help");
 	trap_AddCommand("race");
 	trap_AddCommand("listinfo");
 	trap_AddCommand("records");
 	trap_AddCommand("times");
 	trap_AddCommand("ranks");
 
-	// XIS tjl command
-	trap_AddCommand("tjl_enableline"); // display a route by it number (start at 0 to total - 1)
-	trap_AddCommand("tjl_enablejumpmarker"); // display a route by it number (start at 0 to total - 1)
-
-	trap_AddCommand("tjl_record"); // Start record
-	trap_AddCommand("tjl_stoprecord"); // Stop record
-	trap_AddCommand("tjl_listroute"); // Display in console all loaded route or recorded
-	trap_AddCommand("tjl_displaybyname"); // Render a route if name exist
-	trap_AddCommand("tjl_displaynearestroute"); // Render the nearest route to the player position
-	trap_AddCommand("tjl_renameroute"); // Rename a route in the vector 
-	trap_AddCommand("tjl_saveroute"); // Save route in a file
-	trap_AddCommand("tjl_loadroute"); // Load route from a file
-
-	trap_AddCommand("tjl_deleteroute"); // Delete a route
-	trap_AddCommand("tjl_overwriterecording"); // Overwrite a route by name if possible
-
-	trap_AddCommand("tjl_clearrender"); // Clear the current displayed route.
-	trap_AddCommand("tjl_displaybynumber"); // display a route by it number (start at 0 to total - 1)
-
 	trap_AddCommand("setoffset"); // autocompletion
 	trap_AddCommand("interruptRun");
 	trap_AddCommand("tracker_print");
@@ -2,10 +2,14 @@
 // active (after loading) gameplay
 
 #include <algorithm>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 #include "cg_local.h"
 #include "../game/q_shared.h"
 #include "etj_irenderable.h"
+#include "etj_movement_context.h"
 #include "etj_utilities.h"
 #include "../game/etj_numeric_utilities.h"
 #include "../game/etj_string_utilities.h"
@@ -30,40 +34,194 @@ void CG_Text_SetActiveFont(int font)
 	activeFont = font;
 }
 
-int CG_Text_Width_Ext(const char *text, float scale, int limit, fontInfo_t *font)
+namespace ETJump
 {
-	int         count, len;
-	glyphInfo_t *glyph;
-	const char  *s = text;
-	float       out, useScale = scale * font->glyphScale;
+	// Measured width and glyph runs of a string, so text that is drawn
+	// every frame doesn't need to be parsed for color codes every time
+	struct TextLayout
+	{
+		struct Run
+		{
+			// color code starting the run, -1 for the color the text is drawn with
+			int color;
+			std::string glyphs;
+		};
+
+		uint64_t hash;
+		const fontInfo_t *font;
+		int limit;
+		std::string text;
+		// unscaled sum of glyph advances and the tallest glyph
+		float width;
+		float height;
+		// runs past runCount are kept around so their buffers can be reused
+		std::vector<Run> runs;
+		size_t runCount;
+		// neighbours in the least recently used order
+		int newer;
+		int older;
+	};
+
+	// Layouts live in a fixed pool, when it's full the least recently used
+	// one is rebuilt in place. Text that changes every frame (speed, timers)
+	// only cycles through the oldest slots, and the buffers of the slot are
+	// reused so a miss doesn't allocate once the pool has warmed up.
+	static const size_t MaxCachedTextLayouts = 512;
+	static std::vector<TextLayout> textLayouts;
+	static std::unordered_map<uint64_t, int> textLayoutIndex;
+	static int newestTextLayout = -1;
+	static int oldestTextLayout = -1;
+
+	static uint64_t textLayoutHash(const char *text, int limit, const fontInfo_t *font)
+	{
+		// FNV-1a
+		uint64_t hash = 14695981039346656037ULL;
+
+		for (const char *s = text; *s; s++)
+		{
+			hash = (hash ^ static_cast<unsigned char>(*s)) * 1099511628211ULL;
+		}
+		hash = (hash ^ static_cast<uint64_t>(limit)) * 1099511628211ULL;
+		hash = (hash ^ reinterpret_cast<uintptr_t>(font)) * 1099511628211ULL;
+
+		return hash;
+	}
+
+	static void startTextRun(TextLayout& layout, int color)
+	{
+		if (layout.runCount == layout.runs.size())
+		{
+			layout.runs.emplace_back();
+		}
 
-	out = 0;
-	if (text)
+		auto& run = layout.runs[layout.runCount++];
+		run.color = color;
+		run.glyphs.clear();
+	}
+
+	static void buildTextLayout(TextLayout& layout, const char *text, int limit, const fontInfo_t *font)
 	{
+		const char *s = text;
+		int        len, count;
+
+		layout.font     = font;
+		layout.limit    = limit;
+		layout.text     = text;
+		layout.width    = 0;
+		layout.height   = 0;
+		layout.runCount = 0;
+		startTextRun(layout, -1);
+
 		len = strlen(text);
 		if (limit > 0 && len > limit)
 		{
 			len = limit;
 		}
+
 		count = 0;
-		while (s && *s && count < len)
+		while (*s && count < len)
 		{
 			if (Q_IsColorString(s))
 			{
+				startTextRun(layout, *(s + 1) == COLOR_NULL ? -1 : ColorIndex(*(s + 1)));
 				s += 2;
 				continue;
 			}
-			else
+
+			const glyphInfo_t *glyph = &font->glyphs[(unsigned char)*s];
+
+			layout.width += glyph->xSkip;
+			if (layout.height < glyph->height)
+			{
+				layout.height = glyph->height;
+			}
+			layout.runs[layout.runCount - 1].glyphs.push_back(*s);
+			s++;
+			count++;
+		}
+	}
+
+	static void unlinkTextLayout(int index)
+	{
+		auto& layout = textLayouts[index];
+
+		(layout.newer < 0 ? newestTextLayout : textLayouts[layout.newer].older) = layout.older;
+		(layout.older < 0 ? oldestTextLayout : textLayouts[layout.older].newer) = layout.newer;
+	}
+
+	static void linkNewestTextLayout(int index)
+	{
+		auto& layout = textLayouts[index];
+
+		layout.newer = -1;
+		layout.older = newestTextLayout;
+		(newestTextLayout < 0 ? oldestTextLayout : textLayouts[newestTextLayout].newer) = index;
+		newestTextLayout = index;
+	}
+
+	static const TextLayout& textLayout(const char *text, int limit, const fontInfo_t *font)
+	{
+		const auto hash = textLayoutHash(text, limit, font);
+		auto       it   = textLayoutIndex.find(hash);
+		int        index;
+
+		if (it != textLayoutIndex.end())
+		{
+			index = it->second;
+			unlinkTextLayout(index);
+			linkNewestTextLayout(index);
+
+			auto& layout = textLayouts[index];
+			if (layout.font != font || layout.limit != limit || layout.text != text)
 			{
-				glyph = &font->glyphs[(unsigned char)*s];
-				out  += glyph->xSkip;
-				s++;
-				count++;
+				// hash collision, the newer string takes the slot
+				buildTextLayout(layout, text, limit, font);
 			}
+			return layout;
+		}
+
+		if (textLayouts.size() < MaxCachedTextLayouts)
+		{
+			if (textLayouts.empty())
+			{
+				textLayouts.reserve(MaxCachedTextLayouts);
+				textLayoutIndex.reserve(MaxCachedTextLayouts);
+			}
+			index = textLayouts.size();
+			textLayouts.emplace_back();
+		}
+		else
+		{
+			index = oldestTextLayout;
+			unlinkTextLayout(index);
+			textLayoutIndex.erase(textLayouts[index].hash);
 		}
+
+		auto& layout = textLayouts[index];
+		layout.hash = hash;
+		buildTextLayout(layout, text, limit, font);
+		textLayoutIndex[hash] = index;
+		linkNewestTextLayout(index);
+		return layout;
 	}
+}
 
-	return out * useScale;
+void CG_Text_ClearLayoutCache(void)
+{
+	ETJump::textLayouts.clear();
+	ETJump::textLayoutIndex.clear();
+	ETJump::newestTextLayout = -1;
+	ETJump::oldestTextLayout = -1;
+}
+
+int CG_Text_Width_Ext(const char *text, float scale, int limit, fontInfo_t *font)
+{
+	if (!text)
+	{
+		return 0;
+	}
+
+	return ETJump::textLayout(text, limit, font).width * (scale * font->glyphScale);
 }
 
 int CG_Text_Width_Ext(const std::string &text, float scale, int limit, fontInfo_t *font)
@@ -80,42 +238,12 @@ int CG_Text_Width(const char *text, float scale, int limit)
 
 int CG_Text_Height_Ext(const char *text, float scale, int limit, fontInfo_t *font)
 {
-	int         len, count;
-	float       max;
-	glyphInfo_t *glyph;
-	float       useScale;
-	const char  *s = text;
-
-	useScale = scale * font->glyphScale;
-	max      = 0;
-	if (text)
+	if (!text)
 	{
-		len = strlen(text);
-		if (limit > 0 && len > limit)
-		{
-			len = limit;
-		}
-		count = 0;
-		while (s && *s && count < len)
-		{
-			if (Q_IsColorString(s))
-			{
-				s += 2;
-				continue;
-			}
-			else
-			{
-				glyph = &font->glyphs[(unsigned char)*s];
-				if (max < glyph->height)
-				{
-					max = glyph->height;
-				}
-				s++;
-				count++;
-			}
-		}
+		return 0;
 	}
-	return max * useScale;
+
+	return ETJump::textLayout(text, limit, font).height * (scale * font->glyphScale);
 }
 
 int CG_Text_Height_Ext(const std::string &text, float scale, int limit, fontInfo_t *font)
@@ -174,62 +302,57 @@ void CG_Text_Paint_Centred_Ext(float x, float y, float scalex, float scaley, vec
 
 void CG_Text_Paint_Ext(float x, float y, float scalex, float scaley, vec4_t color, const char *text, float adjust, int limit, int style, fontInfo_t *font)
 {
-	int         len, count;
-	vec4_t      newColor;
-	glyphInfo_t *glyph;
+	vec4_t newColor;
+
+	if (!text)
+	{
+		return;
+	}
 
 	scalex *= font->glyphScale;
 	scaley *= font->glyphScale;
 
-	if (text)
+	trap_R_SetColor(color);
+	memcpy(&newColor[0], &color[0], sizeof(vec4_t));
+
+	const auto& layout = ETJump::textLayout(text, limit, font);
+	for (size_t i = 0; i < layout.runCount; i++)
 	{
-		const char *s = text;
-		trap_R_SetColor(color);
-		memcpy(&newColor[0], &color[0], sizeof(vec4_t));
-		len = strlen(text);
-		if (limit > 0 && len > limit)
-		{
-			len = limit;
-		}
-		count = 0;
-		while (s && *s && count < len)
+		const auto& run = layout.runs[i];
+
+		if (i > 0)
 		{
-			glyph = &font->glyphs[(unsigned char)*s];
-			if (Q_IsColorString(s))
+			if (run.color < 0)
 			{
-				if (*(s + 1) == COLOR_NULL)
-				{
-					memcpy(newColor, color, sizeof(newColor));
-				}
-				else
-				{
-					memcpy(newColor, g_color_table[ColorIndex(*(s + 1))], sizeof(newColor));
-					newColor[3] = color[3];
-				}
-				trap_R_SetColor(newColor);
-				s += 2;
-				continue;
+				memcpy(newColor, color, sizeof(newColor));
 			}
 			else
 			{
-				float yadj = scaley * glyph->top;
-				if (style == ITEM_TEXTSTYLE_SHADOWED || style == ITEM_TEXTSTYLE_SHADOWEDMORE)
-				{
-					int ofs = style == ITEM_TEXTSTYLE_SHADOWED ? 1 : 2;
-					colorBlack[3] = newColor[3];
-					trap_R_SetColor(colorBlack);
-					CG_Text_PaintChar_Ext(x + (glyph->pitch * scalex) + ofs, y - yadj + ofs, glyph->imageWidth, glyph->imageHeight, scalex, scaley, glyph->s, glyph->t, glyph->s2, glyph->t2, glyph->glyph);
-					colorBlack[3] = 1.0;
-					trap_R_SetColor(newColor);
-				}
-				CG_Text_PaintChar_Ext(x + (glyph->pitch * scalex), y - yadj, glyph->imageWidth, glyph->imageHeight, scalex, scaley, glyph->s, glyph->t, glyph->s2, glyph->t2, glyph->glyph);
-				x += (glyph->xSkip * scalex) + adjust;
-				s++;
-				count++;
+				memcpy(newColor, g_color_table[run.color], sizeof(newColor));
+				newColor[3] = color[3];
 			}
+			trap_R_SetColor(newColor);
+		}
+
+		for (auto c : run.glyphs)
+		{
+			const glyphInfo_t *glyph = &font->glyphs[(unsigned char)c];
+			float             yadj   = scaley * glyph->top;
+
+			if (style == ITEM_TEXTSTYLE_SHADOWED || style == ITEM_TEXTSTYLE_SHADOWEDMORE)
+			{
+				int ofs = style == ITEM_TEXTSTYLE_SHADOWED ? 1 : 2;
+				colorBlack[3] = newColor[3];
+				trap_R_SetColor(colorBlack);
+				CG_Text_PaintChar_Ext(x + (glyph->pitch * scalex) + ofs, y - yadj + ofs, glyph->imageWidth, glyph->imageHeight, scalex, scaley, glyph->s, glyph->t, glyph->s2, glyph->t2, glyph->glyph);
+				colorBlack[3] = 1.0;
+				trap_R_SetColor(newColor);
+			}
+			CG_Text_PaintChar_Ext(x + (glyph->pitch * scalex), y - yadj, glyph->imageWidth, glyph->imageHeight, scalex, scaley, glyph->s, glyph->t, glyph->s2, glyph->t2, glyph->glyph);
+			x += (glyph->xSkip * scalex) + adjust;
 		}
-		trap_R_SetColor(NULL);
 	}
+	trap_R_SetColor(NULL);
 }
 
 void CG_Text_Paint_Ext(float x, float y, float scalex, float scaley, vec4_t color, const std::string &text, float adjust, int limit, int style, fontInfo_t *font)
@@ -244,18 +367,6 @@ void CG_Text_Paint(float x, float y, float scale, vec4_t color, const char *text
 	CG_Text_Paint_Ext(x, y, scale, scale, color, text, adjust, limit, style, font);
 }
 
-namespace ETJump
-{
-	static playerState_t* getValidPlayerState()
-	{
-		return (cg.snap->ps.clientNum != cg.clientNum)
-			// spectating
-			? &cg.snap->ps
-			// playing
-			: &cg.predictedPlayerState;
-	}
-}
-
 // NERVE - SMF - added back in
 int CG_DrawFieldWidth(int x, int y, int width, int value, int charWidth, int charHeight)
 {
@@ -573,7 +684,7 @@ static float CG_DrawSpeed(float y)
 
 		if (cg_speedXYonly.integer)
 		{
-			speed = sqrt(cg.predictedPlayerState.velocity[0] * cg.predictedPlayerState.velocity[0] + cg.predictedPlayerState.velocity[1] * cg.predictedPlayerState.velocity[1]);
+			speed = ETJump::movementContext.speed;
 		}
 		else
 		{
@@ -2342,7 +2453,7 @@ static void CG_DrawCrosshair(void)
 		vec4_t crosshairColor = { 1.0, 1.0, 1.0, 1.0 };
 		float crosshairAlpha = cg_crosshairAlpha.value;
 
-		ETJump::parseColorString(cg_crosshairColor.string, crosshairColor);
+		ETJump::parseColorCvar(cg_crosshairColor, crosshairColor);
 		crosshairColor[3] = Numeric::clamp(crosshairAlpha, 0.0f, 1.0f);
 		trap_R_SetColor(crosshairColor);
 	}
@@ -2374,7 +2485,7 @@ static void CG_DrawCrosshair(void)
 			vec4_t crosshairColorAlt = { 1.0, 1.0, 1.0, 1.0 };
 			float crosshairAlphaAlt = cg_crosshairAlphaAlt.value;
 
-			ETJump::parseColorString(cg_crosshairColorAlt.string, crosshairColorAlt);
+			ETJump::parseColorCvar(cg_crosshairColorAlt, crosshairColorAlt);
 			crosshairColorAlt[3] = Numeric::clamp(crosshairAlphaAlt, 0.0f, 1.0f);
 			trap_R_SetColor(crosshairColorAlt);
 		}
@@ -2436,7 +2547,7 @@ static float CG_ScanForCrosshairEntity(float *zChange, qboolean *hitClient)
 {
 	trace_t trace;
 //	gentity_t	*traceEnt;
-	vec3_t    start, end;
+	vec3_t    start;
 	float     dist;
 	centity_t *cent;
 
@@ -2444,11 +2555,10 @@ static float CG_ScanForCrosshairEntity(float *zChange, qboolean *hitClient)
 	*hitClient = qfalse;
 
 	VectorCopy(cg.refdef.vieworg, start);
-	VectorMA(start, 8192, cg.refdef.viewaxis[0], end);      //----(SA)	changed from 8192
 
 	cg.crosshairClientNoShoot = qfalse;
 
-	CG_Trace(&trace, start, NULL, NULL, end, cg.snap->ps.clientNum, CONTENTS_SOLID | CONTENTS_BODY | CONTENTS_ITEM);
+	trace = ETJump::movementContext.viewTrace(CONTENTS_SOLID | CONTENTS_BODY | CONTENTS_ITEM, 8192);
 
 	// How far from start to end of trace?
 	dist = VectorDistance(start, trace.endpos);
@@ -2535,6 +2645,7 @@ void CG_CheckForCursorHints(void)
 	centity_t *tracent;
 	vec3_t    pforward, eforward;
 	float     dist;
+	int       mask;
 
 
 	if (cg.renderingThirdPerson)
@@ -2559,14 +2670,17 @@ void CG_CheckForCursorHints(void)
 	VectorCopy(cg.refdef_current->vieworg, start);
 	VectorMA(start, CH_DIST, cg.refdef_current->viewaxis[0], end);
 
+	mask = cg_ghostPlayers.integer == 1 ? MASK_PLAYERSOLID & ~CONTENTS_BODY : MASK_PLAYERSOLID;
+
 //	CG_Trace( &trace, start, vec3_origin, vec3_origin, end, cg.snap->ps.clientNum, MASK_ALL &~CONTENTS_MONSTERCLIP);
-	if (cg_ghostPlayers.integer == 1)
+	if (cg.refdef_current == &cg.refdef)
 	{
-		CG_Trace(&trace, start, vec3_origin, vec3_origin, end, cg.snap->ps.clientNum, MASK_PLAYERSOLID & ~CONTENTS_BODY);
+		// same view as the other HUD traces
+		trace = ETJump::movementContext.viewTrace(mask, CH_DIST);
 	}
 	else
 	{
-		CG_Trace(&trace, start, vec3_origin, vec3_origin, end, cg.snap->ps.clientNum, MASK_PLAYERSOLID);
+		CG_Trace(&trace, start, vec3_origin, vec3_origin, end, cg.snap->ps.clientNum, mask);
 	}
 
 	if (trace.fraction == 1)
@@ -2795,26 +2909,26 @@ static void CG_DrawVote(void)
 
 	if (cgs.applicationEndTime > cg.time && cgs.applicationClient >= 0)
 	{
-		line_a = ETJump::stringFormat("Accept %s's application to join your fireteam?", cgs.clientinfo[cgs.applicationClient].name);
-		line_b = ETJump::stringFormat("Press '%s' for YES, or '%s' for No", str1, str2);
+		line_a = ETJUMP_FORMAT("Accept %s's application to join your fireteam?", cgs.clientinfo[cgs.applicationClient].name);
+		line_b = ETJUMP_FORMAT("Press '%s' for YES, or '%s' for No", str1, str2);
 	}
 
 	if (cgs.propositionEndTime > cg.time && cgs.propositionClient >= 0)
 	{
-		line_a = ETJump::stringFormat("Accept %s's proposition to invite %s to join your fireteam?", cgs.clientinfo[cgs.propositionClient2].name, cgs.clientinfo[cgs.propositionClient].name);
-		line_b = ETJump::stringFormat("Press '%s' for YES, or '%s' for No", str1, str2);
+		line_a = ETJUMP_FORMAT("Accept %s's proposition to invite %s to join your fireteam?", cgs.clientinfo[cgs.propositionClient2].name, cgs.clientinfo[cgs.propositionClient].name);
+		line_b = ETJUMP_FORMAT("Press '%s' for YES, or '%s' for No", str1, str2);
 	}
 
 	if (cgs.invitationEndTime > cg.time && cgs.invitationClient >= 0)
 	{
-		line_a = ETJump::stringFormat("Accept %s's invitation to join their fireteam?", cgs.clientinfo[cgs.invitationClient].name);
-		line_b = ETJump::stringFormat("Press '%s' for YES, or '%s' for No", str1, str2);
+		line_a = ETJUMP_FORMAT("Accept %s's invitation to join their fireteam?", cgs.clientinfo[cgs.invitationClient].name);
+		line_b = ETJUMP_FORMAT("Press '%s' for YES, or '%s' for No", str1, str2);
 	}
 
 	if (cgs.autoFireteamEndTime > cg.time && cgs.autoFireteamNum == -1)
 	{
 		line_a = "Make Fireteam private?";
-		line_b = ETJump::stringFormat("Press '%s' for YES, or '%s' for No", str1, str2);
+		line_b = ETJUMP_FORMAT("Press '%s' for YES, or '%s' for No", str1, str2);
 	}
 
 	if (cgs.voteTime)
@@ -2860,21 +2974,21 @@ static void CG_DrawVote(void)
 
 		if (!(cg.snap->ps.eFlags & EF_VOTED))
 		{
-			line_a = ETJump::stringFormat("VOTE(%i): %s", sec, cgs.voteString);
+			line_a = ETJUMP_FORMAT("VOTE(%i): %s", sec, cgs.voteString);
 			
 			if (cgs.clientinfo[cg.clientNum].team == TEAM_SPECTATOR && etj_spectatorVote.integer <= 0)
 			{
-				line_b = ETJump::stringFormat("YES:%i, NO:%i (%s)", cgs.voteYes, cgs.voteNo, "Spectators can't vote");
+				line_b = ETJUMP_FORMAT("YES:%i, NO:%i (%s)", cgs.voteYes, cgs.voteNo, "Spectators can't vote");
 			}
 			else
 			{
-				line_b = ETJump::stringFormat("YES(%s):%i, NO(%s):%i", str1, cgs.voteYes, str2, cgs.voteNo);
+				line_b = ETJUMP_FORMAT("YES(%s):%i, NO(%s):%i", str1, cgs.voteYes, str2, cgs.voteNo);
 			}
 		}
 		else
 		{
-			line_a = ETJump::stringFormat("(%i) YOU VOTED ON: %s", sec, cgs.voteString);
-			line_b = ETJump::stringFormat("Y:%i, N:%i", cgs.voteYes, cgs.voteNo);
+			line_a = ETJUMP_FORMAT("(%i) YOU VOTED ON: %s", sec, cgs.voteString);
+			line_b = ETJUMP_FORMAT("Y:%i, N:%i", cgs.voteYes, cgs.voteNo);
 			x_b = 13;
 
 			if (cgs.votedYes)
@@ -2883,7 +2997,7 @@ static void CG_DrawVote(void)
 			}
 			else
 			{
-				std::string yesVotes = ETJump::stringFormat("Y:%i", cgs.voteYes);
+				std::string yesVotes = ETJUMP_FORMAT("Y:%i", cgs.voteYes);
 				auto textWidth = ETJump::DrawStringWidth(yesVotes.c_str(), 0.23f);
 				CG_DrawRect_FixedBorder(x_b + textWidth + 13, 214 - 10 + 12, 11, 12, 1, color);
 			}
@@ -3102,11 +3216,11 @@ static void CG_DrawSpectatorMessage(void)
 	{
 		str2 = "ESCAPE";
 	}
-	str = ETJump::stringFormat("Press %s to open Limbo Menu", str2);
+	str = ETJUMP_FORMAT("Press %s to open Limbo Menu", str2);
 	ETJump::DrawString(8, 154 + 12, 0.23f, 0.25f, colorWhite, qtrue, str.c_str(), 0, ITEM_TEXTSTYLE_SHADOWED);
 
 	str2 = BindingFromName("+attack");
-	str  = ETJump::stringFormat("Press %s to follow next player", str2);
+	str  = ETJUMP_FORMAT("Press %s to follow next player", str2);
 	ETJump::DrawString(8, 172 + 12, 0.23f, 0.25f, colorWhite, qtrue, str.c_str(), 0, ITEM_TEXTSTYLE_SHADOWED);
 
 #ifdef MV_SUPPORT
@@ -3196,7 +3310,7 @@ static void CG_DrawLimboMessage(void)
 	}
 
 	// JPW NERVE
-	str = ETJump::stringFormat("Reinforcements deploy in %d seconds.", CG_CalculateReinfTime(qfalse));
+	str = ETJUMP_FORMAT("Reinforcements deploy in %d seconds.", CG_CalculateReinfTime(qfalse));
 	ETJump::DrawString(INFOTEXT_STARTX, y, 0.23f, 0.25f, color, qfalse, str.c_str(), 0, 0);
 }
 // -NERVE - SMF
@@ -3257,7 +3371,6 @@ static void CG_DrawOB(void)
 	float         v0;
 	float         h0, t;
 	trace_t       trace;
-	vec3_t        start, end;
 	float         x;
 
 	if (!cg_drawOB.integer || cg_thirdPerson.integer)
@@ -3286,13 +3399,7 @@ static void CG_DrawOB(void)
 	if (ps->groundEntityNum == ENTITYNUM_NONE)
 	{
 		// below ob
-		VectorCopy(ps->origin, start);
-		start[2] = h0;
-		VectorCopy(start, end);
-		end[2] -= 131072;
-
-		CG_Trace(&trace, start, vec3_origin, vec3_origin, end, ps->clientNum,
-		         traceContents);
+		trace = ETJump::movementContext.groundTrace(traceContents);
 
 		if (trace.fraction != 1.0 && trace.plane.type == 2)
 		{
@@ -3310,11 +3417,7 @@ static void CG_DrawOB(void)
 	}
 
 	// use origin from playerState?
-	VectorCopy(cg.refdef.vieworg, start);
-	VectorMA(start, 131072, cg.refdef.viewaxis[0], end);
-
-	CG_Trace(&trace, start, vec3_origin, vec3_origin, end, ps->clientNum,
-	         traceContents);
+	trace = ETJump::movementContext.viewTrace(traceContents, ETJump::MovementContext::TraceDistance);
 
 	if (trace.fraction != 1.0 && trace.plane.type == 2)
 	{
@@ -3381,7 +3484,6 @@ static void CG_DrawOB(void)
 static void CG_DrawSlick(void)
 {
 	trace_t       trace;
-	vec3_t        start, end;
 	const float   minWalkNormal = 0.7;
 	float         x;
 
@@ -3392,16 +3494,11 @@ static void CG_DrawSlick(void)
 
 	int traceContents = ETJump::checkExtraTrace(ETJump::SLICK_DETECTOR);
 
-	playerState_t *ps = ETJump::getValidPlayerState();
-
 	x = cg_slickX.value;
 
 	ETJump_AdjustPosition(&x);
 
-	VectorCopy(cg.refdef.vieworg, start);
-	VectorMA(start, 8192, cg.refdef.viewaxis[0], end);
-
-	CG_Trace(&trace, start, NULL, NULL, end, ps->clientNum, traceContents);
+	trace = ETJump::movementContext.viewTrace(traceContents, 8192);
 
 	if ((trace.fraction != 1.0 && trace.surfaceFlags & SURF_SLICK) ||
 	    (trace.plane.normal[2] > 0 && trace.plane.normal[2] < minWalkNormal))
@@ -3414,7 +3511,6 @@ static void CG_DrawSlick(void)
 static void CG_DrawJumpDelay(void)
 {
 	trace_t trace;
-	vec3_t start, end;
 	float x = etj_noJumpDelayX.integer;
 	float y = etj_noJumpDelayY.integer;
 
@@ -3425,13 +3521,8 @@ static void CG_DrawJumpDelay(void)
 
 	int traceContents = ETJump::checkExtraTrace(ETJump::NJD_DETECTOR);
 
-	playerState_t *ps = ETJump::getValidPlayerState();
-
 	ETJump_AdjustPosition(&x);
-	VectorCopy(cg.refdef.vieworg, start);
-	VectorMA(start, 8192, cg.refdef.viewaxis[0], end);
-
-	CG_Trace(&trace, start, nullptr, nullptr, end, ps->clientNum, traceContents);
+	trace = ETJump::movementContext.viewTrace(traceContents, 8192);
 
 	if (trace.surfaceFlags & SURF_NOJUMPDELAY)
 	{
@@ -3681,7 +3772,7 @@ static qboolean CG_DrawFollow(void)
 
 	if (cg.snap->ps.clientNum != cg.clientNum)
 	{
-		std::string str = ETJump::stringFormat("^7Following %s^7", cgs.clientinfo[cg.snap->ps.clientNum].name);
+		std::string str = ETJUMP_FORMAT("^7Following %s^7", cgs.clientinfo[cg.snap->ps.clientNum].name);
 		ETJump::DrawString(INFOTEXT_STARTX, 118 + 12, 0.23f, 0.25f, colorWhite, qfalse, str.c_str(), 0, ITEM_TEXTSTYLE_SHADOWED);
 	}
 
@@ -5924,7 +6015,7 @@ void SetFov(float fov)
 
 static void CG_ChangeFovBasedOnSpeed()
 {
-	float speed           = sqrt(cg.predictedPlayerState.velocity[0] * cg.predictedPlayerState.velocity[0] + cg.predictedPlayerState.velocity[1] * cg.predictedPlayerState.velocity[1]);
+	float speed           = ETJump::movementContext.speed;
 	float speedDiff       = speed - movie_fovMinSpeed.value;
 	float additionalFov   = movie_fovMax.value - movie_fovMin.value;
 	float minMaxSpeedDiff = movie_fovMaxSpeed.value - movie_fovMinSpeed.value;
@@ -572,7 +572,7 @@ static void CG_CHS_DrawSingleInfo(int x, int y, int stat, qboolean drawName, ali
 		textStyle = ITEM_TEXTSTYLE_SHADOWED;
 	}
 
-	ETJump::parseColorString(etj_CHSColor.string, CHSColor);
+	ETJump::parseColorCvar(etj_CHSColor, CHSColor);
 
 	CHSColor[3] = Numeric::clamp(textAlpha, 0.0f, 1.0f);
 	// end alpha, shadow and color stuff
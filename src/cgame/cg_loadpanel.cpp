@@ -251,6 +251,7 @@ void CG_LoadPanel_Init()
 
 	DC->registerFont("ariblk", 27, &bg_loadscreenfont1);
 	DC->registerFont("courbd", 30, &bg_loadscreenfont2);
+	CG_Text_ClearLayoutCache();
 
 	bg_loadscreenbg = DC->registerShaderNoMip("white");
 
@@ -1177,9 +1177,11 @@ typedef struct
 
 	centity_t *satchelCharge;
 
+	// etj_optimizePrediction: predicted state after each usercmd,
+	// valid from backupStateTail up to lastPredictedCommand
 	playerState_t backupStates[MAX_BACKUP_STATES];
-	int backupStateTop;
 	int backupStateTail;
+	int backupStateSnapshot;                // serverTime of the snapshot the states were checked against
 	int lastPredictedCommand;
 	int lastPhysicsTime;
 
@@ -2570,6 +2572,7 @@ extern vmCvar_t etj_tjlMarkerColor;
 extern vmCvar_t etj_tjlMarkerEndColor;
 extern vmCvar_t etj_tjlNearestInterval;
 extern vmCvar_t etj_tjlAlwaysLoadTJL;
+extern vmCvar_t etj_tjlSmoothLine;
 
 extern vmCvar_t etj_playerOpacity;
 extern vmCvar_t etj_simplePlayersColor;
@@ -2633,6 +2636,7 @@ extern vmCvar_t etj_onRunEnd;
 extern vmCvar_t etj_lagometerX;
 extern vmCvar_t etj_lagometerY;
 extern vmCvar_t etj_spectatorVote;
+extern vmCvar_t etj_optimizePrediction;
 
 // Autodemo
 extern vmCvar_t etj_autoDemo;
@@ -2674,6 +2678,7 @@ void CG_StartMusic(void);
 void CG_QueueMusic(void);
 
 void CG_UpdateCvars(void);
+void CG_CvarSet(const char *var_name);
 
 int CG_CrosshairPlayer(void);
 int CG_LastAttacker(void);
@@ -2821,6 +2826,7 @@ int CG_Text_Width(const char *text, float scale, int limit);
 int CG_Text_Height_Ext(const char *text, float scale, int limit, fontInfo_t *font);
 int CG_Text_Height_Ext(const std::string &text, float scale, int limit, fontInfo_t *font);
 int CG_Text_Height(const char *text, float scale, int limit);
+void CG_Text_ClearLayoutCache(void);
 float CG_GetValue(int ownerDraw, int type); // 'type' is relative or absolute (fractional-'0.5' or absolute- '50' health)
 qboolean CG_OwnerDrawVisible(int flags);
 void CG_RunMenuScript(char **args);
@@ -2862,6 +2868,7 @@ int CG_NewParticleArea(int num);
 // cg_predict.c
 //
 void CG_BuildSolidList(void);
+void CG_SolidListStats_f(void);
 int CG_PointContents(const vec3_t point, int passEntityNum);
 void CG_Trace(trace_t *result, const vec3_t start, const vec3_t mins, const vec3_t maxs, const vec3_t end, int skipNumber, int mask);
 void CG_FTTrace(trace_t *result, const vec3_t start, const vec3_t mins, const vec3_t maxs, const vec3_t end, int skipNumber, int mask);
@@ -3200,6 +3207,7 @@ oidInfo_t *CG_OIDInfoForEntityNum(int num);
 //
 extern const char *aMonths[12];
 qboolean CG_ConsoleCommand(void);
+void CG_RegisterConsoleCommands(void);
 void CG_InitConsoleCommands(void);
 void CG_ScoresDown_f(void);
 void CG_ScoresUp_f(void);
@@ -3237,6 +3245,7 @@ void CG_FreecamGetPos_f(void);
 // cg_servercmds.c
 //
 void CG_ExecuteNewServerCommands(int latestSequence);
+void CG_RegisterServerCommands(void);
 void CG_ParseServerinfo(void);
 void CG_ParseWolfinfo(void);            // NERVE - SMF
 void CG_ParseSpawns(void);
@@ -4012,6 +4021,7 @@ namespace ETJump
 	void onPlayerRespawn(qboolean revived);
 	void runFrameEnd();
 	void DrawCGazHUD();
+	void InitSnapHUD();
 	void DrawSnapHUD();
 
 	enum extraTraceOptions {
@@ -4028,7 +4038,7 @@ namespace ETJump
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-qboolean CG_ConsoleCommandExt(const char *cmd);
+void CG_RegisterConsoleCommandsExt();
 void CG_DrawActiveFrameExt();
 
 extern displayContextDef_t *DC;
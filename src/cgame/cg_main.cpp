@@ -17,6 +17,7 @@
 #include "etj_client_authentication.h"
 #include "etj_operating_system.h"
 #include "etj_cvar_update_handler.h"
+#include "../game/etj_cvar_update_scheduler.h"
 #include "etj_cvar_shadow.h"
 #include "etj_console_alpha.h"
 #include "etj_draw_leaves_handler.h"
@@ -498,6 +499,7 @@ vmCvar_t etj_tjlMarkerColor;
 vmCvar_t etj_tjlMarkerEndColor;
 vmCvar_t etj_tjlNearestInterval;
 vmCvar_t etj_tjlAlwaysLoadTJL;
+vmCvar_t etj_tjlSmoothLine;
 
 vmCvar_t etj_enableTimeruns;
 
@@ -563,6 +565,7 @@ vmCvar_t etj_lagometerX;
 vmCvar_t etj_lagometerY;
 vmCvar_t etj_spectatorVote;
 vmCvar_t etj_extraTrace;
+vmCvar_t etj_optimizePrediction;
 
 // Autodemo
 vmCvar_t etj_autoDemo;
@@ -588,9 +591,14 @@ typedef struct
 	const char *cvarName;
 	const char *defaultString;
 	int cvarFlags;
+	int updateFlags;                // CVU_* flags
 	int modificationCount;
 } cvarTable_t;
 
+// cvarTable_t update flags
+#define CVU_EVERYFRAME  0x01    // polled on every frame instead of in round-robin slices, required for anything prediction reads
+#define CVU_CLIENTFLAGS 0x02    // sent to the server through cg_uinfo, see CG_setClientFlags
+
 cvarTable_t cvarTable[] =
 {
 	{ &cg_ignore,                   "cg_ignore",                   "0",                      0                        }, // used for debugging
@@ -641,7 +649,7 @@ cvarTable_t cvarTable[] =
 	{ &cg_bobpitch,                 "cg_bobpitch",                 "0",                      CVAR_ARCHIVE             },
 	{ &cg_bobroll,                  "cg_bobroll",                  "0",                      CVAR_ARCHIVE             },
 	{ &cg_bobyaw,                   "cg_bobyaw",                   "0",                      CVAR_ARCHIVE             },
-	{ &cg_autoactivate,             "cg_autoactivate",             "1",                      CVAR_ARCHIVE             },
+	{ &cg_autoactivate,             "cg_autoactivate",             "1",                      CVAR_ARCHIVE,             CVU_EVERYFRAME | CVU_CLIENTFLAGS },
 	{ &cg_swingSpeed,               "cg_swingSpeed",               "0.1",                    CVAR_CHEAT               }, // was 0.3 for Q3
 	{ &cg_bloodTime,                "cg_bloodTime",                "120",                    CVAR_ARCHIVE             },
 	{ &cg_skybox,                   "cg_skybox",                   "1",                      CVAR_CHEAT               },
@@ -653,10 +661,10 @@ cvarTable_t cvarTable[] =
 	{ &cg_debugAnim,                "cg_debuganim",                "0",                      CVAR_CHEAT               },
 	{ &cg_debugPosition,            "cg_debugposition",            "0",                      CVAR_CHEAT               },
 	{ &cg_debugEvents,              "cg_debugevents",              "0",                      CVAR_CHEAT               },
-	{ &cg_errorDecay,               "cg_errordecay",               "100",                    0                        },
-	{ &cg_nopredict,                "cg_nopredict",                "0",                      CVAR_CHEAT               },
+	{ &cg_errorDecay,               "cg_errordecay",               "100",                    0,                        CVU_EVERYFRAME },
+	{ &cg_nopredict,                "cg_nopredict",                "0",                      CVAR_CHEAT,               CVU_EVERYFRAME },
 	{ &cg_noPlayerAnims,            "cg_noplayeranims",            "0",                      CVAR_CHEAT               },
-	{ &cg_showmiss,                 "cg_showmiss",                 "0",                      0                        },
+	{ &cg_showmiss,                 "cg_showmiss",                 "0",                      0,                        CVU_EVERYFRAME },
 	{ &cg_footsteps,                "cg_footsteps",                "1",                      CVAR_CHEAT               },
 	{ &cg_tracerChance,             "cg_tracerchance",             "0.4",                    CVAR_CHEAT               },
 	{ &cg_tracerWidth,              "cg_tracerwidth",              "0.8",                    CVAR_CHEAT               },
@@ -669,7 +677,7 @@ cvarTable_t cvarTable[] =
 	{ &cg_teamChatHeight,           "cg_teamChatHeight",           "8",                      CVAR_ARCHIVE             },
 	{ &cg_coronafardist,            "cg_coronafardist",            "1536",                   CVAR_ARCHIVE             },
 	{ &cg_coronas,                  "cg_coronas",                  "1",                      CVAR_ARCHIVE             },
-	{ &cg_predictItems,             "cg_predictItems",             "1",                      CVAR_ARCHIVE             },
+	{ &cg_predictItems,             "cg_predictItems",             "1",                      CVAR_ARCHIVE,             CVU_EVERYFRAME | CVU_CLIENTFLAGS },
 	{ &cg_deferPlayers,             "cg_deferPlayers",             "1",                      CVAR_ARCHIVE             },
 	{ &cg_drawTeamOverlay,          "cg_drawTeamOverlay",          "2",                      CVAR_ARCHIVE             },
 	{ &cg_stats,                    "cg_stats",                    "0",                      0                        },
@@ -681,8 +689,8 @@ cvarTable_t cvarTable[] =
 	{ &cg_timescaleFadeSpeed,       "cg_timescaleFadeSpeed",       "0",                      0                        },
 	{ &cg_timescale,                "timescale",                   "1",                      0                        },
 	{ &cg_cameraMode,               "com_cameraMode",              "0",                      CVAR_CHEAT               },
-	{ &pmove_fixed,                 "pmove_fixed",                 "1",                      0                        },
-	{ &pmove_msec,                  "pmove_msec",                  "8",                      CVAR_CHEAT               },
+	{ &pmove_fixed,                 "pmove_fixed",                 "1",                      0,                        CVU_EVERYFRAME | CVU_CLIENTFLAGS },
+	{ &pmove_msec,                  "pmove_msec",                  "8",                      CVAR_CHEAT,               CVU_EVERYFRAME },
 	{ &cg_noTaunt,                  "cg_noTaunt",                  "0",                      CVAR_ARCHIVE             }, // NERVE - SMF
 	{ &cg_voiceSpriteTime,          "cg_voiceSpriteTime",          "6000",                   CVAR_ARCHIVE             }, // DHM - Nerve
 	{ &cg_smallFont,                "ui_smallFont",                "0.25",                   CVAR_ARCHIVE             },
@@ -694,11 +702,11 @@ cvarTable_t cvarTable[] =
 	{ &cg_paused,                   "cl_paused",                   "0",                      CVAR_ROM                 },
 	{ &cg_blood,                    "cg_showblood",                "1",                      CVAR_ARCHIVE             },
 	{ &cg_wolfparticles,            "cg_wolfparticles",            "1",                      CVAR_ARCHIVE             },
-	{ &cg_gameType,                 "g_gametype",                  "0",                      0                        }, // communicated by systeminfo
+	{ &cg_gameType,                 "g_gametype",                  "0",                      0,                        CVU_EVERYFRAME }, // communicated by systeminfo
 	{ &cg_norender,                 "cg_norender",                 "0",                      0                        }, // only used during single player, to suppress rendering until the server is ready
 	{ &cg_bluelimbotime,            "",                            "30000",                  0                        }, // communicated by systeminfo
 	{ &cg_redlimbotime,             "",                            "30000",                  0                        }, // communicated by systeminfo
-	{ &cg_movespeed,                "g_movespeed",                 "76",                     0                        }, // actual movespeed of player
+	{ &cg_movespeed,                "g_movespeed",                 "76",                     0,                        CVU_EVERYFRAME }, // actual movespeed of player
 	{ &cg_animState,                "cg_animState",                "0",                      CVAR_CHEAT               },
 	{ &cg_drawCompass,              "cg_drawCompass",              "1",                      CVAR_ARCHIVE             },
 	{ &cg_drawNotifyText,           "cg_drawNotifyText",           "1",                      CVAR_ARCHIVE             },
@@ -709,8 +717,8 @@ cvarTable_t cvarTable[] =
 	{ &developer,                   "developer",                   "0",                      CVAR_CHEAT               },
 	{ &cf_wstats,                   "cf_wstats",                   "1.2",                    CVAR_ARCHIVE             },
 	{ &cf_wtopshots,                "cf_wtopshots",                "1.0",                    CVAR_ARCHIVE             },
-	{ &cg_autoAction,               "cg_autoAction",               "0",                      CVAR_ARCHIVE             },
-	{ &cg_autoReload,               "cg_autoReload",               "1",                      CVAR_ARCHIVE             },
+	{ &cg_autoAction,               "cg_autoAction",               "0",                      CVAR_ARCHIVE,             CVU_CLIENTFLAGS },
+	{ &cg_autoReload,               "cg_autoReload",               "1",                      CVAR_ARCHIVE,             CVU_CLIENTFLAGS },
 	{ &cg_bloodDamageBlend,         "cg_bloodDamageBlend",         "1.0",                    CVAR_ARCHIVE             },
 	{ &cg_bloodFlash,               "cg_bloodFlash",               "1.0",                    CVAR_ARCHIVE             },
 	{ &cg_complaintPopUp,           "cg_complaintPopUp",           "1",                      CVAR_ARCHIVE             },
@@ -733,9 +741,9 @@ cvarTable_t cvarTable[] =
 	{ &demo_avifpsF5,               "demo_avifpsF5",               "24",                     CVAR_ARCHIVE             },
 	{ &demo_drawTimeScale,          "demo_drawTimeScale",          "1",                      CVAR_ARCHIVE             },
 	{ &demo_infoWindow,             "demo_infoWindow",             "1",                      CVAR_ARCHIVE             },
-	{ &int_cl_maxpackets,           "cl_maxpackets",               "30",                     CVAR_ARCHIVE             },
-	{ &int_cl_timenudge,            "cl_timenudge",                "0",                      CVAR_ARCHIVE             },
-	{ &int_m_pitch,                 "m_pitch",                     "0.022",                  CVAR_ARCHIVE             },
+	{ &int_cl_maxpackets,           "cl_maxpackets",               "30",                     CVAR_ARCHIVE,             CVU_CLIENTFLAGS },
+	{ &int_cl_timenudge,            "cl_timenudge",                "0",                      CVAR_ARCHIVE,             CVU_EVERYFRAME | CVU_CLIENTFLAGS },
+	{ &int_m_pitch,                 "m_pitch",                     "0.022",                  CVAR_ARCHIVE,             CVU_CLIENTFLAGS },
 	{ &int_sensitivity,             "sensitivity",                 "5",                      CVAR_ARCHIVE             },
 	{ &int_ui_blackout,             "ui_blackout",                 "0",                      CVAR_ROM                 },
 	{ &cg_atmosphericEffects,       "cg_atmosphericEffects",       "1",                      CVAR_ARCHIVE             },
@@ -745,7 +753,7 @@ cvarTable_t cvarTable[] =
 
 	{ &cg_drawRoundTimer,           "cg_drawRoundTimer",           "1",                      CVAR_ARCHIVE             },
 	// Gordon: optimization cvars: 18/12/02 enabled by default now
-	{ &cg_fastSolids,               "cg_fastSolids",               "1",                      CVAR_ARCHIVE             },
+	{ &cg_fastSolids,               "cg_fastSolids",               "1",                      CVAR_ARCHIVE,             CVU_EVERYFRAME },
 
 	{ &cg_instanttapout,            "cg_instanttapout",            "0",                      CVAR_ARCHIVE             },
 	{ &cg_debugSkills,              "cg_debugSkills",              "0",                      0                        },
@@ -766,12 +774,12 @@ cvarTable_t cvarTable[] =
 	{ &cg_ghostPlayers,             "",                            "0",                      0                        },
 	{ &cg_hide,                     "etj_hide",                    "1",                      CVAR_ARCHIVE             },
 	{ &cg_hideDistance,             "etj_hideDistance",            "128",                    CVAR_ARCHIVE             },
-	{ &cg_hideMe,                   "etj_hideMe",                  "0",                      CVAR_ARCHIVE             },
-	{ &cg_nofatigue,                "etj_nofatigue",               "1",                      CVAR_ARCHIVE             },
-	{ &com_maxfps,                  "com_maxfps",                  "76",                     CVAR_ARCHIVE             },
+	{ &cg_hideMe,                   "etj_hideMe",                  "0",                      CVAR_ARCHIVE,             CVU_CLIENTFLAGS },
+	{ &cg_nofatigue,                "etj_nofatigue",               "1",                      CVAR_ARCHIVE,             CVU_CLIENTFLAGS },
+	{ &com_maxfps,                  "com_maxfps",                  "76",                     CVAR_ARCHIVE,             CVU_EVERYFRAME | CVU_CLIENTFLAGS },
 	{ &com_hunkmegs,                "com_hunkmegs",                "128",                    CVAR_ARCHIVE             },
 
-	{ &etj_drawCGaz,                 "etj_drawCGaz",                "0",                      CVAR_ARCHIVE             },
+	{ &etj_drawCGaz,                 "etj_drawCGaz",                "0",                      CVAR_ARCHIVE,             CVU_CLIENTFLAGS },
 	{ &cg_drawOB,                   "etj_drawOB",                  "0",                      CVAR_ARCHIVE             },
 	{ &etj_OBX,                     "etj_OBX",                     "320",                    CVAR_ARCHIVE             },
 	{ &etj_OBY,                     "etj_OBY",                     "220",                    CVAR_ARCHIVE             },
@@ -787,8 +795,8 @@ cvarTable_t cvarTable[] =
 	{ &etj_CGaz5Color4,              "etj_CGaz5Color4",              "1.0 1.0 0.0 1.0",       CVAR_ARCHIVE },
 	{ &etj_CGaz5Fov,              "etj_CGaz5Fov",              "0",       CVAR_ARCHIVE },
 
-	{ &cl_yawspeed,                 "cl_yawspeed",                 "0",                      CVAR_ARCHIVE             },
-	{ &cl_freelook,                 "cl_freelook",                 "1",                      CVAR_ARCHIVE             },
+	{ &cl_yawspeed,                 "cl_yawspeed",                 "0",                      CVAR_ARCHIVE,             CVU_CLIENTFLAGS },
+	{ &cl_freelook,                 "cl_freelook",                 "1",                      CVAR_ARCHIVE,             CVU_CLIENTFLAGS },
 	{ &cg_drawCGazUsers,            "etj_drawCGazUsers",           "1",                      CVAR_ARCHIVE             },
 	{ &etj_drawKeys,                "etj_drawKeys",                "1",                      CVAR_ARCHIVE             },
 	{ &etj_keysColor,               "etj_keysColor",               "white",                  CVAR_ARCHIVE             },
@@ -796,7 +804,7 @@ cvarTable_t cvarTable[] =
 	{ &etj_keysX,                   "etj_keysX",                   "610",                    CVAR_ARCHIVE             },
 	{ &etj_keysY,                   "etj_keysY",                   "220",                    CVAR_ARCHIVE             },
 	{ &etj_keysShadow,              "etj_keysShadow",              "0",                      CVAR_ARCHIVE             },
-	{ &cg_loadviewangles,           "etj_loadviewangles",          "1",                      CVAR_ARCHIVE             },
+	{ &cg_loadviewangles,           "etj_loadviewangles",          "1",                      CVAR_ARCHIVE,             CVU_CLIENTFLAGS },
 	{ &cg_drawspeed,                "etj_drawspeed",               "1",                      CVAR_ARCHIVE             },
 	{ &cg_speedXYonly,              "etj_speedXYonly",             "1",                      CVAR_ARCHIVE             },
 	{ &cg_speedinterval,            "etj_speedinterval",           "100",                    CVAR_ARCHIVE             },
@@ -878,7 +886,7 @@ cvarTable_t cvarTable[] =
 	
 	{ &etj_logBanner,               "etj_logBanner",               "1",                      CVAR_ARCHIVE             },
 	{ &cg_weaponSound,              "etj_weaponSound",             "1",                      CVAR_ARCHIVE             },
-	{ &cg_noclipScale,              "etj_noclipScale",             "1",                      CVAR_ARCHIVE             },
+	{ &cg_noclipScale,              "etj_noclipScale",             "1",                      CVAR_ARCHIVE,             CVU_EVERYFRAME | CVU_CLIENTFLAGS },
 	{ &cg_drawSlick,                "etj_drawSlick",               "1",                      CVAR_ARCHIVE             },
 	{ &cg_slickX,                   "etj_slickX",                  "304",                    CVAR_ARCHIVE             },
 	{ &cg_slickY,                   "etj_slickY",                  "220",                    CVAR_ARCHIVE             },
@@ -915,9 +923,10 @@ cvarTable_t cvarTable[] =
 	{ &etj_tjlMarkerEndColor,		"etj_tjlMarkerEndColor",		"red",					 CVAR_ARCHIVE			  },
 	{ &etj_tjlNearestInterval,		"etj_tjlNearestInterval",		"0",					 CVAR_ARCHIVE			  },
 	{ &etj_tjlAlwaysLoadTJL,		"etj_tjlAlwaysLoadTJL",			"1",					 CVAR_ARCHIVE			  },
+	{ &etj_tjlSmoothLine,			"etj_tjlSmoothLine",			"0",					 CVAR_ARCHIVE			  },
 
 
-	{&etj_enableTimeruns, "etj_enableTimeruns", "1", CVAR_ARCHIVE},
+	{&etj_enableTimeruns, "etj_enableTimeruns", "1", CVAR_ARCHIVE, CVU_CLIENTFLAGS},
 	{ &etj_playerOpacity,      "etj_playerOpacity",     "1.0",                    CVAR_ARCHIVE             },
 	{ &etj_simplePlayersColor,        "etj_simplePlayersColor",       "1.0 1.0 1.0",            CVAR_ARCHIVE             },
 	{ &etj_hideFadeRange,    "etj_hideFadeRange",   "200",                    CVAR_ARCHIVE             },
@@ -925,8 +934,8 @@ cvarTable_t cvarTable[] =
 	{ &etj_explosivesShake,          "etj_explosivesShake",         "3",                      CVAR_ARCHIVE             },
 	{ &etj_realFov,                  "etj_realFov",                 "0",                      CVAR_ARCHIVE             },
 	{ &etj_stretchCgaz,              "etj_stretchCgaz",             "1",                      CVAR_ARCHIVE             },
-	{ &etj_noActivateLean,           "etj_noActivateLean",          "0",                      CVAR_ARCHIVE             },
-	{ &shared, "shared", "0", CVAR_ROM },
+	{ &etj_noActivateLean,           "etj_noActivateLean",          "0",                      CVAR_ARCHIVE,             CVU_EVERYFRAME | CVU_CLIENTFLAGS },
+	{ &shared, "shared", "0", CVAR_ROM, CVU_EVERYFRAME },
 	{ &etj_drawObWatcher , "etj_drawObWatcher", "1", CVAR_ARCHIVE},
 	{ &etj_obWatcherX , "etj_obWatcherX", "100", CVAR_ARCHIVE},
 	{ &etj_obWatcherY , "etj_obWatcherY", "100", CVAR_ARCHIVE},
@@ -958,9 +967,9 @@ cvarTable_t cvarTable[] =
 	{ &etj_consoleColor, "etj_consoleColor", "0.0 0.0 0.0", CVAR_LATCH | CVAR_ARCHIVE },
 	{ &etj_consoleShader, "etj_consoleShader", "1", CVAR_LATCH | CVAR_ARCHIVE },
 	{ &etj_drawLeaves, "etj_drawLeaves", "1", CVAR_ARCHIVE },
-	{ &etj_touchPickupWeapons, "etj_touchPickupWeapons", "0", CVAR_ARCHIVE },
-	{ &etj_autoLoad, "etj_autoLoad", "1", CVAR_ARCHIVE },
-	{ &etj_quickFollow, "etj_quickFollow", "2", CVAR_ARCHIVE },
+	{ &etj_touchPickupWeapons, "etj_touchPickupWeapons", "0", CVAR_ARCHIVE, CVU_CLIENTFLAGS },
+	{ &etj_autoLoad, "etj_autoLoad", "1", CVAR_ARCHIVE, CVU_CLIENTFLAGS },
+	{ &etj_quickFollow, "etj_quickFollow", "2", CVAR_ARCHIVE, CVU_CLIENTFLAGS },
 	{ &etj_drawProneIndicator, "etj_drawProneIndicator", "3", CVAR_ARCHIVE },
 	{ &etj_proneIndicatorX, "etj_proneIndicatorX", "615", CVAR_ARCHIVE },
 	{ &etj_proneIndicatorY, "etj_proneIndicatorY", "338", CVAR_ARCHIVE },
@@ -973,6 +982,7 @@ cvarTable_t cvarTable[] =
 	{ &etj_lagometerY, "etj_lagometerY", "0", CVAR_ARCHIVE },
 	{ &etj_spectatorVote, "", "0", 0 },
 	{ &etj_extraTrace, "etj_extraTrace", "0", CVAR_ARCHIVE },
+	{ &etj_optimizePrediction, "etj_optimizePrediction", "1", CVAR_ARCHIVE, CVU_EVERYFRAME },
 	// Autodemo
 	{ &etj_autoDemo, "etj_autoDemo", "0", CVAR_ARCHIVE },
 	{ &etj_ad_savePBOnly, "etj_ad_savePBOnly", "0", CVAR_ARCHIVE },
@@ -980,7 +990,7 @@ cvarTable_t cvarTable[] =
 	{ &etj_ad_targetPath, "etj_ad_targetPath", "autodemo", CVAR_ARCHIVE },
 	{ &etj_chatScale, "etj_chatScale", "1.0", CVAR_ARCHIVE },
 	// Snaphud
-	{ &etj_drawSnapHUD, "etj_drawSnapHUD", "0", CVAR_ARCHIVE },
+	{ &etj_drawSnapHUD, "etj_drawSnapHUD", "0", CVAR_ARCHIVE, CVU_CLIENTFLAGS },
 	{ &etj_snapHUDOffsetY, "etj_snapHUDOffsetY", "0", CVAR_ARCHIVE },
 	{ &etj_snapHUDHeight, "etj_snapHUDHeight", "10", CVAR_ARCHIVE },
 	{ &etj_snapHUDColor1, "etj_snapHUDColor1", "0.0 1.0 1.0 0.75", CVAR_ARCHIVE },
@@ -992,6 +1002,7 @@ cvarTable_t cvarTable[] =
 
 int      cvarTableSize = sizeof(cvarTable) / sizeof(cvarTable[0]);
 qboolean cvarsLoaded   = qfalse;
+static ETJump::CvarUpdateScheduler cvarUpdateScheduler;
 void CG_setClientFlags(void);
 
 namespace ETJump
@@ -1069,6 +1080,15 @@ void CG_RegisterCvars(void)
 		}
 	}
 
+	cvarUpdateScheduler.clear();
+	for (i = 0, cv = cvarTable ; i < cvarTableSize ; i++, cv++)
+	{
+		if (cv->vmCvar != NULL)
+		{
+			cvarUpdateScheduler.add(i, cv->cvarName, (cv->updateFlags & CVU_EVERYFRAME) != 0);
+		}
+	}
+
 	// shadow cvars mapping to real cvars, forces locked values change
 	std::vector<std::pair<vmCvar_t*, std::string>> cvars {
 		{ &etj_drawFoliage, "r_drawfoliage"},
@@ -1106,77 +1126,70 @@ CG_UpdateCvars
 */
 void CG_UpdateCvars(void)
 {
-	int         i;
-	qboolean    fSetFlags = qfalse;
-	cvarTable_t *cv;
+	static std::vector<cvarTable_t *> modified;
+	qboolean                          fSetFlags = qfalse;
 
 	if (!cvarsLoaded)
 	{
 		return;
 	}
 
-	for (i = 0, cv = cvarTable ; i < cvarTableSize ; i++, cv++)
+	// most cvars are polled in round-robin slices, see CvarUpdateScheduler
+	modified.clear();
+	for (auto index : cvarUpdateScheduler.nextFrame())
 	{
-		if (cv->vmCvar)
+		auto cv = &cvarTable[index];
+
+		trap_Cvar_Update(cv->vmCvar);
+		if (cv->modificationCount != cv->vmCvar->modificationCount)
 		{
-			trap_Cvar_Update(cv->vmCvar);
-			if (cv->modificationCount != cv->vmCvar->modificationCount)
-			{
-				cv->modificationCount = cv->vmCvar->modificationCount;
+			cv->modificationCount = cv->vmCvar->modificationCount;
+			modified.push_back(cv);
+		}
+	}
 
-				// Check if we need to update any client flags to be sent to the server
-				if (cv->vmCvar == &cg_autoAction || cv->vmCvar == &cg_autoReload ||
-					cv->vmCvar == &int_cl_timenudge || cv->vmCvar == &int_cl_maxpackets ||
-					cv->vmCvar == &cg_autoactivate || cv->vmCvar == &cg_predictItems ||
-					cv->vmCvar == &pmove_fixed || cv->vmCvar == &com_maxfps ||
-					cv->vmCvar == &cg_nofatigue || cv->vmCvar == &etj_drawCGaz ||
-					cv->vmCvar == &cl_yawspeed || cv->vmCvar == &cl_freelook ||
-					cv->vmCvar == &int_m_pitch || cv->vmCvar == &cg_loadviewangles ||
-					cv->vmCvar == &cg_hideMe || cv->vmCvar == &cg_noclipScale ||
-					cv->vmCvar == &etj_enableTimeruns || cv->vmCvar == &etj_noActivateLean ||
-					cv->vmCvar == &etj_touchPickupWeapons || cv->vmCvar == &etj_autoLoad ||
-					cv->vmCvar == &etj_quickFollow || cv->vmCvar == &etj_drawSnapHUD
-				    )
-				{
-					fSetFlags = qtrue;
-				}
-				else if (cv->vmCvar == &cg_rconPassword && *cg_rconPassword.string)
-				{
-					trap_SendConsoleCommand(va("rconAuth %s", cg_rconPassword.string));
-				}
-				else if (cv->vmCvar == &cg_refereePassword && *cg_refereePassword.string)
-				{
-					trap_SendConsoleCommand(va("ref %s", cg_refereePassword.string));
-				}
-				else if (cv->vmCvar == &demo_infoWindow)
-				{
-					if (demo_infoWindow.integer == 0 && cg.demohelpWindow == SHOW_ON)
-					{
-						CG_ShowHelp_On(&cg.demohelpWindow);
-					}
-					else if (demo_infoWindow.integer > 0 && cg.demohelpWindow != SHOW_ON)
-					{
-						CG_ShowHelp_On(&cg.demohelpWindow);
-					}
-				}
-				else if (cv->vmCvar == &cg_errorDecay)
-				{
-					// rain - cap errordecay because
-					// prediction is EXTREMELY broken
-					// right now.
-					if (cg_errorDecay.value < 0.0)
-					{
-						trap_Cvar_Set("cg_errorDecay", "0");
-					}
-					else if (cg_errorDecay.value > 500.0)
-					{
-						trap_Cvar_Set("cg_errorDecay", "500");
-					}
-				}
-
-				ETJump::cvarUpdateHandler->check(cv->vmCvar);
+	for (auto cv : modified)
+	{
+		// Check if we need to update any client flags to be sent to the server
+		if (cv->updateFlags & CVU_CLIENTFLAGS)
+		{
+			fSetFlags = qtrue;
+		}
+		else if (cv->vmCvar == &cg_rconPassword && *cg_rconPassword.string)
+		{
+			trap_SendConsoleCommand(va("rconAuth %s", cg_rconPassword.string));
+		}
+		else if (cv->vmCvar == &cg_refereePassword && *cg_refereePassword.string)
+		{
+			trap_SendConsoleCommand(va("ref %s", cg_refereePassword.string));
+		}
+		else if (cv->vmCvar == &demo_infoWindow)
+		{
+			if (demo_infoWindow.integer == 0 && cg.demohelpWindow == SHOW_ON)
+			{
+				CG_ShowHelp_On(&cg.demohelpWindow);
+			}
+			else if (demo_infoWindow.integer > 0 && cg.demohelpWindow != SHOW_ON)
+			{
+				CG_ShowHelp_On(&cg.demohelpWindow);
+			}
+		}
+		else if (cv->vmCvar == &cg_errorDecay)
+		{
+			// rain - cap errordecay because
+			// prediction is EXTREMELY broken
+			// right now.
+			if (cg_errorDecay.value < 0.0)
+			{
+				trap_Cvar_Set("cg_errorDecay", "0");
+			}
+			else if (cg_errorDecay.value > 500.0)
+			{
+				trap_Cvar_Set("cg_errorDecay", "500");
 			}
 		}
+
+		ETJump::cvarUpdateHandler->check(cv->vmCvar);
 	}
 
 	// Send any relevent updates
@@ -1186,6 +1199,19 @@ void CG_UpdateCvars(void)
 	}
 }
 
+/*
+=================
+CG_CvarSet
+
+Called when cgame sets a cvar, so the change is picked up
+on the next frame instead of when its slice comes around.
+=================
+*/
+void CG_CvarSet(const char *var_name)
+{
+	cvarUpdateScheduler.cvarSet(var_name);
+}
+
 void CG_setClientFlags(void)
 {
 	if (cg.demoPlayback)
@@ -2564,6 +2590,7 @@ static void CG_RegisterGraphics(void)
 	trap_R_RegisterFont("ariblk", 27, &cgs.media.limboFont1);
 	trap_R_RegisterFont("ariblk", 16, &cgs.media.limboFont1_lo);
 	trap_R_RegisterFont("courbd", 30, &cgs.media.limboFont2);
+	CG_Text_ClearLayoutCache();
 
 	cgs.media.medal_back = trap_R_RegisterShaderNoMip("gfx/limbo/medal_back");
 
@@ -2843,6 +2870,7 @@ qboolean CG_Asset_Parse(int handle)
 				return qfalse;
 			}
 			cgDC.registerFont(tempStr, pointSize, &cgDC.Assets.fonts[fontIndex]);
+			CG_Text_ClearLayoutCache();
 			continue;
 		}
 
@@ -3713,6 +3741,8 @@ void CG_Init(int serverMessageNum, int serverCommandSequence, int clientNum, qbo
 	// => make sure they're created first
 	ETJump::serverCommandsHandler = std::make_shared<ETJump::ClientCommandsHandler>(nullptr);
 	ETJump::consoleCommandsHandler = std::make_shared<ETJump::ClientCommandsHandler>(trap_AddCommand);
+	CG_RegisterServerCommands();
+	CG_RegisterConsoleCommands();
 	ETJump::entityEventsHandler = std::make_shared<ETJump::EntityEventsHandler>();
 	ETJump::operatingSystem = std::make_shared<ETJump::OperatingSystem>();
 	ETJump::authentication = std::make_shared<ETJump::ClientAuthentication>([](const std::string& command)
@@ -3733,7 +3763,10 @@ void CG_Init(int serverMessageNum, int serverCommandSequence, int clientNum, qbo
             Com_Printf(text);
         }
     );
-	ETJump::eventLoop = std::make_shared<ETJump::EventLoop>();
+	ETJump::eventLoop = std::make_shared<ETJump::EventLoop>([]
+	{
+		return static_cast<int64_t>(cg.time);
+	});
 
 	////////////////////////////////////////////////////////////////
 	// TODO: move these to own client commands handler
@@ -3759,6 +3792,7 @@ void CG_Init(int serverMessageNum, int serverCommandSequence, int clientNum, qbo
 	auto keySetSystem = new ETJump::KeySetSystem(etj_drawKeys);
 	ETJump::renderables.push_back(std::unique_ptr<ETJump::IRenderable>(keySetSystem));
 	ETJump::initDrawKeys(keySetSystem);
+	ETJump::InitSnapHUD();
 	ETJump::autoDemoRecorder = std::make_shared<ETJump::AutoDemoRecorder>();
 
 	CG_Printf("done\n");
@@ -3844,6 +3878,9 @@ void CG_Shutdown(void)
 		ETJump::isInitialized = false;
 	}
 
+	// fonts are registered again after vid_restart
+	CG_Text_ClearLayoutCache();
+
 	Shutdown_Display();
 }
 
@@ -5,6 +5,7 @@
 #include "etj_event_loop.h"
 #include "etj_awaited_command_handler.h"
 #include "etj_player_events_handler.h"
+#include "etj_client_commands_handler.h"
 
 #include <string>
 #include <memory>
@@ -87,17 +88,15 @@ void InitGame()
 }
 
 /**
- * Extended CG_ServerCommand function. Checks whether server
- * sent command matches to any defined here. If no match is found
- * returns false
- * @return qboolean Whether a match was found or not
+ * Registers the ETJump specific server commands to the
+ * server commands handler
  */
-qboolean CG_ServerCommandExt(const char *cmd)
+void CG_RegisterServerCommandsExt()
 {
-	const std::string command = cmd != nullptr ? cmd : "";
+	auto& commands = *ETJump::serverCommandsHandler;
 
 	// timerun_start runStartTime{integer} runName{string}
-	if (command == "timerun_start")
+	commands.subscribeRaw("timerun_start", []
 	{
 		auto        startTime      = atoi(CG_Argv(1));
 		std::string runName        = CG_Argv(2);
@@ -106,14 +105,13 @@ qboolean CG_ServerCommandExt(const char *cmd)
 		ETJump::execCmdOnRunStart();
 		// run name, completion time, previous record
 		ETJump::playerEventsHandler->check("timerun:start", {runName, CG_Argv(1), CG_Argv(3) });
-		return qtrue;
-	}
+	});
 	// timerun_start_spec clientNum{integer} runStartTime{integer} runName{string}
-	if (command == "timerun_start_spec")
+	commands.subscribeRaw("timerun_start_spec", []
 	{
 		if (cgs.clientinfo[cg.clientNum].team != TEAM_SPECTATOR)
 		{
-			return qtrue;
+			return;
 		}
 
 		auto        clientNum      = atoi(CG_Argv(1));
@@ -122,17 +120,14 @@ qboolean CG_ServerCommandExt(const char *cmd)
 		auto        previousRecord = atoi(CG_Argv(4));
 
 		timerun->startSpectatorTimerun(clientNum, runName, runStartTime, previousRecord);
-
-		return qtrue;
-	}
-	if (command == "timerun_interrupt")
+	});
+	commands.subscribeRaw("timerun_interrupt", []
 	{
 		timerun->interrupt();
 		ETJump::execCmdOnRunEnd();
-		return qtrue;
-	}
+	});
 	// timerun_stop completionTime{integer}
-	if (command == "timerun_stop")
+	commands.subscribeRaw("timerun_stop", []
 	{
 		auto completionTime = atoi(CG_Argv(1));
 
@@ -140,14 +135,13 @@ qboolean CG_ServerCommandExt(const char *cmd)
 		ETJump::execCmdOnRunEnd();
 		// run name, completion time
 		ETJump::playerEventsHandler->check("timerun:stop", { CG_Argv(2), CG_Argv(1) });
-		return qtrue;
-	}
+	});
 	// timerun_stop_spec clientNum{integer} completionTime{integer} runName{string}
-	if (command == "timerun_stop_spec")
+	commands.subscribeRaw("timerun_stop_spec", []
 	{
 		if (cgs.clientinfo[cg.clientNum].team != TEAM_SPECTATOR)
 		{
-			return qtrue;
+			return;
 		}
 
 		auto        clientNum      = atoi(CG_Argv(1));
@@ -155,10 +149,8 @@ qboolean CG_ServerCommandExt(const char *cmd)
 		std::string runName        = CG_Argv(3);
 
 		timerun->stopSpectatorTimerun(clientNum, completionTime, runName);
-
-		return qtrue;
-	}
-	if (command == "record")
+	});
+	commands.subscribeRaw("record", []
 	{
 		auto        clientNum      = atoi(CG_Argv(1));
 		std::string runName        = CG_Argv(2);
@@ -171,10 +163,8 @@ qboolean CG_ServerCommandExt(const char *cmd)
 			// run name, completion time
 			ETJump::playerEventsHandler->check("timerun:record", { CG_Argv(2), CG_Argv(3) });
 		}
-
-		return qtrue;
-	}
-	if (command == "completion")
+	});
+	commands.subscribeRaw("completion", []
 	{
 		auto        clientNum      = atoi(CG_Argv(1));
 		std::string runName        = CG_Argv(2);
@@ -187,55 +177,49 @@ qboolean CG_ServerCommandExt(const char *cmd)
 			// run name, completion time
 			ETJump::playerEventsHandler->check("timerun:completion", { CG_Argv(2), CG_Argv(3) });
 		}
-
-		return qtrue;
-	}
-	if (command == "timerun")
+	});
+	commands.subscribeRaw("timerun", []
 	{
-		return timerunView->parseServerCommand() ? qtrue : qfalse;
-	}
+		timerunView->parseServerCommand();
+	});
 
-	if (command == "tjl_displaybyname")
+	commands.subscribeRaw("tjl_displaybyname", []
 	{
-		return CG_displaybyname();
-	}
+		CG_displaybyname();
+	});
 
-	if (command == "tjl_displaybynumber")
+	commands.subscribeRaw("tjl_displaybynumber", []
 	{
-		return CG_displaybynumber();
-	}
-
-	return qfalse;
+		CG_displaybynumber();
+	});
 }
 
 
 /**
-* Checks if the command exists and calls the handler
-* @param cmd The command to be matched
-* @returns qboolean Whether a match was found
+* Registers the trickjump line console commands to the
+* console commands handler
 */
-qboolean CG_ConsoleCommandExt(const char *cmd)
+void CG_RegisterConsoleCommandsExt()
 {
-	const std::string command = cmd ? cmd : "";
+	auto& commands = *ETJump::consoleCommandsHandler;
 
-	if (command == "tjl_displaybyname")
+	commands.subscribeRaw("tjl_displaybyname", []
 	{
-		return CG_displaybyname();
-	}
+		CG_displaybyname();
+	});
 
-	if (command == "tjl_displaybynumber")
+	commands.subscribeRaw("tjl_displaybynumber", []
 	{
-		return CG_displaybynumber();
-	}
+		CG_displaybynumber();
+	});
 
-	if (command == "tjl_clearrender")
+	commands.subscribeRaw("tjl_clearrender", []
 	{
 		trickjumpLines->setCurrentRouteToRender(-1);
-		return qtrue;
-	}
+	});
 
 	// TODO: could just make an array out of this and go thru it
-	if (command == "tjl_record")
+	commands.subscribeRaw("tjl_record", []
 	{
 		const auto argc = trap_Argc();
 		if (argc == 1)
@@ -247,29 +231,25 @@ qboolean CG_ConsoleCommandExt(const char *cmd)
 			auto name = CG_Argv(1);
 			trickjumpLines->record(name);
 		}
-		return qtrue;
-	}
+	});
 
-	if (command == "tjl_stoprecord")
+	commands.subscribeRaw("tjl_stoprecord", []
 	{
 		trickjumpLines->stopRecord();
-		return qtrue;
-	}
+	});
 
-	if (command == "tjl_listroute")
+	commands.subscribeRaw("tjl_listroute", []
 	{
 		trickjumpLines->listRoutes();
-		return qtrue;
-	}
+	});
 
 
-	if (command == "tjl_displaynearestroute")
+	commands.subscribeRaw("tjl_displaynearestroute", []
 	{
 		trickjumpLines->displayNearestRoutes();
-		return qtrue;
-	}
+	});
 
-	if (command == "tjl_renameroute")
+	commands.subscribeRaw("tjl_renameroute", []
 	{
 		const auto argc = trap_Argc();
 
@@ -283,26 +263,38 @@ qboolean CG_ConsoleCommandExt(const char *cmd)
 		{
 			trickjumpLines->renameRoute(nullptr, nullptr);
 		}
-		return qtrue;
-	}
+	});
 
-	if (command == "tjl_saveroute")
+	commands.subscribeRaw("tjl_saveroute", []
 	{
 		const auto argc = trap_Argc();
 		if (argc > 1)
 		{
 			const auto name = CG_Argv(1);
 			trickjumpLines->saveRoutes(name);
-			return qtrue;
+			return;
 		}
 		else
 		{
 			CG_Printf("Please provide a name to save your TJL. (without .tjl extension). \n");
-			return qfalse;
 		}
-	}
+	});
+
+	commands.subscribeRaw("tjl_exportroute", []
+	{
+		const auto argc = trap_Argc();
+		if (argc > 1)
+		{
+			const auto name = CG_Argv(1);
+			trickjumpLines->exportRoutes(name);
+		}
+		else
+		{
+			CG_Printf("Please provide a name to export your TJL as json. (without .tjl extension). \n");
+		}
+	});
 
-	if (command == "tjl_loadroute")
+	commands.subscribeRaw("tjl_loadroute", []
 	{
 		const auto argc = trap_Argc();
 		if (argc > 1)
@@ -314,10 +306,9 @@ qboolean CG_ConsoleCommandExt(const char *cmd)
 		{
 			trickjumpLines->loadRoutes(nullptr);
 		}
-		return qtrue;
-	}
+	});
 
-	if (command == "tjl_deleteroute")
+	commands.subscribeRaw("tjl_deleteroute", []
 	{
 		const auto argc = trap_Argc();
 		if (argc > 1)
@@ -329,10 +320,9 @@ qboolean CG_ConsoleCommandExt(const char *cmd)
 		{
 			trickjumpLines->deleteRoute(nullptr);
 		}
-		return qtrue;
-	}
+	});
 
-	if (command == "tjl_overwriterecording")
+	commands.subscribeRaw("tjl_overwriterecording", []
 	{
 		const auto argc = trap_Argc();
 		if (argc == 1)
@@ -344,16 +334,15 @@ qboolean CG_ConsoleCommandExt(const char *cmd)
 			const auto name = CG_Argv(1);
 			trickjumpLines->overwriteRecording(name);
 		}
-		return qtrue;
-	}
+	});
 
-	if (command == "tjl_enableline")
+	commands.subscribeRaw("tjl_enableline", []
 	{
 		const auto argc = trap_Argc();
 		if (argc == 1)
 		{
 			CG_Printf("Please add 0 or 1 as argument to enable or disable line.\n");
-			return qfalse;
+			return;
 		}
 		else
 		{
@@ -366,17 +355,16 @@ qboolean CG_ConsoleCommandExt(const char *cmd)
 			{
 				trickjumpLines->toggleRoutes(true);
 			}
-			return qtrue;
 		}
-	}
+	});
 
-	if (command == "tjl_enablejumpmarker")
+	commands.subscribeRaw("tjl_enablejumpmarker", []
 	{
 		const auto argc = trap_Argc();
 		if (argc == 1)
 		{
 			CG_Printf("Please add 0 or 1 as argument to enable or disable marker.\n");
-			return qfalse;
+			return;
 		}
 		else
 		{
@@ -390,10 +378,8 @@ qboolean CG_ConsoleCommandExt(const char *cmd)
 			{
 				trickjumpLines->toggleMarker(true);
 			}
-			return qtrue;
 		}
-	}
-	return qfalse;
+	});
 }
 
 // TODO : (Zero) And this prolly should be elsewhere (e.g. cg_view_ext.cpp) but I'll just go with this one
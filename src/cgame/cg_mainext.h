@@ -16,13 +16,15 @@
 void InitGame();
 
 /**
-* Extended CG_ServerCommand function. Checks whether server
-* sent command matches to any defined here. If no match is found
-* returns false
-* @return qboolean Whether a match was found or not
+* Registers the ETJump specific server commands to the
+* server commands handler
 */
-qboolean CG_ServerCommandExt(const char *cmd);
-qboolean CG_ConsoleCommandExt(const char *cmd);
+void CG_RegisterServerCommandsExt();
+/**
+* Registers the trickjump line console commands to the
+* console commands handler
+*/
+void CG_RegisterConsoleCommandsExt();
 void CG_DrawActiveFrameExt();
 
 qboolean CG_displaybyname();
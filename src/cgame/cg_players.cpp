@@ -3492,7 +3492,7 @@ void ETJump_SetEntityAutoTransparency(refEntity_t *ent)
 	// don't allow colors to affect default skins/shaders
 	if (etj_drawSimplePlayers.integer > 0)
 	{
-		ETJump::parseColorString(etj_simplePlayersColor.string, simplePlayersColor);
+		ETJump::parseColorCvar(etj_simplePlayersColor, simplePlayersColor);
 		ent->customShader = cgs.media.simplePlayersShader;
 	}
 	ETJump_SetEntityRGBA(ent, simplePlayersColor[0], simplePlayersColor[1], simplePlayersColor[2], cg.currentTransparencyValue);
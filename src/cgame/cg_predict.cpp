@@ -16,6 +16,319 @@ static centity_t *cg_solidFTEntities[MAX_ENTITIES_IN_SNAPSHOT];
 static int       cg_numTriggerEntities;
 static centity_t *cg_triggerEntities[MAX_ENTITIES_IN_SNAPSHOT];
 
+/*
+====================
+Solid entity grid
+
+Solid entities that don't move are sorted into a uniform grid over
+the XY plane when the solid list is built, so traces and point
+contents only test entities whose bounds overlap the swept box of the
+trace. Moving entities and ones without known bounds are always tested.
+====================
+*/
+
+#define SOLID_GRID_SIZE             64      // cells per axis
+#define SOLID_GRID_MIN_CELL_SIZE    128.0f
+#define SOLID_GRID_MAX_ENTITY_CELLS 64      // entities covering more cells are always tested
+#define SOLID_BOUNDS_EPSILON        1.0f
+
+typedef struct
+{
+	vec3_t mins;
+	vec3_t maxs;
+	int queryNum;                           // last query this entity was returned by
+} solidBounds_t;
+
+static solidBounds_t cg_solidBounds[MAX_ENTITIES_IN_SNAPSHOT];  // same order as cg_solidEntities
+static int           cg_numAlwaysSolids;
+static int           cg_alwaysSolids[MAX_ENTITIES_IN_SNAPSHOT];
+static vec2_t        cg_solidGridMins;
+static vec2_t        cg_solidGridCellSize;
+static int           cg_solidGridCells[SOLID_GRID_SIZE * SOLID_GRID_SIZE + 1];   // first ref of each cell
+static int           cg_solidGridRefs[MAX_ENTITIES_IN_SNAPSHOT * SOLID_GRID_MAX_ENTITY_CELLS];
+static int           cg_solidQueryNum;
+
+// solidListStats
+static int cg_solidTraces;
+static int cg_solidCandidates;
+static int cg_solidMaxCandidates;
+
+/*
+====================
+CG_SolidEntityBounds
+
+Gets the world space bounds of a solid entity,
+returns qfalse if the entity can move between snapshots
+====================
+*/
+static qboolean CG_SolidEntityBounds(const centity_t *cent, vec3_t mins, vec3_t maxs)
+{
+	const entityState_t *ent = &cent->currentState;
+	int                 i, x, zd, zu;
+	float               radius;
+
+	if (ent->pos.trType != TR_STATIONARY || ent->apos.trType != TR_STATIONARY ||
+	    (ent->eFlags & (EF_PATH_LINK | EF_TAGCONNECT)))
+	{
+		return qfalse;
+	}
+
+	// traces use the lerped position, which hasn't caught up with a new entity yet
+	if (!VectorCompare(cent->lerpOrigin, ent->pos.trBase))
+	{
+		return qfalse;
+	}
+
+	if (ent->solid == SOLID_BMODEL)
+	{
+		if (!cgs.inlineDrawModel[ent->modelindex] || !VectorCompare(cent->lerpAngles, ent->apos.trBase))
+		{
+			return qfalse;
+		}
+
+		trap_R_ModelBounds(cgs.inlineDrawModel[ent->modelindex], mins, maxs);
+
+		if (ent->apos.trBase[0] || ent->apos.trBase[1] || ent->apos.trBase[2])
+		{
+			radius = RadiusFromBounds(mins, maxs);
+			VectorSet(mins, -radius, -radius, -radius);
+			VectorSet(maxs, radius, radius, radius);
+		}
+	}
+	else if (ent->eFlags & EF_FAKEBMODEL)
+	{
+		VectorCopy(ent->origin2, mins);
+		VectorCopy(ent->angles2, maxs);
+	}
+	else
+	{
+		x  = (ent->solid & 255);
+		zd = ((ent->solid >> 8) & 255);
+		zu = ((ent->solid >> 16) & 255) - 32;
+
+		VectorSet(mins, -x, -x, -zd);
+		VectorSet(maxs, x, x, zu);
+	}
+
+	for (i = 0; i < 3; i++)
+	{
+		mins[i] += ent->pos.trBase[i] - SOLID_BOUNDS_EPSILON;
+		maxs[i] += ent->pos.trBase[i] + SOLID_BOUNDS_EPSILON;
+	}
+
+	return qtrue;
+}
+
+/*
+====================
+CG_SolidGridRange
+
+Gets the range of grid cells the bounds overlap
+====================
+*/
+static void CG_SolidGridRange(const vec3_t mins, const vec3_t maxs, int cellMins[2], int cellMaxs[2])
+{
+	int i;
+
+	for (i = 0; i < 2; i++)
+	{
+		cellMins[i] = (int)floor((mins[i] - cg_solidGridMins[i]) / cg_solidGridCellSize[i]);
+		cellMaxs[i] = (int)floor((maxs[i] - cg_solidGridMins[i]) / cg_solidGridCellSize[i]);
+
+		cellMins[i] = (int)Com_Clamp(0, SOLID_GRID_SIZE - 1, cellMins[i]);
+		cellMaxs[i] = (int)Com_Clamp(0, SOLID_GRID_SIZE - 1, cellMaxs[i]);
+	}
+}
+
+/*
+====================
+CG_BuildSolidGrid
+
+Sorts the solid entities that don't move into the grid
+====================
+*/
+static void CG_BuildSolidGrid(void)
+{
+	static int cellCounts[SOLID_GRID_SIZE * SOLID_GRID_SIZE];
+	qboolean   gridded[MAX_ENTITIES_IN_SNAPSHOT];
+	vec3_t     gridMins, gridMaxs;
+	int        cellMins[2], cellMaxs[2];
+	int        i, j, x, y, cell;
+
+	cg_numAlwaysSolids = 0;
+	ClearBounds(gridMins, gridMaxs);
+
+	for (i = 0; i < cg_numSolidEntities; i++)
+	{
+		gridded[i] = CG_SolidEntityBounds(cg_solidEntities[i], cg_solidBounds[i].mins, cg_solidBounds[i].maxs);
+		if (gridded[i])
+		{
+			AddPointToBounds(cg_solidBounds[i].mins, gridMins, gridMaxs);
+			AddPointToBounds(cg_solidBounds[i].maxs, gridMins, gridMaxs);
+		}
+		cg_solidBounds[i].queryNum = 0;
+	}
+	cg_solidQueryNum = 0;
+
+	for (j = 0; j < 2; j++)
+	{
+		cg_solidGridMins[j]     = gridMins[j];
+		cg_solidGridCellSize[j] = (gridMaxs[j] - gridMins[j]) / SOLID_GRID_SIZE;
+		if (cg_solidGridCellSize[j] < SOLID_GRID_MIN_CELL_SIZE)
+		{
+			cg_solidGridCellSize[j] = SOLID_GRID_MIN_CELL_SIZE;
+		}
+	}
+
+	memset(cellCounts, 0, sizeof(cellCounts));
+
+	for (i = 0; i < cg_numSolidEntities; i++)
+	{
+		if (gridded[i])
+		{
+			CG_SolidGridRange(cg_solidBounds[i].mins, cg_solidBounds[i].maxs, cellMins, cellMaxs);
+			if ((cellMaxs[0] - cellMins[0] + 1) * (cellMaxs[1] - cellMins[1] + 1) > SOLID_GRID_MAX_ENTITY_CELLS)
+			{
+				gridded[i] = qfalse;
+			}
+		}
+
+		if (!gridded[i])
+		{
+			cg_alwaysSolids[cg_numAlwaysSolids++] = i;
+			continue;
+		}
+
+		for (y = cellMins[1]; y <= cellMaxs[1]; y++)
+		{
+			for (x = cellMins[0]; x <= cellMaxs[0]; x++)
+			{
+				cellCounts[y * SOLID_GRID_SIZE + x]++;
+			}
+		}
+	}
+
+	cg_solidGridCells[0] = 0;
+	for (cell = 0; cell < SOLID_GRID_SIZE * SOLID_GRID_SIZE; cell++)
+	{
+		cg_solidGridCells[cell + 1] = cg_solidGridCells[cell] + cellCounts[cell];
+		cellCounts[cell]            = cg_solidGridCells[cell];
+	}
+
+	// entities are added in solid list order, so each cell stays sorted
+	for (i = 0; i < cg_numSolidEntities; i++)
+	{
+		if (!gridded[i])
+		{
+			continue;
+		}
+
+		CG_SolidGridRange(cg_solidBounds[i].mins, cg_solidBounds[i].maxs, cellMins, cellMaxs);
+		for (y = cellMins[1]; y <= cellMaxs[1]; y++)
+		{
+			for (x = cellMins[0]; x <= cellMaxs[0]; x++)
+			{
+				cg_solidGridRefs[cellCounts[y * SOLID_GRID_SIZE + x]++] = i;
+			}
+		}
+	}
+}
+
+/*
+====================
+CG_SolidCandidates
+
+Fills list with the solid list indices of entities that
+can touch the given box, in solid list order so that
+ties between entities are resolved like before
+====================
+*/
+static int CG_SolidCandidates(const vec3_t mins, const vec3_t maxs, int *list)
+{
+	int cellMins[2], cellMaxs[2];
+	int i, j, x, y, ref, count;
+
+	count = 0;
+	cg_solidQueryNum++;
+
+	for (i = 0; i < cg_numAlwaysSolids; i++)
+	{
+		list[count++] = cg_alwaysSolids[i];
+	}
+
+	CG_SolidGridRange(mins, maxs, cellMins, cellMaxs);
+	for (y = cellMins[1]; y <= cellMaxs[1]; y++)
+	{
+		for (x = cellMins[0]; x <= cellMaxs[0]; x++)
+		{
+			for (ref = cg_solidGridCells[y * SOLID_GRID_SIZE + x]; ref < cg_solidGridCells[y * SOLID_GRID_SIZE + x + 1]; ref++)
+			{
+				solidBounds_t *bounds = &cg_solidBounds[cg_solidGridRefs[ref]];
+
+				if (bounds->queryNum == cg_solidQueryNum)
+				{
+					continue;
+				}
+				bounds->queryNum = cg_solidQueryNum;
+
+				if (bounds->mins[0] > maxs[0] || bounds->mins[1] > maxs[1] || bounds->mins[2] > maxs[2] ||
+				    bounds->maxs[0] < mins[0] || bounds->maxs[1] < mins[1] || bounds->maxs[2] < mins[2])
+				{
+					continue;
+				}
+
+				list[count++] = cg_solidGridRefs[ref];
+			}
+		}
+	}
+
+	// small lists, merge the grid hits into the always tested entities
+	for (i = 1; i < count; i++)
+	{
+		int index = list[i];
+
+		for (j = i - 1; j >= 0 && list[j] > index; j--)
+		{
+			list[j + 1] = list[j];
+		}
+		list[j + 1] = index;
+	}
+
+	cg_solidTraces++;
+	cg_solidCandidates += count;
+	if (count > cg_solidMaxCandidates)
+	{
+		cg_solidMaxCandidates = count;
+	}
+
+	return count;
+}
+
+/*
+====================
+CG_SolidListStats_f
+
+Prints how many solid entities traces had to test on average
+====================
+*/
+void CG_SolidListStats_f(void)
+{
+	if (!Q_stricmp(CG_Argv(1), "reset"))
+	{
+		cg_solidTraces        = 0;
+		cg_solidCandidates    = 0;
+		cg_solidMaxCandidates = 0;
+		CG_Printf("Solid list statistics reset.\n");
+		return;
+	}
+
+	CG_Printf("solid entities:          %i (%i always tested)\n", cg_numSolidEntities, cg_numAlwaysSolids);
+	CG_Printf("grid cell size:          %.0f x %.0f\n", cg_solidGridCellSize[0], cg_solidGridCellSize[1]);
+	CG_Printf("traces:                  %i\n", cg_solidTraces);
+	CG_Printf("candidates per trace:    %.2f (max %i)\n",
+	          cg_solidTraces ? (float)cg_solidCandidates / cg_solidTraces : 0.0f, cg_solidMaxCandidates);
+}
+
 /*
 ====================
 CG_BuildSolidList
@@ -114,6 +427,8 @@ void CG_BuildSolidList(void)
 			}
 		}
 	}
+
+	CG_BuildSolidGrid();
 }
 
 /*
@@ -132,11 +447,23 @@ static void CG_ClipMoveToEntities(const vec3_t start, const vec3_t mins,
 	clipHandle_t  cmodel;
 	vec3_t        bmins, bmaxs;
 	vec3_t        origin, angles;
+	vec3_t        traceMins, traceMaxs;
 	centity_t     *cent;
+	int           candidates[MAX_ENTITIES_IN_SNAPSHOT];
+	int           numCandidates;
+
+	// only clip against entities the swept box can touch,
+	// point traces pass NULL mins and maxs
+	for (i = 0; i < 3; i++)
+	{
+		traceMins[i] = (start[i] < end[i] ? start[i] : end[i]) + (mins ? mins[i] : 0);
+		traceMaxs[i] = (start[i] > end[i] ? start[i] : end[i]) + (maxs ? maxs[i] : 0);
+	}
+	numCandidates = CG_SolidCandidates(traceMins, traceMaxs, candidates);
 
-	for (i = 0 ; i < cg_numSolidEntities ; i++)
+	for (i = 0 ; i < numCandidates ; i++)
 	{
-		cent = cg_solidEntities[i];
+		cent = cg_solidEntities[candidates[i]];
 		ent  = &cent->currentState;
 
 		if (ent->number == skipNumber || (!tracePlayers && ent->eType == ET_PLAYER))
@@ -376,12 +703,15 @@ int     CG_PointContents(const vec3_t point, int passEntityNum)
 	centity_t     *cent;
 	clipHandle_t  cmodel;
 	int           contents;
+	int           candidates[MAX_ENTITIES_IN_SNAPSHOT];
+	int           numCandidates;
 
 	contents = trap_CM_PointContents(point, 0);
 
-	for (i = 0 ; i < cg_numSolidEntities ; i++)
+	numCandidates = CG_SolidCandidates(point, point, candidates);
+	for (i = 0 ; i < numCandidates ; i++)
 	{
-		cent = cg_solidEntities[i];
+		cent = cg_solidEntities[candidates[i]];
 
 		ent = &cent->currentState;
 
@@ -896,11 +1226,64 @@ qboolean CG_PredictionOk(playerState_t *ps1, playerState_t *ps2)
 	return qtrue;
 }
 
-#define RESET_PREDICTION                        \
-	cg.lastPredictedCommand = 0;                \
-	cg.backupStateTail      = cg.backupStateTop;     \
-	useCommand              = current - CMD_BACKUP + 1;
+// ETJump: a stored state can only be resumed from if the server
+// ended up in exactly the same spot, otherwise the optimized
+// prediction would drift from a full replay. Fields the server
+// changes outside of pmove have to match too, a resumed state
+// doesn't pick them up from the snapshot.
+static qboolean CG_PredictionExact(playerState_t *ps1, playerState_t *ps2)
+{
+	int i;
+
+	if (!CG_PredictionOk(ps1, ps2) || !VectorCompare(ps1->origin, ps2->origin) || !VectorCompare(ps1->velocity, ps2->velocity))
+	{
+		return qfalse;
+	}
+
+	if (ps1->weaponDelay != ps2->weaponDelay || ps1->grenadeTimeLeft != ps2->grenadeTimeLeft ||
+	    ps1->curWeapHeat != ps2->curWeapHeat || ps1->classWeaponTime != ps2->classWeaponTime ||
+	    ps1->nextWeapon != ps2->nextWeapon || ps1->item != ps2->item || ps1->teamNum != ps2->teamNum)
+	{
+		return qfalse;
+	}
+
+	if (ps1->gravity != ps2->gravity || ps1->friction != ps2->friction ||
+	    ps1->runSpeedScale != ps2->runSpeedScale || ps1->sprintSpeedScale != ps2->sprintSpeedScale ||
+	    ps1->crouchSpeedScale != ps2->crouchSpeedScale)
+	{
+		return qfalse;
+	}
+
+	if (!VectorCompare(ps1->mins, ps2->mins) || !VectorCompare(ps1->maxs, ps2->maxs) || ps1->crouchMaxZ != ps2->crouchMaxZ ||
+	    ps1->crouchViewHeight != ps2->crouchViewHeight || ps1->standViewHeight != ps2->standViewHeight ||
+	    ps1->deadViewHeight != ps2->deadViewHeight)
+	{
+		return qfalse;
+	}
+
+	if (ps1->holding != ps2->holding)
+	{
+		return qfalse;
+	}
+
+	for (i = 0; i < (int)(sizeof(ps1->holdable) / sizeof(ps1->holdable[0])); i++)
+	{
+		if (ps1->holdable[i] != ps2->holdable[i])
+		{
+			return qfalse;
+		}
+	}
+
+	for (i = 0; i < (int)(sizeof(ps1->weapons) / sizeof(ps1->weapons[0])); i++)
+	{
+		if (ps1->weapons[i] != ps2->weapons[i])
+		{
+			return qfalse;
+		}
+	}
 
+	return qtrue;
+}
 
 /*
 =================
@@ -915,15 +1298,12 @@ playerState_t.
 For normal gameplay, it will be the result of predicted usercmd_t on
 top of the most recent playerState_t received from the server.
 
-Each new snapshot will usually have one or more new usercmd over the last,
-but we simulate all unacknowledged commands each time, not just the new ones.
-This means that on an internet connection, quite a few pmoves may be issued
-each frame.
-
-OPTIMIZE: don't re-simulate unless the newly arrived snapshot playerState_t
-differs from the predicted one.  Would require saving all intermediate
-playerState_t during prediction. (this is "dead reckoning" and would definately
-be nice to have in there (SA))
+Each new snapshot will usually have one or more new usercmd over the last.
+With etj_optimizePrediction the state after every predicted usercmd is
+stored, and as long as the newly arrived snapshot playerState_t matches the
+one we predicted for its commandTime, only the new usercmds are simulated.
+Otherwise all unacknowledged commands are simulated again, which on an
+internet connection means quite a few pmoves each frame.
 
 We detect prediction errors and allow them to be decayed off over several frames
 to ease the jerk.
@@ -939,212 +1319,155 @@ to ease the jerk.
 
 pmoveExt_t oldpmext[CMD_BACKUP];
 
-void CG_PredictPlayerState(void)
-{
-	int           cmdNum, current;
-	playerState_t oldPlayerState;
-	qboolean      moved;
-	usercmd_t     oldestCmd;
-	usercmd_t     latestCmd;
-	vec3_t        deltaAngles;
-	pmoveExt_t    pmext;
-//	int useCommand = 0;
+// pmext after each stored cg.backupStates entry
+static pmoveExt_t backupPmext[MAX_BACKUP_STATES];
 
-	cg.hyperspace = qfalse; // will be set if touching a trigger_teleport
+/*
+=================
+CG_BackupPredictedState
 
-	// if this is the first frame we must guarantee
-	// predictedPlayerState is valid even if there is some
-	// other error condition
-	if (!cg.validPPS)
+Stores the state after cmdNum so later frames can resume from it
+=================
+*/
+static void CG_BackupPredictedState(int cmdNum, const pmoveExt_t *pmext)
+{
+	const int index = cmdNum % MAX_BACKUP_STATES;
+
+	if (!cg.lastPredictedCommand)
 	{
-		cg.validPPS             = qtrue;
-		cg.predictedPlayerState = cg.snap->ps;
+		cg.backupStateTail = cmdNum;
 	}
-
-	// demo playback just copies the moves
-	if ((cg.demoPlayback) || (cg.snap->ps.pm_flags & PMF_FOLLOW))
+	else if (cmdNum - cg.backupStateTail >= MAX_BACKUP_STATES)
 	{
-		CG_InterpolatePlayerState(qfalse);
-		return;
+		cg.backupStateTail = cmdNum - MAX_BACKUP_STATES + 1;
 	}
 
-	// non-predicting local movement will grab the latest angles
-	if (cg_nopredict.integer
-#ifdef ALLOW_GSYNC
-	    || cg_synchronousClients.integer
-#endif // ALLOW_GSYNC
-	    )
-	{
-		cg_pmove.ps    = &cg.predictedPlayerState;
-		cg_pmove.pmext = &cg.pmext;
+	cg.backupStates[index] = cg.predictedPlayerState;
+	memcpy(&backupPmext[index], pmext, sizeof(pmoveExt_t));
+	cg.lastPredictedCommand = cmdNum;
+}
 
-		cg.pmext.airleft = (cg.waterundertime - cg.time);
+/*
+=================
+CG_PredictionSettingsChanged
 
-		// Arnout: are we using an mg42?
-		if (cg_pmove.ps->eFlags & EF_MG42_ACTIVE || cg_pmove.ps->eFlags & EF_AAGUN_ACTIVE)
-		{
-			cg.pmext.harc = cg_entities[cg_pmove.ps->viewlocked_entNum].currentState.origin2[0];
-			cg.pmext.varc = cg_entities[cg_pmove.ps->viewlocked_entNum].currentState.origin2[1];
+Stored states are only valid for the pmove settings they were predicted with
+=================
+*/
+static qboolean CG_PredictionSettingsChanged(void)
+{
+	static int pmoveFixed = -1, pmoveMsec = -1, sharedFlags = -1, tracemask = -1, noActivateLean = -1;
+	static void (*trace)(trace_t *, const vec3_t, const vec3_t, const vec3_t, const vec3_t, int, int) = NULL;
+	qboolean changed;
+
+	changed = (cg_pmove.pmove_fixed != pmoveFixed || cg_pmove.pmove_msec != pmoveMsec ||
+	           cg_pmove.shared != sharedFlags || cg_pmove.tracemask != tracemask ||
+	           etj_noActivateLean.integer != noActivateLean || cg_pmove.trace != trace) ? qtrue : qfalse;
+
+	pmoveFixed     = cg_pmove.pmove_fixed;
+	pmoveMsec      = cg_pmove.pmove_msec;
+	sharedFlags    = cg_pmove.shared;
+	tracemask      = cg_pmove.tracemask;
+	noActivateLean = etj_noActivateLean.integer;
+	trace          = cg_pmove.trace;
+
+	return changed;
+}
 
-			VectorCopy(cg_entities[cg_pmove.ps->viewlocked_entNum].currentState.angles2, cg.pmext.centerangles);
+/*
+=================
+CG_ResumePrediction
 
-			cg.pmext.centerangles[PITCH] = AngleNormalize180(cg.pmext.centerangles[PITCH]);
-			cg.pmext.centerangles[YAW]   = AngleNormalize180(cg.pmext.centerangles[YAW]);
-			cg.pmext.centerangles[ROLL]  = AngleNormalize180(cg.pmext.centerangles[ROLL]);
-		}
-
-		CG_InterpolatePlayerState(qtrue);
-		return;
-	}
+Picks the first usercmd to simulate this frame. If the current snapshot
+matches a stored state, cg.predictedPlayerState and pmext are restored
+from the newest stored state instead of starting over from the snapshot.
+The current usercmd is always simulated again, as its pmext may have
+changed since the last frame.
+=================
+*/
+static int CG_ResumePrediction(int current, pmoveExt_t *pmext)
+{
+	const int oldestCmd = current - CMD_BACKUP + 1;
+	int       resumeCmd, cmdNum;
 
-	if (cg_pmove.ps && cg_pmove.ps->eFlags & EF_MOUNTEDTANK)
+	// always check, so the settings are up to date once optimization is enabled
+	if (CG_PredictionSettingsChanged() || !etj_optimizePrediction.integer ||
+	    !cg.lastPredictedCommand || cg.thisFrameTeleport || cg.serverRespawning)
 	{
-		centity_t *tank = &cg_entities[cg_entities[cg.snap->ps.clientNum].tagParent];
-
-		cg.pmext.centerangles[YAW]   = tank->lerpAngles[YAW];
-		cg.pmext.centerangles[PITCH] = tank->lerpAngles[PITCH];
+		cg.lastPredictedCommand = 0;
+		cg.backupStateSnapshot  = cg.snap->serverTime;
+		return oldestCmd;
 	}
 
-	// prepare for pmove
-	cg_pmove.ps        = &cg.predictedPlayerState;
-	cg_pmove.pmext     = &pmext; //&cg.pmext;
-	cg_pmove.character = CG_CharacterForClientinfo(&cgs.clientinfo[cg.snap->ps.clientNum], &cg_entities[cg.snap->ps.clientNum]);
-	cg.pmext.airleft   = (cg.waterundertime - cg.time);
-
-	// Arnout: are we using an mg42?
-	if (cg_pmove.ps->eFlags & EF_MG42_ACTIVE || cg_pmove.ps->eFlags & EF_AAGUN_ACTIVE)
-	{
-		cg.pmext.harc = cg_entities[cg_pmove.ps->viewlocked_entNum].currentState.origin2[0];
-		cg.pmext.varc = cg_entities[cg_pmove.ps->viewlocked_entNum].currentState.origin2[1];
-
-		VectorCopy(cg_entities[cg_pmove.ps->viewlocked_entNum].currentState.angles2, cg.pmext.centerangles);
-
-		cg.pmext.centerangles[PITCH] = AngleNormalize180(cg.pmext.centerangles[PITCH]);
-		cg.pmext.centerangles[YAW]   = AngleNormalize180(cg.pmext.centerangles[YAW]);
-		cg.pmext.centerangles[ROLL]  = AngleNormalize180(cg.pmext.centerangles[ROLL]);
-	}
-	else if (cg_pmove.ps->eFlags & EF_MOUNTEDTANK)
+	// a new snapshot has to agree with the state we predicted for it
+	if (cg.backupStateSnapshot != cg.snap->serverTime)
 	{
-		centity_t *tank = &cg_entities[cg_entities[cg.snap->ps.clientNum].tagParent];
-
-		cg.pmext.centerangles[PITCH] = tank->lerpAngles[PITCH];
-	}
+		cg.backupStateSnapshot = cg.snap->serverTime;
 
-	cg_pmove.skill = cgs.clientinfo[cg.snap->ps.clientNum].skill;
+		for (cmdNum = cg.lastPredictedCommand; cmdNum >= cg.backupStateTail; cmdNum--)
+		{
+			if (cg.backupStates[cmdNum % MAX_BACKUP_STATES].commandTime <= cg.snap->ps.commandTime)
+			{
+				break;
+			}
+		}
 
-	if (cg_ghostPlayers.integer == 1)
-	{
-		cg_pmove.trace = CG_TraceCapsule_NoPlayers;
-	}
-	else
-	{
-		cg_pmove.trace = CG_TraceCapsule;
-	}
-	//cg_pmove.trace = CG_Trace;
-	cg_pmove.pointcontents = CG_PointContents;
-	if (cg_pmove.ps->pm_type == PM_DEAD)
-	{
-		cg_pmove.tracemask   = MASK_PLAYERSOLID & ~CONTENTS_BODY;
-		cg_pmove.ps->eFlags |= EF_DEAD; // DHM-Nerve added:: EF_DEAD is checked for in Pmove functions, but wasn't being set until after Pmove
-	}
-	else if (cg_pmove.ps->pm_type == PM_SPECTATOR)
-	{
-		// rain - fix the spectator can-move-partway-through-world weirdness
-		// bug by actually setting tracemask when spectating :x
-		cg_pmove.tracemask = MASK_PLAYERSOLID & ~CONTENTS_BODY;
-		cg_pmove.trace     = CG_TraceCapsule_World;
-	}
-	else
-	{
-		cg_pmove.tracemask = MASK_PLAYERSOLID;
-	}
+		if (cmdNum < cg.backupStateTail ||
+		    cg.backupStates[cmdNum % MAX_BACKUP_STATES].commandTime != cg.snap->ps.commandTime ||
+		    !CG_PredictionExact(&cg.snap->ps, &cg.backupStates[cmdNum % MAX_BACKUP_STATES]))
+		{
+			if (cg_showmiss.integer)
+			{
+				CG_Printf("optimized prediction reset\n");
+			}
+			cg.lastPredictedCommand = 0;
+			return oldestCmd;
+		}
 
-	if ((cg.snap->ps.persistant[PERS_TEAM] == TEAM_SPECTATOR) || (cg.snap->ps.pm_flags & PMF_LIMBO))     // JPW NERVE limbo
-	{
-		cg_pmove.tracemask &= ~CONTENTS_BODY;   // spectators can fly through bodies
+		cg.backupStateTail = cmdNum;
 	}
 
-	cg_pmove.noFootsteps = qfalse;
-	cg_pmove.noWeapClips = qfalse;
-
-	// save the state before the pmove so we can detect transitions
-	oldPlayerState = cg.predictedPlayerState;
-
-	current = trap_GetCurrentCmdNumber();
-
-	// rain - fill in the current cmd with the latest prediction from
-	// cg.pmext (#166)
-
-	if (cg_noclipScale.value < 0.1)
-	{
-		cg.pmext.noclipScale = 0.1;
-	}
-	else if (cg_noclipScale.value > 20)
+	resumeCmd = cg.lastPredictedCommand < current ? cg.lastPredictedCommand : current - 1;
+	if (resumeCmd < cg.backupStateTail || resumeCmd < oldestCmd)
 	{
-		cg.pmext.noclipScale = 20;
-	}
-	else
-	{
-		cg.pmext.noclipScale = cg_noclipScale.value;
+		cg.lastPredictedCommand = 0;
+		return oldestCmd;
 	}
 
-	memcpy(&oldpmext[current & CMD_MASK], &cg.pmext, sizeof(pmoveExt_t));
-
-	// if we don't have the commands right after the snapshot, we
-	// can't accurately predict a current position, so just freeze at
-	// the last good position we had
-	cmdNum = current - CMD_BACKUP + 1;
-	trap_GetUserCmd(cmdNum, &oldestCmd);
-	if (oldestCmd.serverTime > cg.snap->ps.commandTime
-	    && oldestCmd.serverTime < cg.time)      // special check for map_restart
-	{
-		if (cg_showmiss.integer)
-		{
-			CG_Printf("exceeded PACKET_BACKUP on commands\n");
-		}
-	}
+	cg.predictedPlayerState = cg.backupStates[resumeCmd % MAX_BACKUP_STATES];
+	memcpy(pmext, &backupPmext[resumeCmd % MAX_BACKUP_STATES], sizeof(pmoveExt_t));
 
-	// get the latest command so we can know which commands are from previous map_restarts
-	trap_GetUserCmd(current, &latestCmd);
+	// pmove never touches these, take them from the snapshot like a full replay would
+	cg.predictedPlayerState.ping                  = cg.snap->ps.ping;
+	cg.predictedPlayerState.serverCursorHint      = cg.snap->ps.serverCursorHint;
+	cg.predictedPlayerState.serverCursorHintVal   = cg.snap->ps.serverCursorHintVal;
+	cg.predictedPlayerState.serverCursorHintTrace = cg.snap->ps.serverCursorHintTrace;
+	cg.predictedPlayerState.identifyClient        = cg.snap->ps.identifyClient;
+	cg.predictedPlayerState.identifyClientHealth  = cg.snap->ps.identifyClientHealth;
 
-	// get the most recent information we have, even if
-	// the server time is beyond our current cg.time,
-	// because predicted player positions are going to
-	// be ahead of everything else anyway
-	// rain - NEIN - this'll cause us to execute events from the next frame
-	// early, resulting in doubled events and the like.  it seems to be
-	// worse as far as prediction, too, so BLAH at id. (#405)
-#if 0
-	if (cg.nextSnap && !cg.nextFrameTeleport && !cg.thisFrameTeleport)
-	{
-		cg.predictedPlayerState = cg.nextSnap->ps;
-		cg.physicsTime          = cg.nextSnap->serverTime;
-	}
-	else
-	{
-#endif
-	cg.predictedPlayerState = cg.snap->ps;
-	cg.physicsTime          = cg.snap->serverTime;
-//	}
+	return resumeCmd + 1;
+}
 
-	if (pmove_msec.integer < 8)
-	{
-		trap_Cvar_Set("pmove_msec", "8");
-	}
-	else if (pmove_msec.integer > 33)
-	{
-		trap_Cvar_Set("pmove_msec", "33");
-	}
+/*
+=================
+CG_RunPredictionCommands
 
-	cg_pmove.pmove_fixed = pmove_fixed.integer;
-	cg_pmove.pmove_msec  = pmove_msec.integer;
+Runs the usercmds from firstCmd up to current on top of
+cg.predictedPlayerState. Prediction errors are only checked
+against oldPlayerState if it is given, and the resulting states
+are only stored for etj_optimizePrediction if backup is set.
+=================
+*/
+static qboolean CG_RunPredictionCommands(int firstCmd, int current, const usercmd_t *latestCmd, const playerState_t *oldPlayerState, pmoveExt_t *pmext, qboolean backup)
+{
+	int      cmdNum;
+	qboolean moved = qfalse;
+	vec3_t   deltaAngles;
 
-	// Zero: shared values between server & client
-	cg_pmove.shared = shared.integer;
+	cg_pmove.ps    = &cg.predictedPlayerState;
+	cg_pmove.pmext = pmext;
 
-	// run cmds
-	moved = qfalse;
-	for (cmdNum = current - CMD_BACKUP + 1 ; cmdNum <= current ; cmdNum++)
+	for (cmdNum = firstCmd ; cmdNum <= current ; cmdNum++)
 	{
 		// get the command
 		trap_GetUserCmd(cmdNum, &cg_pmove.cmd);
@@ -1162,12 +1485,20 @@ void CG_PredictPlayerState(void)
 		// don't do anything if the time is before the snapshot player time
 		if (cg_pmove.cmd.serverTime <= cg.predictedPlayerState.commandTime)
 		{
+			if (moved && backup)
+			{
+				CG_BackupPredictedState(cmdNum, pmext);
+			}
 			continue;
 		}
 
 		// don't do anything if the command was from a previous map_restart
-		if (cg_pmove.cmd.serverTime > latestCmd.serverTime)
+		if (cg_pmove.cmd.serverTime > latestCmd->serverTime)
 		{
+			if (moved && backup)
+			{
+				CG_BackupPredictedState(cmdNum, pmext);
+			}
 			continue;
 		}
 
@@ -1176,7 +1507,7 @@ void CG_PredictPlayerState(void)
 		// from the snapshot, but on a wan we will have
 		// to predict several commands to get to the point
 		// we want to compare
-		if (cg.predictedPlayerState.commandTime == oldPlayerState.commandTime)
+		if (oldPlayerState && cg.predictedPlayerState.commandTime == oldPlayerState->commandTime)
 		{
 			vec3_t delta;
 			float  len;
@@ -1209,12 +1540,12 @@ void CG_PredictPlayerState(void)
 
 				if (cg_showmiss.integer)
 				{
-					if (!VectorCompare(oldPlayerState.origin, adjusted))
+					if (!VectorCompare(oldPlayerState->origin, adjusted))
 					{
 						CG_Printf("prediction error\n");
 					}
 				}
-				VectorSubtract(oldPlayerState.origin, adjusted, delta);
+				VectorSubtract(oldPlayerState->origin, adjusted, delta);
 				len = VectorLength(delta);
 				if (len > 0.1)
 				{
@@ -1290,7 +1621,7 @@ void CG_PredictPlayerState(void)
 		// rain - copy the pmext as it was just before we
 		// previously ran this cmd (or, this will be the
 		// current predicted data if this is the current cmd)  (#166)
-		memcpy(&pmext, &oldpmext[cmdNum & CMD_MASK], sizeof(pmoveExt_t));
+		memcpy(pmext, &oldpmext[cmdNum & CMD_MASK], sizeof(pmoveExt_t));
 
 		fflush(stdout);
 
@@ -1300,6 +1631,263 @@ void CG_PredictPlayerState(void)
 
 		// add push trigger movement effects
 		CG_TouchTriggerPrediction();
+
+		if (backup)
+		{
+			CG_BackupPredictedState(cmdNum, pmext);
+		}
+	}
+
+	return moved;
+}
+
+/*
+=================
+CG_VerifyPrediction
+
+etj_optimizePrediction 2: replays all unacknowledged usercmds from the
+snapshot and checks that the optimized prediction came up with exactly
+the same playerState_t. On a mismatch the full replay result is used.
+=================
+*/
+static void CG_VerifyPrediction(int current, const usercmd_t *latestCmd, pmoveExt_t *pmext)
+{
+	const playerState_t optimized = cg.predictedPlayerState;
+	pmoveExt_t          optimizedPmext;
+
+	memcpy(&optimizedPmext, pmext, sizeof(pmoveExt_t));
+
+	cg.predictedPlayerState = cg.snap->ps;
+	CG_RunPredictionCommands(current - CMD_BACKUP + 1, current, latestCmd, NULL, pmext, qfalse);
+
+	if (memcmp(&optimized, &cg.predictedPlayerState, sizeof(playerState_t)) ||
+	    memcmp(&optimizedPmext, pmext, sizeof(pmoveExt_t)))
+	{
+		vec3_t delta;
+
+		VectorSubtract(optimized.origin, cg.predictedPlayerState.origin, delta);
+		CG_Printf("^3Optimized prediction mismatch at command %i, origin off by %f\n", current, VectorLength(delta));
+		cg.lastPredictedCommand = 0;
+	}
+}
+
+void CG_PredictPlayerState(void)
+{
+	int           cmdNum, current;
+	playerState_t oldPlayerState;
+	qboolean      moved;
+	usercmd_t     oldestCmd;
+	usercmd_t     latestCmd;
+	vec3_t        deltaAngles;
+	pmoveExt_t    pmext;
+//	int useCommand = 0;
+
+	cg.hyperspace = qfalse; // will be set if touching a trigger_teleport
+
+	// if this is the first frame we must guarantee
+	// predictedPlayerState is valid even if there is some
+	// other error condition
+	if (!cg.validPPS)
+	{
+		cg.validPPS             = qtrue;
+		cg.predictedPlayerState = cg.snap->ps;
+	}
+
+	// demo playback just copies the moves
+	if ((cg.demoPlayback) || (cg.snap->ps.pm_flags & PMF_FOLLOW))
+	{
+		CG_InterpolatePlayerState(qfalse);
+		return;
+	}
+
+	// non-predicting local movement will grab the latest angles
+	if (cg_nopredict.integer
+#ifdef ALLOW_GSYNC
+	    || cg_synchronousClients.integer
+#endif // ALLOW_GSYNC
+	    )
+	{
+		cg_pmove.ps    = &cg.predictedPlayerState;
+		cg_pmove.pmext = &cg.pmext;
+
+		cg.pmext.airleft = (cg.waterundertime - cg.time);
+
+		// Arnout: are we using an mg42?
+		if (cg_pmove.ps->eFlags & EF_MG42_ACTIVE || cg_pmove.ps->eFlags & EF_AAGUN_ACTIVE)
+		{
+			cg.pmext.harc = cg_entities[cg_pmove.ps->viewlocked_entNum].currentState.origin2[0];
+			cg.pmext.varc = cg_entities[cg_pmove.ps->viewlocked_entNum].currentState.origin2[1];
+
+			VectorCopy(cg_entities[cg_pmove.ps->viewlocked_entNum].currentState.angles2, cg.pmext.centerangles);
+
+			cg.pmext.centerangles[PITCH] = AngleNormalize180(cg.pmext.centerangles[PITCH]);
+			cg.pmext.centerangles[YAW]   = AngleNormalize180(cg.pmext.centerangles[YAW]);
+			cg.pmext.centerangles[ROLL]  = AngleNormalize180(cg.pmext.centerangles[ROLL]);
+		}
+
+		CG_InterpolatePlayerState(qtrue);
+		return;
+	}
+
+	if (cg_pmove.ps && cg_pmove.ps->eFlags & EF_MOUNTEDTANK)
+	{
+		centity_t *tank = &cg_entities[cg_entities[cg.snap->ps.clientNum].tagParent];
+
+		cg.pmext.centerangles[YAW]   = tank->lerpAngles[YAW];
+		cg.pmext.centerangles[PITCH] = tank->lerpAngles[PITCH];
+	}
+
+	// prepare for pmove
+	cg_pmove.ps        = &cg.predictedPlayerState;
+	cg_pmove.pmext     = &pmext; //&cg.pmext;
+	cg_pmove.character = CG_CharacterForClientinfo(&cgs.clientinfo[cg.snap->ps.clientNum], &cg_entities[cg.snap->ps.clientNum]);
+	cg.pmext.airleft   = (cg.waterundertime - cg.time);
+
+	// Arnout: are we using an mg42?
+	if (cg_pmove.ps->eFlags & EF_MG42_ACTIVE || cg_pmove.ps->eFlags & EF_AAGUN_ACTIVE)
+	{
+		cg.pmext.harc = cg_entities[cg_pmove.ps->viewlocked_entNum].currentState.origin2[0];
+		cg.pmext.varc = cg_entities[cg_pmove.ps->viewlocked_entNum].currentState.origin2[1];
+
+		VectorCopy(cg_entities[cg_pmove.ps->viewlocked_entNum].currentState.angles2, cg.pmext.centerangles);
+
+		cg.pmext.centerangles[PITCH] = AngleNormalize180(cg.pmext.centerangles[PITCH]);
+		cg.pmext.centerangles[YAW]   = AngleNormalize180(cg.pmext.centerangles[YAW]);
+		cg.pmext.centerangles[ROLL]  = AngleNormalize180(cg.pmext.centerangles[ROLL]);
+	}
+	else if (cg_pmove.ps->eFlags & EF_MOUNTEDTANK)
+	{
+		centity_t *tank = &cg_entities[cg_entities[cg.snap->ps.clientNum].tagParent];
+
+		cg.pmext.centerangles[PITCH] = tank->lerpAngles[PITCH];
+	}
+
+	cg_pmove.skill = cgs.clientinfo[cg.snap->ps.clientNum].skill;
+
+	if (cg_ghostPlayers.integer == 1)
+	{
+		cg_pmove.trace = CG_TraceCapsule_NoPlayers;
+	}
+	else
+	{
+		cg_pmove.trace = CG_TraceCapsule;
+	}
+	//cg_pmove.trace = CG_Trace;
+	cg_pmove.pointcontents = CG_PointContents;
+	if (cg_pmove.ps->pm_type == PM_DEAD)
+	{
+		cg_pmove.tracemask   = MASK_PLAYERSOLID & ~CONTENTS_BODY;
+		cg_pmove.ps->eFlags |= EF_DEAD; // DHM-Nerve added:: EF_DEAD is checked for in Pmove functions, but wasn't being set until after Pmove
+	}
+	else if (cg_pmove.ps->pm_type == PM_SPECTATOR)
+	{
+		// rain - fix the spectator can-move-partway-through-world weirdness
+		// bug by actually setting tracemask when spectating :x
+		cg_pmove.tracemask = MASK_PLAYERSOLID & ~CONTENTS_BODY;
+		cg_pmove.trace     = CG_TraceCapsule_World;
+	}
+	else
+	{
+		cg_pmove.tracemask = MASK_PLAYERSOLID;
+	}
+
+	if ((cg.snap->ps.persistant[PERS_TEAM] == TEAM_SPECTATOR) || (cg.snap->ps.pm_flags & PMF_LIMBO))     // JPW NERVE limbo
+	{
+		cg_pmove.tracemask &= ~CONTENTS_BODY;   // spectators can fly through bodies
+	}
+
+	cg_pmove.noFootsteps = qfalse;
+	cg_pmove.noWeapClips = qfalse;
+
+	// save the state before the pmove so we can detect transitions
+	oldPlayerState = cg.predictedPlayerState;
+
+	current = trap_GetCurrentCmdNumber();
+
+	// rain - fill in the current cmd with the latest prediction from
+	// cg.pmext (#166)
+
+	if (cg_noclipScale.value < 0.1)
+	{
+		cg.pmext.noclipScale = 0.1;
+	}
+	else if (cg_noclipScale.value > 20)
+	{
+		cg.pmext.noclipScale = 20;
+	}
+	else
+	{
+		cg.pmext.noclipScale = cg_noclipScale.value;
+	}
+
+	memcpy(&oldpmext[current & CMD_MASK], &cg.pmext, sizeof(pmoveExt_t));
+
+	// if we don't have the commands right after the snapshot, we
+	// can't accurately predict a current position, so just freeze at
+	// the last good position we had
+	cmdNum = current - CMD_BACKUP + 1;
+	trap_GetUserCmd(cmdNum, &oldestCmd);
+	if (oldestCmd.serverTime > cg.snap->ps.commandTime
+	    && oldestCmd.serverTime < cg.time)      // special check for map_restart
+	{
+		if (cg_showmiss.integer)
+		{
+			CG_Printf("exceeded PACKET_BACKUP on commands\n");
+		}
+	}
+
+	// get the latest command so we can know which commands are from previous map_restarts
+	trap_GetUserCmd(current, &latestCmd);
+
+	// get the most recent information we have, even if
+	// the server time is beyond our current cg.time,
+	// because predicted player positions are going to
+	// be ahead of everything else anyway
+	// rain - NEIN - this'll cause us to execute events from the next frame
+	// early, resulting in doubled events and the like.  it seems to be
+	// worse as far as prediction, too, so BLAH at id. (#405)
+#if 0
+	if (cg.nextSnap && !cg.nextFrameTeleport && !cg.thisFrameTeleport)
+	{
+		cg.predictedPlayerState = cg.nextSnap->ps;
+		cg.physicsTime          = cg.nextSnap->serverTime;
+	}
+	else
+	{
+#endif
+	cg.predictedPlayerState = cg.snap->ps;
+	cg.physicsTime          = cg.snap->serverTime;
+//	}
+
+	if (pmove_msec.integer < 8)
+	{
+		trap_Cvar_Set("pmove_msec", "8");
+	}
+	else if (pmove_msec.integer > 33)
+	{
+		trap_Cvar_Set("pmove_msec", "33");
+	}
+
+	cg_pmove.pmove_fixed = pmove_fixed.integer;
+	cg_pmove.pmove_msec  = pmove_msec.integer;
+
+	// Zero: shared values between server & client
+	cg_pmove.shared = shared.integer;
+
+	// ETJump: only simulate the new commands if the snapshot agrees with
+	// what we predicted earlier
+	cmdNum = CG_ResumePrediction(current, &pmext);
+	moved  = CG_RunPredictionCommands(cmdNum, current, &latestCmd, &oldPlayerState, &pmext, qtrue);
+
+	// resuming counts as moving, the saved state still needs to be adjusted
+	if (cmdNum != current - CMD_BACKUP + 1)
+	{
+		moved = qtrue;
+	}
+
+	if (etj_optimizePrediction.integer > 1 && moved)
+	{
+		CG_VerifyPrediction(current, &latestCmd, &pmext);
 	}
 
 	if (cg_showmiss.integer > 1)
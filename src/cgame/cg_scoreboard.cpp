@@ -193,7 +193,7 @@ void CG_DrawHeader2(float x, float y, float fade)
 	textColor[3] = fade;
 
 	// Draw the server hostname
-	std::string ipAddress = ETJump::stringFormat("^7%s", cg.ipAddr[0] ? cg.ipAddr : "localhost");
+	std::string ipAddress = ETJUMP_FORMAT("^7%s", cg.ipAddr[0] ? cg.ipAddr : "localhost");
 	header = va(CG_TranslateString(va("^7%s", Info_ValueForKey(configString, "sv_hostname"))));
 	CG_Text_Paint_Ext(tempX, tempY, 0.25f, 0.25f, textColor, header, 0, 0, 0, font);
 	CG_Text_Paint_Ext(tempX + 1, tempY + 10, 0.15f, 0.15f, textColor, ipAddress, 0, 0, 0, font);
@@ -464,8 +464,8 @@ void CG_DrawHeader3(float x, float y, float fade, vec4_t textColor, fontInfo_t *
 	float headerTextY = y + ALT_SCOREBOARD_3_HEADER_HEIGHT / 2;
 
 	// Draw server name & IP address (left side)
-	std::string hostName = ETJump::stringFormat("^7%s", Info_ValueForKey(configString, "sv_hostname"));
-	std::string ipAddress = ETJump::stringFormat("^7%s", cg.ipAddr[0] ? cg.ipAddr : "localhost");
+	std::string hostName = ETJUMP_FORMAT("^7%s", Info_ValueForKey(configString, "sv_hostname"));
+	std::string ipAddress = ETJUMP_FORMAT("^7%s", cg.ipAddr[0] ? cg.ipAddr : "localhost");
 	float leftTextX = headerTextX;
 	float leftTextY = headerTextY;
 
@@ -474,8 +474,8 @@ void CG_DrawHeader3(float x, float y, float fade, vec4_t textColor, fontInfo_t *
 
 	// Map name and mod version (right side)
 
-	std::string mapName = ETJump::stringFormat("^7%s", cgs.rawmapname);
-	std::string modVersion = ETJump::stringFormat("^7%s", GAME_TAG);
+	std::string mapName = ETJUMP_FORMAT("^7%s", cgs.rawmapname);
+	std::string modVersion = ETJUMP_FORMAT("^7%s", GAME_TAG);
 	float rightTextX = SCREEN_WIDTH - leftTextX;
 	float rightTextY = headerTextY;
 	float mapNameOffsetX = CG_Text_Width_Ext(mapName, 0.15f, 0, font);
@@ -524,7 +524,7 @@ void CG_DrawScoreboardRows3(float x, float y, int j, score_t *score, float fade)
 
 void CG_DrawPlayerHeader3(float x, float y, int playerCount, float fade, vec4_t textColor, fontInfo_t *font)
 {
-	std::string playerHeader = ETJump::stringFormat("^7Players (%d)", playerCount);
+	std::string playerHeader = ETJUMP_FORMAT("^7Players (%d)", playerCount);
 
 	CG_Text_Paint_Centred_Ext(x, y + 9, 0.15f, 0.15f, textColor, playerHeader, 0, 0, ITEM_TEXTSTYLE_SHADOWED, font);
 }
@@ -537,7 +537,7 @@ void CG_AddPlayerToList3(float x, float y, float fpsCenterX, float infoX, float
 	CG_Text_Paint_Ext(x, y, 0.12f, 0.12f, textColor, ci->name, 0, 0, ITEM_TEXTSTYLE_SHADOWED, font);
 
 	// Draw FPS
-	std::string maxFPS = ETJump::stringFormat("%i", ci->maxFPS);
+	std::string maxFPS = ETJUMP_FORMAT("%i", ci->maxFPS);
 	CG_Text_Paint_Centred_Ext(fpsCenterX, y, 0.12f, 0.12f, textColor, maxFPS, 0, 0, ITEM_TEXTSTYLE_SHADOWED, font);
 
 	// Draw client info
@@ -558,7 +558,7 @@ void CG_AddPlayerToList3(float x, float y, float fpsCenterX, float infoX, float
 	CG_Text_Paint_Centred_Ext(infoX + 47, y, 0.12f, 0.12f, textColor, clientInfoTeam, 0, 0, ITEM_TEXTSTYLE_SHADOWED, font);
 
 	// Draw client ping
-	std::string ping = ETJump::stringFormat("%i", score->ping);
+	std::string ping = ETJUMP_FORMAT("%i", score->ping);
 	CG_Text_Paint_Centred_Ext(pingCenterX, y, 0.12f, 0.12f, textColor, ping, 0, 0, ITEM_TEXTSTYLE_SHADOWED, font);
 }
 
@@ -614,7 +614,7 @@ void CG_DrawPlayerList3(float x, float y, float fade, vec4_t textColor, fontInfo
 
 void CG_DrawSpectatorHeader3(float x, float y, int spectatorCount, float fade, vec4_t textColor, fontInfo_t *font)
 {
-	std::string playerHeader = ETJump::stringFormat("^7Spectators (%d)", spectatorCount);
+	std::string playerHeader = ETJUMP_FORMAT("^7Spectators (%d)", spectatorCount);
 
 	CG_Text_Paint_Centred_Ext(x, y + 9, 0.15f, 0.15f, textColor, playerHeader, 0, 0, ITEM_TEXTSTYLE_SHADOWED, font);
 }
@@ -626,7 +626,7 @@ void CG_AddSpectatorToList3(float x, float y, float pingCenterX, score_t *score,
 	std::string spectator = "^3SPECTATOR";
 	std::string following = "^3>";
 	std::string followedClient = cgs.clientinfo[score->followedClient].name;
-	std::string ping = ETJump::stringFormat("%i", score->ping);
+	std::string ping = ETJUMP_FORMAT("%i", score->ping);
 	float playerX = ALT_SCOREBOARD_3_PLAYER_X;
 	float rightTextX = SCREEN_WIDTH - playerX;
 	float connectingTextOffsetX = CG_Text_Width_Ext(connecting, 0.12f, 0, font);
@@ -2473,13 +2473,71 @@ void CG_FixLinesEndingWithCaret(char *text, int size)
 	text[size - 1] = 0;
 }
 
-static void CG_ServerCommand(void)
+static void CG_ChatServerCommand(qboolean enc)
 {
-	const char *cmd;
-	char       text[MAX_SAY_TEXT];
-	qboolean   enc = qfalse; // used for enc_chat, enc_tchat
+	char text[MAX_SAY_TEXT];
+	const char *s;
+
+	if (cg_teamChatsOnly.integer)
+	{
+		return;
+	}
 
-	cmd = CG_Argv(0);
+	if (atoi(CG_Argv(3)))
+	{
+		s = CG_LocalizeServerCommand(CG_Argv(1));
+	}
+	else
+	{
+		s = CG_Argv(1);
+	}
+
+	Q_strncpyz(text, s, MAX_SAY_TEXT);
+
+	if (enc)
+	{
+		CG_DecodeQP(text);
+	}
+
+	CG_RemoveChatEscapeChar(text);
+	CG_FixLinesEndingWithCaret(text, MAX_SAY_TEXT);
+	s = CG_AddChatModifications(text, atoi(CG_Argv(2)));
+	CG_AddToTeamChat(s, atoi(CG_Argv(2)));
+	CG_Printf("%s\n", s);
+}
+
+static void CG_TeamChatServerCommand(qboolean enc)
+{
+	char text[MAX_SAY_TEXT];
+	const char *s;
+
+	if (atoi(CG_Argv(3)))
+	{
+		s = CG_LocalizeServerCommand(CG_Argv(1));
+	}
+	else
+	{
+		s = CG_Argv(1);
+	}
+
+	Q_strncpyz(text, s, MAX_SAY_TEXT);
+	if (enc)
+	{
+		CG_DecodeQP(text);
+	}
+	CG_RemoveChatEscapeChar(text);
+
+	s = CG_AddChatModifications(text, atoi(CG_Argv(2)));
+	Q_strncpyz(text, s, MAX_SAY_TEXT);
+
+	CG_FixLinesEndingWithCaret(text, MAX_SAY_TEXT);
+	CG_AddToTeamChat(text, atoi(CG_Argv(2)));
+	CG_Printf("%s\n", text);   // JPW NERVE
+}
+
+static void CG_ServerCommand(void)
+{
+	const char *cmd = CG_Argv(0);
 
 	if (!cmd[0])
 	{
@@ -2487,23 +2545,83 @@ static void CG_ServerCommand(void)
 		return;
 	}
 
-	if (!strcmp(cmd, "tinfo"))
+	auto found = ETJump::serverCommandsHandler->check(cmd, []
 	{
-		CG_ParseTeamInfo();
-		return;
+		std::vector<std::string> arguments;
+		for (auto i = 1, argc = trap_Argc(); i < argc; ++i)
+		{
+			// Zero: CG_Argv cannot be used here as it uses a single static
+			// buffer and cmd would be replaced with whatever was the last argument
+			char buf[MAX_TOKEN_CHARS]{};
+			trap_Argv(i, buf, sizeof(buf));
+			arguments.push_back(buf);
+		}
+		return arguments;
+	});
+
+	if (!found)
+	{
+		CG_Printf("Unknown client game command: %s\n", cmd);
 	}
-	if (!strcmp(cmd, "sc0"))
+}
+
+/*
+=================
+CG_ServerCommandStats_f
+
+Prints how often each server command has been received and
+how long handling them took
+=================
+*/
+static void CG_ServerCommandStats_f(const std::vector<std::string>& args)
+{
+	if (!args.empty() && !Q_stricmp(args[0].c_str(), "reset"))
 	{
-		CG_ParseScore(TEAM_AXIS);
+		ETJump::serverCommandsHandler->resetStats();
+		CG_Printf("Server command statistics reset.\n");
 		return;
 	}
-	else if (!strcmp(cmd, "sc1"))
+
+	CG_Printf("%-24s %8s %10s %8s %8s\n", "command", "calls", "total ms", "avg us", "max us");
+	for (const auto& stats : ETJump::serverCommandsHandler->stats())
 	{
-		CG_ParseScore(TEAM_ALLIES);
-		return;
+		if (!stats.calls)
+		{
+			continue;
+		}
+
+		CG_Printf("%-24s %8u %10.2f %8lld %8lld\n", stats.command.c_str(), stats.calls,
+		          stats.totalMicroseconds / 1000.0, static_cast<long long>(stats.totalMicroseconds / stats.calls),
+		          static_cast<long long>(stats.maxMicroseconds));
 	}
+}
+
+/*
+=================
+CG_RegisterServerCommands
+
+Registers every server command cgame handles, a received command
+is dispatched with a single hashed lookup
+=================
+*/
+void CG_RegisterServerCommands(void)
+{
+	auto& commands = *ETJump::serverCommandsHandler;
+
+	commands.subscribeRaw("tinfo", []
+	{
+		CG_ParseTeamInfo();
+	});
+	commands.subscribeRaw("sc0", []
+	{
+		CG_ParseScore(TEAM_AXIS);
+	});
+	commands.subscribeRaw("sc1", []
+	{
+		CG_ParseScore(TEAM_ALLIES);
+	});
 
-	if (!strcmp(cmd, "WeaponStats"))
+	commands.subscribeRaw("WeaponStats", []
 	{
 		int i, start = 1;
 
@@ -2534,39 +2652,33 @@ static void CG_ServerCommand(void)
 			cgs.playerStats.objectiveStats[i] = atoi(CG_Argv(start++));
 			cgs.teamobjectiveStats[i]         = atoi(CG_Argv(start++));
 		}
+	});
 
-		return;
-	}
-
-	if (!Q_stricmp(cmd, "hasTimerun"))
+	commands.subscribeRaw("hasTimerun", []
 	{
 		cg.hasTimerun = atoi(CG_Argv(1)) ? qtrue : qfalse;
-		return;
-	}
+	});
 
-	if (!Q_stricmp(cmd, "cheatCvarsOff"))
+	commands.subscribeRaw("cheatCvarsOff", []
 	{
 		trap_SendConsoleCommand("set cl_freelook 1\n");
 		trap_SendConsoleCommand("set cl_yawspeed 0\n");
 		trap_SendConsoleCommand("set pmove_fixed 1\n");
 		trap_SendConsoleCommand("set m_pitch 0.022\n");
-		return;
-	}
+	});
 
-	if (!Q_stricmp(cmd, "cpm"))
+	commands.subscribeRaw("cpm", []
 	{
 		CG_AddPMItem(PM_MESSAGE, CG_LocalizeServerCommand(CG_Argv(1)), cgs.media.voiceChatShader);
-		return;
-	}
+	});
 
 	// Banner Printing
-	if (!Q_stricmp(cmd, "bp"))
+	commands.subscribeRaw("bp", []
 	{
 		CG_BannerPrint(CG_LocalizeServerCommand(CG_Argv(1)));
-		return;
-	}
+	});
 
-	if (!Q_stricmp(cmd, "cp"))
+	commands.subscribeRaw("cp", []
 	{
 		// NERVE - SMF
 		int  args = trap_Argc();
@@ -2592,28 +2704,24 @@ static void CG_ServerCommand(void)
 		{
 			CG_CenterPrint(CG_LocalizeServerCommand(CG_Argv(1)), SCREEN_HEIGHT - (SCREEN_HEIGHT * 0.20), SMALLCHAR_WIDTH);      //----(SA)	modified
 		}
-		return;
-	}
+	});
 
-	if (!Q_stricmp(cmd, "sdbg"))
+	commands.subscribeRaw("sdbg", []
 	{
 		CG_StatsDebugAddText(CG_Argv(1));
-		return;
-	}
+	});
 
-	if (!Q_stricmp(cmd, "cs"))
+	commands.subscribeRaw("cs", []
 	{
 		CG_ConfigStringModified();
-		return;
-	}
+	});
 
-	if (!Q_stricmp(cmd, "print"))
+	commands.subscribeRaw("print", []
 	{
 		CG_Printf("[cgnotify]%s", CG_LocalizeServerCommand(CG_Argv(1)));
-		return;
-	}
+	});
 
-	if (!Q_stricmp(cmd, "entnfo"))
+	commands.subscribeRaw("entnfo", []
 	{
 		char buffer[16];
 		int  allied_number, axis_number;
@@ -2625,104 +2733,54 @@ static void CG_ServerCommand(void)
 		allied_number = atoi(buffer);
 
 		CG_ParseMapEntityInfo(axis_number, allied_number);
+	});
 
-		return;
-	}
-
-	enc = !Q_stricmp(cmd, "enc_chat") ? qtrue : qfalse;
-	if (!Q_stricmp(cmd, "chat") || enc)
+	commands.subscribeRaw("chat", []
 	{
-		const char *s;
-
-		if (cg_teamChatsOnly.integer)
-		{
-			return;
-		}
-
-		if (atoi(CG_Argv(3)))
-		{
-			s = CG_LocalizeServerCommand(CG_Argv(1));
-		}
-		else
-		{
-			s = CG_Argv(1);
-		}
-
-		Q_strncpyz(text, s, MAX_SAY_TEXT);
-
-		if (enc)
-		{
-			CG_DecodeQP(text);
-		}
-
-		CG_RemoveChatEscapeChar(text);
-		CG_FixLinesEndingWithCaret(text, MAX_SAY_TEXT);
-		s = CG_AddChatModifications(text, atoi(CG_Argv(2)));
-		CG_AddToTeamChat(s, atoi(CG_Argv(2)));
-		CG_Printf("%s\n", s);
-
-		return;
-	}
-
-	enc = !Q_stricmp(cmd, "enc_tchat") ? qtrue : qfalse;
-	if (!Q_stricmp(cmd, "tchat") || enc)
+		CG_ChatServerCommand(qfalse);
+	});
+	commands.subscribeRaw("enc_chat", []
 	{
+		CG_ChatServerCommand(qtrue);
+	});
 
-		const char *s;
-
-		if (atoi(CG_Argv(3)))
-		{
-			s = CG_LocalizeServerCommand(CG_Argv(1));
-		}
-		else
-		{
-			s = CG_Argv(1);
-		}
-
-		Q_strncpyz(text, s, MAX_SAY_TEXT);
-		if (enc)
-		{
-			CG_DecodeQP(text);
-		}
-		CG_RemoveChatEscapeChar(text);
-
-		s = CG_AddChatModifications(text, atoi(CG_Argv(2)));
-		Q_strncpyz(text, s, MAX_SAY_TEXT);
-
-		CG_FixLinesEndingWithCaret(text, MAX_SAY_TEXT);
-		CG_AddToTeamChat(text, atoi(CG_Argv(2)));
-		CG_Printf("%s\n", text);   // JPW NERVE
-
-		return;
-	}
+	commands.subscribeRaw("tchat", []
+	{
+		CG_TeamChatServerCommand(qfalse);
+	});
+	commands.subscribeRaw("enc_tchat", []
+	{
+		CG_TeamChatServerCommand(qtrue);
+	});
 
-	if (!Q_stricmp(cmd, "vchat"))
+	commands.subscribeRaw("vchat", []
 	{
 		CG_VoiceChat(SAY_ALL);              // NERVE - SMF - enabled support
-		return;
-	}
+	});
 
-	if (!Q_stricmp(cmd, "vtchat"))
+	commands.subscribeRaw("vtchat", []
 	{
 		CG_VoiceChat(SAY_TEAM);             // NERVE - SMF - enabled support
-		return;
-	}
+	});
 
-	if (!Q_stricmp(cmd, "vbchat"))
+	commands.subscribeRaw("vbchat", []
 	{
 		CG_VoiceChat(SAY_BUDDY);
-		return;
-	}
+	});
 
-	if (!Q_stricmp(cmd, "voted"))
+	commands.subscribeRaw("voted", []
 	{
 		cgs.votedYes = !Q_strncmp(CG_Argv(1), "y", 1) ? true : false;
-		return;
-	}
+	});
 
 	// DHM - Nerve :: Allow client to lodge a complaing
-	if (!Q_stricmp(cmd, "complaint") && cgs.gamestate == GS_PLAYING)
+	commands.subscribeRaw("complaint", []
 	{
+		if (cgs.gamestate != GS_PLAYING)
+		{
+			return;
+		}
+
 		cgs.complaintEndTime = cg.time + 20000;
 		cgs.complaintClient  = atoi(CG_Argv(1));
 
@@ -2730,26 +2788,22 @@ static void CG_ServerCommand(void)
 		{
 			cgs.complaintEndTime = cg.time + 10000;
 		}
-
-		return;
-	}
+	});
 	// dhm
 
-	if (!Q_stricmp(cmd, "map_restart"))
+	commands.subscribeRaw("map_restart", []
 	{
 		CG_MapRestart();
-		return;
-	}
+	});
 
 	// OSP - match stats
-	if (!Q_stricmp(cmd, "sc"))
+	commands.subscribeRaw("sc", []
 	{
 		CG_scores_cmd();
-		return;
-	}
+	});
 
 	// OSP - weapon stats parsing
-	if (!Q_stricmp(cmd, "ws"))
+	commands.subscribeRaw("ws", []
 	{
 		if (cgs.dumpStatsTime > cg.time)
 		{
@@ -2760,99 +2814,82 @@ static void CG_ServerCommand(void)
 			CG_parseWeaponStats_cmd(CG_printConsoleString);
 			cgs.dumpStatsTime = 0;
 		}
-
-		return;
-	}
-	if (!Q_stricmp(cmd, "wws"))
+	});
+	commands.subscribeRaw("wws", []
 	{
 		CG_wstatsParse_cmd();
-		return;
-	}
-	if (!Q_stricmp(cmd, "gstats"))
+	});
+	commands.subscribeRaw("gstats", []
 	{
 		CG_parseWeaponStatsGS_cmd();
-		return;
-	}
+	});
 
 	// OSP - "topshots"-related commands
-	if (!Q_stricmp(cmd, "astats"))
+	commands.subscribeRaw("astats", []
 	{
 		CG_parseTopShotsStats_cmd(qtrue, CG_printConsoleString);
-		return;
-	}
-	if (!Q_stricmp(cmd, "astatsb"))
+	});
+	commands.subscribeRaw("astatsb", []
 	{
 		CG_parseTopShotsStats_cmd(qfalse, CG_printConsoleString);
-		return;
-	}
-	if (!Q_stricmp(cmd, "bstats"))
+	});
+	commands.subscribeRaw("bstats", []
 	{
 		CG_parseBestShotsStats_cmd(qtrue, CG_printConsoleString);
-		return;
-	}
-	if (!Q_stricmp(cmd, "bstatsb"))
+	});
+	commands.subscribeRaw("bstatsb", []
 	{
 		CG_parseBestShotsStats_cmd(qfalse, CG_printConsoleString);
-		return;
-	}
+	});
 //	if(!strcmp(cmd, "wastats")) {
 //		CG_wtopshotsParse_cmd(qfalse);
 //		return;
 //	}
-	if (!Q_stricmp(cmd, "wbstats"))
+	commands.subscribeRaw("wbstats", []
 	{
 		CG_topshotsParse_cmd(qtrue);
-		return;
-	}
+	});
 
 	// Gordon: single weapon stat (requested weapon stats)
-	if (!Q_stricmp(cmd, "rws"))
+	commands.subscribeRaw("rws", []
 	{
 		CG_ParseWeaponStats();
-		return;
-	}
-	if (!Q_stricmp(cmd, "portalcampos"))
+	});
+	commands.subscribeRaw("portalcampos", []
 	{
 		CG_ParsePortalPos();
-		return;
-	}
+	});
 
-	if (!Q_stricmp(cmd, "startCam"))
+	commands.subscribeRaw("startCam", []
 	{
 		CG_StartCamera(CG_Argv(1), atoi(CG_Argv(2)) ? qtrue : qfalse);
-		return;
-	}
+	});
 
-	if (!Q_stricmp(cmd, "SetInitialCamera"))
+	commands.subscribeRaw("SetInitialCamera", []
 	{
 		CG_SetInitialCamera(CG_Argv(1), atoi(CG_Argv(2)) ? qtrue : qfalse);
-		return;
-	}
+	});
 
-	if (!Q_stricmp(cmd, "stopCam"))
+	commands.subscribeRaw("stopCam", []
 	{
 		CG_StopCamera();
-		return;
-	}
+	});
 
-	if (!Q_stricmp(cmd, "setspawnpt"))
+	commands.subscribeRaw("setspawnpt", []
 	{
 		cg.selectedSpawnPoint = atoi(CG_Argv(1)) + 1;
-		return;
-	}
+	});
 
-	if (!strcmp(cmd, "rockandroll"))        // map loaded, game is ready to begin.
-	{   // Arnout: FIXME: re-enable when we get menus that deal with fade properly
+	commands.subscribeRaw("rockandroll", [] // map loaded, game is ready to begin.
+	{ // Arnout: FIXME: re-enable when we get menus that deal with fade properly
 //		CG_Fade(0, 0, 0, 255, cg.time, 0);		// go black
 		//trap_UI_Popup("pregame");				// start pregame menu
 		//trap_Cvar_Set("cg_norender", "1");	// don't render the world until the player clicks in and the 'playerstart' func has been called (g_main in G_UpdateCvars() ~ilne 949)
 
 		trap_S_FadeAllSound(1.0f, 1000, qfalse);    // fade sound up
+	});
 
-		return;
-	}
-
-	if (!Q_stricmp(cmd, "application"))
+	commands.subscribeRaw("application", []
 	{
 		cgs.applicationEndTime = cg.time + 20000;
 		cgs.applicationClient  = atoi(CG_Argv(1));
@@ -2861,11 +2898,9 @@ static void CG_ServerCommand(void)
 		{
 			cgs.applicationEndTime = cg.time + 10000;
 		}
+	});
 
-		return;
-	}
-
-	if (!Q_stricmp(cmd, "invitation"))
+	commands.subscribeRaw("invitation", []
 	{
 		cgs.invitationEndTime = cg.time + 20000;
 		cgs.invitationClient  = atoi(CG_Argv(1));
@@ -2874,11 +2909,9 @@ static void CG_ServerCommand(void)
 		{
 			cgs.invitationEndTime = cg.time + 10000;
 		}
+	});
 
-		return;
-	}
-
-	if (!Q_stricmp(cmd, "proposition"))
+	commands.subscribeRaw("proposition", []
 	{
 		cgs.propositionEndTime = cg.time + 20000;
 		cgs.propositionClient  = atoi(CG_Argv(1));
@@ -2888,11 +2921,9 @@ static void CG_ServerCommand(void)
 		{
 			cgs.propositionEndTime = cg.time + 10000;
 		}
+	});
 
-		return;
-	}
-
-	if (!Q_stricmp(cmd, "aft"))
+	commands.subscribeRaw("aft", []
 	{
 		cgs.autoFireteamEndTime = cg.time + 20000;
 		cgs.autoFireteamNum     = atoi(CG_Argv(1));
@@ -2901,10 +2932,9 @@ static void CG_ServerCommand(void)
 		{
 			cgs.autoFireteamEndTime = cg.time + 10000;
 		}
-		return;
-	}
+	});
 
-	if (!Q_stricmp(cmd, "aftc"))
+	commands.subscribeRaw("aftc", []
 	{
 		cgs.autoFireteamCreateEndTime = cg.time;
 		cgs.autoFireteamCreateNum     = atoi(CG_Argv(1));
@@ -2913,10 +2943,9 @@ static void CG_ServerCommand(void)
 		{
 			cgs.autoFireteamCreateEndTime = cg.time + 10000;
 		}
-		return;
-	}
+	});
 
-	if (!Q_stricmp(cmd, "aftj"))
+	commands.subscribeRaw("aftj", []
 	{
 		cgs.autoFireteamJoinEndTime = cg.time + 20000;
 		cgs.autoFireteamJoinNum     = atoi(CG_Argv(1));
@@ -2925,16 +2954,15 @@ static void CG_ServerCommand(void)
 		{
 			cgs.autoFireteamJoinEndTime = cg.time + 10000;
 		}
-		return;
-	}
+	});
 
-	if (Q_stricmp(cmd, "remapShader") == 0)
+	commands.subscribeRaw("remapShader", []
 	{
 		if (trap_Argc() == 4)
 		{
 			trap_R_RemapShader(CG_Argv(1), CG_Argv(2), CG_Argv(3));
 		}
-	}
+	});
 
 //GS Copied in code from old source for mu_start, mu_play & mu_stop
 	//
@@ -2942,8 +2970,9 @@ static void CG_ServerCommand(void)
 	//
 
 	// loops \/
-	if (!Q_stricmp(cmd, "mu_start"))        // has optional parameter for fade-up time
+	commands.subscribeRaw("mu_start", [] // has optional parameter for fade-up time
 	{
+		char text[MAX_SAY_TEXT];
 		int fadeTime = 0;   // default to instant start
 
 		Q_strncpyz(text, CG_Argv(2), MAX_SAY_TEXT);
@@ -2953,11 +2982,11 @@ static void CG_ServerCommand(void)
 		}
 
 		trap_S_StartBackgroundTrack(CG_Argv(1), CG_Argv(1), fadeTime);
-		return;
-	}
+	});
 	// plays once then back to whatever the loop was \/
-	if (!Q_stricmp(cmd, "mu_play"))         // has optional parameter for fade-up time
+	commands.subscribeRaw("mu_play", [] // has optional parameter for fade-up time
 	{
+		char text[MAX_SAY_TEXT];
 		int fadeTime = 0;   // default to instant start
 
 		Q_strncpyz(text, CG_Argv(2), MAX_SAY_TEXT);
@@ -2967,11 +2996,11 @@ static void CG_ServerCommand(void)
 		}
 
 		trap_S_StartBackgroundTrack(CG_Argv(1), "onetimeonly", fadeTime);
-		return;
-	}
+	});
 
-	if (!Q_stricmp(cmd, "mu_stop"))         // has optional parameter for fade-down time
+	commands.subscribeRaw("mu_stop", [] // has optional parameter for fade-down time
 	{
+		char text[MAX_SAY_TEXT];
 		int fadeTime = 0;   // default to instant stop
 
 		Q_strncpyz(text, CG_Argv(1), MAX_SAY_TEXT);
@@ -2982,37 +3011,31 @@ static void CG_ServerCommand(void)
 
 		trap_S_FadeBackgroundTrack(0.0f, fadeTime, 0);
 		trap_S_StartBackgroundTrack("", "", -2);    // '-2' for 'queue looping track' (QUEUED_PLAY_LOOPED)
-		return;
-	}
-	if (!Q_stricmp(cmd, "mu_fade"))
+	});
+	commands.subscribeRaw("mu_fade", []
 	{
 		trap_S_FadeBackgroundTrack(atof(CG_Argv(1)), atoi(CG_Argv(2)), 0);
-		return;
-	}
+	});
 
-	if (!Q_stricmp(cmd, "snd_fade"))
+	commands.subscribeRaw("snd_fade", []
 	{
 		trap_S_FadeAllSound(atof(CG_Argv(1)), atoi(CG_Argv(2)), atoi(CG_Argv(3)) ? qtrue : qfalse);
-		return;
-	}
+	});
 
-	if (!Q_stricmp(cmd, "ftCommands"))
+	commands.subscribeRaw("ftCommands", []
 	{
 		char info[MAX_INFO_STRING];
 		trap_Argv(1, info, sizeof(info));
 
 		cg.botMenuIcons = atoi(info);
+	});
 
-		return;
-	}
-
-	if (!Q_stricmp(cmd, "manual"))
+	commands.subscribeRaw("manual", []
 	{
 		CG_Manual_f();
-		return;
-	}
+	});
 
-	if (!Q_stricmp(cmd, "set_name"))
+	commands.subscribeRaw("set_name", []
 	{
 		int         argc, totlen, i, len;
 		static char line[MAX_STRING_CHARS];
@@ -3046,11 +3069,10 @@ static void CG_ServerCommand(void)
 
 
 		trap_Cvar_Set("name", line);
-		return;
-	}
+	});
 
 	// ensure a file gets into a build (mainly for scripted music calls)
-	if (!Q_stricmp(cmd, "addToBuild"))
+	commands.subscribeRaw("addToBuild", []
 	{
 		fileHandle_t f;
 
@@ -3063,11 +3085,10 @@ static void CG_ServerCommand(void)
 		//CG_FileTouchForBuild(CG_Argv(1));
 		trap_FS_FOpenFile(CG_Argv(1), &f, FS_READ);
 		trap_FS_FCloseFile(f);
-		return;
-	}
+	});
 
 	// ydnar: bug 267: server sends this command when it's about to kill the current server, before the client can reconnect
-	if (!Q_stricmp(cmd, "spawnserver"))
+	commands.subscribeRaw("spawnserver", []
 	{
 		// print message informing player the server is restarting with a new map
 		CG_PriorityCenterPrint(va("%s", CG_TranslateString("^3Server Restarting")), SCREEN_HEIGHT - (SCREEN_HEIGHT * 0.25), SMALLCHAR_WIDTH, 999999);
@@ -3077,31 +3098,11 @@ static void CG_ServerCommand(void)
 
 		// fade out over the course of 5 seconds, should be enough (nuking: atvi bug 3793)
 		//%	CG_Fade( 0, 0, 0, 255, cg.time, 5000 );
+	});
 
-		return;
-	}
-
-	std::vector<std::string> arguments;
-	for (auto i = 1, argc = trap_Argc(); i < argc; ++i)
-	{
-		// Zero: CG_Argv cannot be used here as it uses a single static
-		// buffer and breaks the CG_ServerCommandExt as cmd will be replaced
-		// with whatever was the last argument
-		char buf[MAX_TOKEN_CHARS]{};
-		trap_Argv(i, buf, sizeof(buf));
-		arguments.push_back(buf);
-	}
-
-	bool found = ETJump::serverCommandsHandler->check(cmd, arguments);
-
-	if (CG_ServerCommandExt(cmd))
-	{
-		return;
-	}
-
-	if (found) return;
+	CG_RegisterServerCommandsExt();
 
-	CG_Printf("Unknown client game command: %s\n", cmd);
+	ETJump::consoleCommandsHandler->subscribe("serverCommandStats", CG_ServerCommandStats_f);
 }
 
 
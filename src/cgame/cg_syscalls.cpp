@@ -67,6 +67,7 @@ void    trap_Cvar_Update(vmCvar_t *vmCvar)
 void    trap_Cvar_Set(const char *var_name, const char *value)
 {
 	syscall(CG_CVAR_SET, var_name, value);
+	CG_CvarSet(var_name);
 }
 
 void trap_Cvar_VariableStringBuffer(const char *var_name, char *buffer, int bufsize)
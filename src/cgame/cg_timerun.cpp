@@ -140,11 +140,11 @@ std::string Timerun::createCompletionMessage(clientInfo_t& player, std::string&
 	{
 		Time diff = createTimeFromTimestamp(abs(previousTime - completionTime));
 		std::string timeDir = (previousTime > completionTime) ?  "-^2" : "+^1";
-		timeDifference = ETJump::stringFormat("^7(%s%s^7)", timeDir, createTimeString(diff));
+		timeDifference = ETJUMP_FORMAT("^7(%s%s^7)", timeDir, createTimeString(diff));
 		postfix = (previousTime > completionTime) ? '!' : '.';
 	}
 
-	std::string message = ETJump::stringFormat(
+	std::string message = ETJUMP_FORMAT(
 		"^7%s ^7completed %s ^7in %s%c %s", who, runName, timeFinished, postfix, timeDifference
 	);
 
@@ -153,7 +153,7 @@ std::string Timerun::createCompletionMessage(clientInfo_t& player, std::string&
 
 std::string Timerun::createTimeString(Time &time)
 {
-	return ETJump::stringFormat("%02d:%02d.%03d", time.minutes, time.seconds, time.ms);
+	return ETJUMP_FORMAT("%02d:%02d.%03d", time.minutes, time.seconds, time.ms);
 }
 
 void Timerun::printMessage(std::string &message, int shaderIcon)
@@ -1,6 +1,7 @@
 // cg_view.c -- setup all the parameters (position, angle, etc)
 // for a 3D rendering
 #include "cg_local.h"
+#include "etj_movement_context.h"
 
 //========================
 extern pmove_t cg_pmove;
@@ -2202,6 +2203,9 @@ void CG_DrawActiveFrame(int serverTime, stereoFrame_t stereoView, qboolean demoP
 	// update cg.predictedPlayerState
 	CG_PredictPlayerState();
 
+	// speed, traces etc. the HUD shares this frame
+	ETJump::movementContext.update();
+
 	DEBUGTIME
 
 
@@ -22,6 +22,9 @@
  * SOFTWARE.
  */
 
+#include <limits>
+#include <stdexcept>
+
 #include "cg_local.h"
 
 #include "etj_awaited_command_handler.h"
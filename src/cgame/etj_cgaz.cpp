@@ -1,5 +1,6 @@
 #include "etj_cgaz.h"
 #include "etj_utilities.h"
+#include "etj_movement_context.h"
 #include "../game/etj_numeric_utilities.h"
 
 namespace ETJump
@@ -53,27 +54,6 @@ namespace ETJump
 		return d_max;
 	}
 
-	static usercmd_t getUsercmd(playerState_t const& pm_ps, int8_t ucmdScale)
-	{
-		usercmd_t cmd;
-		if (!cg.demoPlayback && !(pm_ps.pm_flags & PMF_FOLLOW))
-		{
-			int cmdNum = trap_GetCurrentCmdNumber();
-			trap_GetUserCmd(cmdNum, &cmd);
-		}
-		else
-		{
-			cmd.forwardmove = ucmdScale * (!!(pm_ps.stats[STAT_USERCMD_MOVE] & UMOVE_FORWARD) -
-				!!(pm_ps.stats[STAT_USERCMD_MOVE] & UMOVE_BACKWARD));
-			cmd.rightmove = ucmdScale * (!!(pm_ps.stats[STAT_USERCMD_MOVE] & UMOVE_RIGHT) -
-				!!(pm_ps.stats[STAT_USERCMD_MOVE] & UMOVE_LEFT));
-			cmd.upmove = ucmdScale * (!!(pm_ps.stats[STAT_USERCMD_MOVE] & UMOVE_UP) -
-				!!(pm_ps.stats[STAT_USERCMD_MOVE] & UMOVE_DOWN));
-		}
-		// printf("%d %d %d\n", cmd.forwardmove, cmd.rightmove, cmd.upmove);
-		return cmd;
-	}
-
 	static void PM_CalcFriction(playerState_t* ps, vec3_t& vel, float& accel)
 	{
 		VectorCopy(ps->velocity, vel);
@@ -113,13 +93,6 @@ namespace ETJump
 		}
 	}
 
-	static float PM_CalcScale(playerState_t* ps)
-	{
-		// based on PM_CmdScale from bg_pmove.c
-		float scale = ps->stats[STAT_USERCMD_BUTTONS] & (BUTTON_SPRINT << 8) && cg.pmext.sprintTime > 50 ? ps->sprintSpeedScale : ps->runSpeedScale;
-		return scale;
-	}
-
 	static float PM_CalcScaleAlt(playerState_t const& pm_ps, usercmd_t const& cmd)
 	{
 		int32_t max = abs(cmd.forwardmove);
@@ -185,7 +158,7 @@ namespace ETJump
 		vel_size = sqrt(vel[0] * vel[0] + vel[1] * vel[1]);
 		accel = accel * ps->speed * pmove_msec.integer / 1000;
 
-		float scale = PM_CalcScale(ps);
+		float scale = movementContext.scale;
 
 		per_angle = (ps->speed - accel) / vel_size * scale;
 		if (per_angle < 1)
@@ -266,8 +239,8 @@ namespace ETJump
 		if (etj_drawCGaz.integer == 2)
 		{
 
-			parseColorString(etj_CGazColor1.string, color1);
-			parseColorString(etj_CGazColor2.string, color2);
+			parseColorCvar(etj_CGazColor1, color1);
+			parseColorCvar(etj_CGazColor2, color2);
 
 			if (etj_stretchCgaz.integer)
 			{
@@ -418,13 +391,13 @@ namespace ETJump
 		// FIXME: doesn't work on 5:4 resolution
 		if (etj_drawCGaz.integer == 5)
 		{
-			if (VectorLengthSquared2(ps->velocity) == 0)
+			if (movementContext.speed == 0)
 			{
 				return;
 			}
 
 			int8_t const ucmdScale = 127;
-			usercmd_t cmd = getUsercmd(*ps, ucmdScale);
+			usercmd_t cmd = movementContext.cmd;
 
 			// Use default key combination when no user input
 			if (!cmd.forwardmove && !cmd.rightmove)
@@ -499,7 +472,7 @@ namespace ETJump
 			// No accel zone
 			{
 				vec4_t color;
-				parseColorString(etj_CGaz5Color1.string, color);
+				parseColorCvar(etj_CGaz5Color1, color);
 				color[3] = a;
 				CG_FillAngleYaw_Ext(-d_min, +d_min, yaw, y, h, fov, color);
 			}
@@ -507,7 +480,7 @@ namespace ETJump
 			// Min angle
 			{
 				vec4_t color;
-				parseColorString(etj_CGaz5Color2.string, color);
+				parseColorCvar(etj_CGaz5Color2, color);
 				color[3] = a;
 				CG_FillAngleYaw_Ext(+d_min, +d_opt, yaw, y, h, fov, color);
 				CG_FillAngleYaw_Ext(-d_opt, -d_min, yaw, y, h, fov, color);
@@ -516,7 +489,7 @@ namespace ETJump
 			// Accel zone
 			{
 				vec4_t color;
-				parseColorString(etj_CGaz5Color3.string, color);
+				parseColorCvar(etj_CGaz5Color3, color);
 				color[3] = a;
 				CG_FillAngleYaw_Ext(+d_opt, +d_max_cos, yaw, y, h, fov, color);
 				CG_FillAngleYaw_Ext(-d_max_cos, -d_opt, yaw, y, h, fov, color);
@@ -525,7 +498,7 @@ namespace ETJump
 			// Max angle
 			{
 				vec4_t color;
-				parseColorString(etj_CGaz5Color4.string, color);
+				parseColorCvar(etj_CGaz5Color4, color);
 				color[3] = a;
 				CG_FillAngleYaw_Ext(+d_max_cos, +d_max, yaw, y, h, fov, color);
 				CG_FillAngleYaw_Ext(-d_max, -d_max_cos, yaw, y, h, fov, color);
@@ -23,13 +23,30 @@
  */
 
 #include "etj_client_commands_handler.h"
-#include <boost/algorithm/string/case_conv.hpp>
+#include <algorithm>
+#include <chrono>
 
+namespace
+{
+	char toLower(char c)
+	{
+		return c >= 'A' && c <= 'Z' ? c - 'A' + 'a' : c;
+	}
+
+	bool equalsIgnoreCase(const char *lhs, const char *rhs)
+	{
+		while (*lhs && toLower(*lhs) == toLower(*rhs))
+		{
+			++lhs;
+			++rhs;
+		}
+		return toLower(*lhs) == toLower(*rhs);
+	}
+}
 
 ETJump::ClientCommandsHandler::ClientCommandsHandler(void (*addToAutocompleteList)(const char *)):
 	_addToAutocompleteList{addToAutocompleteList}
 {
-	_callbacks.clear();
 }
 
 
@@ -37,27 +54,121 @@ ETJump::ClientCommandsHandler::~ClientCommandsHandler()
 {
 }
 
+uint32_t ETJump::ClientCommandsHandler::hash(const char *command)
+{
+	uint32_t hash = 2166136261u;
+	for (; *command; ++command)
+	{
+		hash ^= static_cast<unsigned char>(toLower(*command));
+		hash *= 16777619u;
+	}
+	return hash;
+}
+
 bool ETJump::ClientCommandsHandler::check(const std::string& command, const std::vector<std::string>& arguments)
 {
-	auto lowercaseCommand = boost::algorithm::to_lower_copy(command);
-	auto match = _callbacks.find(lowercaseCommand);
-	if (match != end(_callbacks))
+	auto match = find(command.c_str());
+	if (match == nullptr)
+	{
+		return false;
+	}
+
+	return execute(*match, [&arguments]
+	{
+		return arguments;
+	});
+}
+
+bool ETJump::ClientCommandsHandler::check(const char *command, const std::function<std::vector<std::string>()>& getArguments)
+{
+	auto match = find(command);
+	if (match == nullptr)
+	{
+		return false;
+	}
+
+	return execute(*match, getArguments);
+}
+
+bool ETJump::ClientCommandsHandler::subscribe(const std::string& command, Callback callback, bool autocomplete)
+{
+	return add(command, callback, nullptr, autocomplete);
+}
+
+bool ETJump::ClientCommandsHandler::subscribeRaw(const std::string& command, RawCallback callback, bool autocomplete)
+{
+	return add(command, nullptr, callback, autocomplete);
+}
+
+bool ETJump::ClientCommandsHandler::unsubcribe(const std::string& command)
+{
+	auto match = find(command.c_str());
+	if (match == nullptr)
 	{
-		match->second(arguments);
-		return true;
+		return false;
+	}
+
+	_commands.erase(std::find_if(begin(_commands), end(_commands), [match](const std::unique_ptr<Command>& c)
+	{
+		return c.get() == match;
+	}));
+	rebuildIndex();
+	return true;
+}
+
+std::vector<ETJump::ClientCommandsHandler::CommandStats> ETJump::ClientCommandsHandler::stats() const
+{
+	std::vector<CommandStats> result;
+	for (const auto& command : _commands)
+	{
+		result.push_back({ command->name, command->calls, command->totalMicroseconds, command->maxMicroseconds });
+	}
+
+	std::sort(begin(result), end(result), [](const CommandStats& lhs, const CommandStats& rhs)
+	{
+		if (lhs.totalMicroseconds != rhs.totalMicroseconds)
+		{
+			return lhs.totalMicroseconds > rhs.totalMicroseconds;
+		}
+		return lhs.calls > rhs.calls;
+	});
+	return result;
+}
+
+void ETJump::ClientCommandsHandler::resetStats()
+{
+	for (auto& command : _commands)
+	{
+		command->calls = 0;
+		command->totalMicroseconds = 0;
+		command->maxMicroseconds = 0;
+	}
+}
+
+ETJump::ClientCommandsHandler::Command *ETJump::ClientCommandsHandler::find(const char *command)
+{
+	auto range = _index.equal_range(hash(command));
+	for (auto it = range.first; it != range.second; ++it)
+	{
+		if (equalsIgnoreCase(it->second->name.c_str(), command))
+		{
+			return it->second;
+		}
 	}
-	return false;
+	return nullptr;
 }
 
-bool ETJump::ClientCommandsHandler::subscribe(const std::string& command, std::function<void(const std::vector<std::string>&)> callback, bool autocomplete)
+bool ETJump::ClientCommandsHandler::add(const std::string& command, Callback callback, RawCallback rawCallback, bool autocomplete)
 {
-	auto lowercaseCommand = boost::algorithm::to_lower_copy(command);
-	if (_callbacks.find(lowercaseCommand) != end(_callbacks))
+	if (find(command.c_str()) != nullptr)
 	{
 		return false;
 	}
 
-	_callbacks[lowercaseCommand] = callback;
+	std::unique_ptr<Command> entry(new Command{ command, hash(command.c_str()), callback, rawCallback, 0, 0, 0 });
+	_index.insert(std::make_pair(entry->hash, entry.get()));
+	_commands.push_back(std::move(entry));
+
 	if (_addToAutocompleteList != nullptr && autocomplete)
 	{
 		_addToAutocompleteList(command.c_str());
@@ -65,15 +176,44 @@ bool ETJump::ClientCommandsHandler::subscribe(const std::string& command, std::f
 	return true;
 }
 
-bool ETJump::ClientCommandsHandler::unsubcribe(const std::string& command)
+bool ETJump::ClientCommandsHandler::execute(Command& command, const std::function<std::vector<std::string>()>& getArguments)
 {
-	auto lowercaseCommand = boost::algorithm::to_lower_copy(command);
-	auto callback = _callbacks.find(lowercaseCommand);
-	if (callback != end(_callbacks))
+	auto start = std::chrono::steady_clock::now();
+	auto entry = &command;
+	auto commandHash = command.hash;
+	++command.calls;
+
+	// callbacks are copied as the command might unsubscribe itself
+	if (command.rawCallback)
 	{
-		return false;
+		auto callback = command.rawCallback;
+		callback();
+	}
+	else
+	{
+		auto callback = command.callback;
+		callback(getArguments());
 	}
 
-	_callbacks.erase(callback);
+	auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+	auto range = _index.equal_range(commandHash);
+	for (auto it = range.first; it != range.second; ++it)
+	{
+		if (it->second == entry)
+		{
+			entry->totalMicroseconds += elapsed;
+			entry->maxMicroseconds = std::max<int64_t>(entry->maxMicroseconds, elapsed);
+			break;
+		}
+	}
 	return true;
 }
+
+void ETJump::ClientCommandsHandler::rebuildIndex()
+{
+	_index.clear();
+	for (const auto& command : _commands)
+	{
+		_index.insert(std::make_pair(command->hash, command.get()));
+	}
+}
@@ -25,34 +25,73 @@
 #pragma once
 #include <string>
 #include <functional>
-#include <map>
+#include <unordered_map>
 #include <vector>
 #include <memory>
+#include <cstdint>
 
 namespace ETJump
 {
 	class ClientCommandsHandler
 	{
 	public:
+		typedef std::function<void(const std::vector<std::string>&)> Callback;
+		// callback that reads its arguments from the engine itself
+		typedef std::function<void()> RawCallback;
+
+		struct CommandStats
+		{
+			std::string command;
+			unsigned calls;
+			int64_t totalMicroseconds;
+			int64_t maxMicroseconds;
+		};
+
 		explicit ClientCommandsHandler(void (const char *));
 		~ClientCommandsHandler();
 
 		// returns true if a match was found and function was called
 		bool check(const std::string& command, const std::vector<std::string>& arguments);
 
+		// same as above, but arguments are only collected if the matching handler takes them
+		bool check(const char *command, const std::function<std::vector<std::string>()>& getArguments);
+
 		// registers a command handler that will be called if the command was received from the server
 		// returns false if handler with the same name already exists
-		bool subscribe(const std::string& command, std::function<void(const std::vector<std::string>&)> callback, bool autocomplete = true);
+		bool subscribe(const std::string& command, Callback callback, bool autocomplete = true);
+		bool subscribeRaw(const std::string& command, RawCallback callback, bool autocomplete = true);
 
 		// unsubscribes the command handler
 		// returns false if it does not exist
 		bool unsubcribe(const std::string& command);
+
+		// call counts and execution times of every command, most expensive first
+		std::vector<CommandStats> stats() const;
+		void resetStats();
+
+		// case insensitive FNV-1a
+		static uint32_t hash(const char *command);
 	private:
+		struct Command
+		{
+			std::string name;
+			uint32_t hash;
+			Callback callback;
+			RawCallback rawCallback;
+			unsigned calls;
+			int64_t totalMicroseconds;
+			int64_t maxMicroseconds;
+		};
+
+		Command *find(const char *command);
+		bool add(const std::string& command, Callback callback, RawCallback rawCallback, bool autocomplete);
+		bool execute(Command& command, const std::function<std::vector<std::string>()>& getArguments);
+		void rebuildIndex();
+
 		void(*_addToAutocompleteList)(const char *command);
 
-		std::map<std::string, std::function<void(std::vector<std::string>)>> _callbacks;
+		std::vector<std::unique_ptr<Command>> _commands;
+		// commands whose names hash to the same value
+		std::unordered_multimap<uint32_t, Command *> _index;
 	};
 }
-
-
-
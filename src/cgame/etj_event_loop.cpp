@@ -23,146 +23,312 @@
  */
 
 #include <algorithm>
-#include <chrono>
-#include "cg_local.h"
+#include <stdexcept>
 #include "etj_event_loop.h"
 
-using std::find_if;
-using std::chrono::system_clock;
-using std::chrono::milliseconds;
-using std::chrono::duration_cast;
-using std::remove_if;
+namespace
+{
+	// std heap functions build a max-heap, so "less" means "due later"
+	template <typename Entry>
+	bool isDueLater(const Entry &lhs, const Entry &rhs)
+	{
+		if (lhs.end != rhs.end)
+		{
+			return lhs.end > rhs.end;
+		}
+		return lhs.sequence > rhs.sequence;
+	}
+}
+
+const int ETJump::EventLoop::SlotBits;
+const int ETJump::EventLoop::MaxSlots;
+const int ETJump::EventLoop::MaxGeneration;
+
+ETJump::EventLoop::EventLoop(function<int64_t()> getTime) : getTime(getTime)
+{
+}
 
 void ETJump::EventLoop::run()
 {
-	processEvents();
-	cleanUpEvents();
+	if (!activeTasks)
+	{
+		return;
+	}
+
+	auto now = getNow();
+	isExecutingEvents = true;
+	processEvents(importantTasks, now);
+	processEvents(ordinaryTasks, now);
+	isExecutingEvents = false;
+
+	for (const auto &entry : deferredTasks)
+	{
+		// skip tasks that were unscheduled after being deferred
+		if (isCurrent(entry))
+		{
+			queueTask(entry.slot);
+		}
+	}
+	deferredTasks.clear();
+
+	compact(importantTasks);
+	compact(ordinaryTasks);
 }
 
 int ETJump::EventLoop::schedule(function<void()> fn, int delay, TaskPriorities priority)
 {
-	Task task{ fn, ++eventCounter, delay, getNow() + delay, false, false };
-	return scheduleEvent(task, priority);
+	return scheduleEvent(std::move(fn), delay, priority, false);
 }
 
 int ETJump::EventLoop::schedulePersistent(function<void()> fn, int delay, TaskPriorities priority)
 {
-	Task task{ fn, ++eventCounter, delay, getNow() + delay, true, false };
-	return scheduleEvent(task, priority);
+	return scheduleEvent(std::move(fn), delay, priority, true);
 }
 
 bool ETJump::EventLoop::unschedule(int taskId)
 {
-	//auto predicate = [&taskId](const Task &task) { return task.id == taskId; };
-	//for (auto *storage : { &ordinaryTasks, &importantTasks }) {
-	//	auto it = find_if(storage->begin(), storage->end(), predicate);
-	//	if (it != storage->end()) {
-	//		if (isExecutingEvents) it->deprecated = true; // postpone removal; let event processing handle it
-	//		else storage->erase(it);
-	//		return true;
-	//	}
-	//}
-	//return false;
-
-	Task *task = findTask(taskId);
-	if (task) {
-		task->deprecated = true; // let event processing handle removal
-		return true;
+	auto slot = findTask(taskId);
+	if (slot < 0)
+	{
+		return false;
 	}
-	return false;
+
+	// heap entry of the task is now stale and gets skipped
+	releaseTask(slot);
+	return true;
 }
 
 void ETJump::EventLoop::shutdown()
 {
-	removeEventsIf([&](Task const &task) {
-		if (!task.deprecated) task.fn();
-		return true;
+	// run the remaining tasks in the order they would have been executed
+	vector<int> remaining;
+	for (auto i = 0; i < static_cast<int>(tasks.size()); i++)
+	{
+		if (tasks[i].active)
+		{
+			remaining.push_back(i);
+		}
+	}
+
+	std::sort(remaining.begin(), remaining.end(), [&](int lhs, int rhs)
+	{
+		if (tasks[lhs].priority != tasks[rhs].priority)
+		{
+			return tasks[lhs].priority == TaskPriorities::Immediate;
+		}
+		return tasks[lhs].sequence < tasks[rhs].sequence;
 	});
+
+	vector<function<void()>> fns;
+	for (auto slot : remaining)
+	{
+		fns.push_back(std::move(tasks[slot].fn));
+	}
+
+	tasks.clear();
+	freeSlots.clear();
+	ordinaryTasks.clear();
+	importantTasks.clear();
+	deferredTasks.clear();
+	activeTasks = 0;
+
+	for (auto &fn : fns)
+	{
+		fn();
+	}
 }
 
 bool ETJump::EventLoop::hasPendingEvents()
 {
-	return !ordinaryTasks.empty() || !importantTasks.empty();
+	return activeTasks > 0;
 }
 
 int ETJump::EventLoop::pendingEventsCount()
 {
-	return ordinaryTasks.empty() + importantTasks.size();
+	return activeTasks;
 }
 
-void ETJump::EventLoop::processEvents()
+void ETJump::EventLoop::processEvents(vector<HeapEntry> &heap, int64_t now)
 {
-	if (!importantTasks.size() && !ordinaryTasks.size()) return;
+	while (!heap.empty())
+	{
+		const auto entry = heap.front();
+		if (isCurrent(entry) && entry.end > now)
+		{
+			break;
+		}
 
-	auto now = getNow();
-	vector<Task*> queue;
-	isExecutingEvents = true;
-	iterateEvents([&](Task &task) { if (!task.deprecated && now >= task.end) queue.push_back(&task); });
+		std::pop_heap(heap.begin(), heap.end(), isDueLater<HeapEntry>);
+		heap.pop_back();
+
+		if (!isCurrent(entry))
+		{
+			continue;
+		}
+
+		auto &task = tasks[entry.slot];
+		auto generation = task.generation;
+		auto persistent = task.persistent;
+		// the task might unschedule itself or schedule new tasks
+		// which can reallocate the task storage, so run a local copy
+		auto fn = std::move(task.fn);
+
+		if (persistent)
+		{
+			task.end = now + task.delay; // reschedule
+			task.sequence = ++sequenceCounter;
+			deferTask(entry.slot);
+		}
+		else
+		{
+			releaseTask(entry.slot);
+		}
+
+		fn();
 
-	for (auto *task : queue)
+		// still scheduled, give the function back to the task
+		if (persistent && tasks[entry.slot].active && tasks[entry.slot].generation == generation)
+		{
+			tasks[entry.slot].fn = std::move(fn);
+		}
+	}
+}
+
+int ETJump::EventLoop::scheduleEvent(function<void()> fn, int delay, TaskPriorities priority, bool persistent)
+{
+	int slot;
+	if (!freeSlots.empty())
+	{
+		slot = freeSlots.back();
+		freeSlots.pop_back();
+	}
+	else
 	{
-		if (task->persistent) task->end = now + task->delay; // reschedule
-		task->fn();
+		if (static_cast<int>(tasks.size()) >= MaxSlots)
+		{
+			throw std::runtime_error("EventLoop: too many scheduled tasks");
+		}
+		slot = static_cast<int>(tasks.size());
+		tasks.push_back(Task{ nullptr, 1, 0, 0, 0, TaskPriorities::Default, false, false });
 	}
 
-	isExecutingEvents = false;
+	auto &task = tasks[slot];
+	task.fn = std::move(fn);
+	task.delay = delay;
+	task.end = getNow() + delay;
+	task.sequence = ++sequenceCounter;
+	task.priority = priority;
+	task.persistent = persistent;
+	task.active = true;
+	++activeTasks;
+
+	if (isExecutingEvents)
+	{
+		deferTask(slot);
+	}
+	else
+	{
+		queueTask(slot);
+	}
+
+	return makeId(slot, task.generation);
 }
 
-int ETJump::EventLoop::scheduleEvent(const Task &task, TaskPriorities priority)
+void ETJump::EventLoop::queueTask(int slot)
 {
-	if (priority == TaskPriorities::Default) ordinaryTasks.push_back(task);
-	else if (priority == TaskPriorities::Immediate) importantTasks.push_back(task);
-	return eventCounter;
+	const auto &task = tasks[slot];
+	auto &heap = task.priority == TaskPriorities::Immediate ? importantTasks : ordinaryTasks;
+	heap.push_back(HeapEntry{ task.end, task.sequence, slot });
+	std::push_heap(heap.begin(), heap.end(), isDueLater<HeapEntry>);
 }
 
-void ETJump::EventLoop::iterateEvents(function<void(Task &task)> fn)
+void ETJump::EventLoop::deferTask(int slot)
 {
-	for (auto *storage : { &importantTasks, &ordinaryTasks }) {
-		for_each(storage->begin(), storage->end(), [&](Task &task) { fn(task); });
-	}
+	const auto &task = tasks[slot];
+	deferredTasks.push_back(HeapEntry{ task.end, task.sequence, slot });
 }
 
-void ETJump::EventLoop::cleanUpEvents()
+void ETJump::EventLoop::releaseTask(int slot)
 {
-	auto now = getNow();
-	removeEventsIf([&](Task &task)
-	{
-		if (task.deprecated) return true;
-		if (!task.persistent && now >= task.end) return true;
-		return false;
-	});
+	auto &task = tasks[slot];
+	task.fn = nullptr;
+	task.active = false;
+	task.generation = task.generation == MaxGeneration ? 1 : task.generation + 1;
+	--activeTasks;
+	freeSlots.push_back(slot);
 }
 
-void ETJump::EventLoop::removeEventsIf(function<bool(Task& task)> fn)
+void ETJump::EventLoop::compact(vector<HeapEntry> &heap)
 {
-	for (auto *storage : { &importantTasks, &ordinaryTasks }) {
-		auto removeIter = remove_if(storage->begin(), storage->end(), [&](Task &task) { return fn(task); });
-		storage->erase(removeIter, storage->end());
+	// rebuild the heap once most of it is unscheduled tasks
+	if (heap.size() < 64 || heap.size() < 2 * static_cast<std::size_t>(activeTasks))
+	{
+		return;
 	}
+
+	heap.erase(std::remove_if(heap.begin(), heap.end(), [&](const HeapEntry &entry)
+	{
+		return !isCurrent(entry);
+	}), heap.end());
+	std::make_heap(heap.begin(), heap.end(), isDueLater<HeapEntry>);
 }
 
-ETJump::EventLoop::Task* ETJump::EventLoop::findTask(int taskId)
+bool ETJump::EventLoop::isCurrent(const HeapEntry &entry) const
 {
-	auto predicate = [&taskId](const Task &task) { return task.id == taskId; };
-	for (auto *storage : { &ordinaryTasks, &importantTasks }) {
-		auto it = find_if(storage->begin(), storage->end(), predicate);
-		if (it != storage->end()) return &*it;
+	const auto &task = tasks[entry.slot];
+	return task.active && task.sequence == entry.sequence;
+}
+
+int ETJump::EventLoop::findTask(int taskId) const
+{
+	if (taskId <= 0)
+	{
+		return -1;
 	}
-	return nullptr;
+
+	auto slot = taskId & (MaxSlots - 1);
+	auto generation = taskId >> SlotBits;
+	if (slot >= static_cast<int>(tasks.size()))
+	{
+		return -1;
+	}
+
+	const auto &task = tasks[slot];
+	if (!task.active || task.generation != generation)
+	{
+		return -1;
+	}
+	return slot;
+}
+
+int ETJump::EventLoop::makeId(int slot, int generation)
+{
+	return (generation << SlotBits) | slot;
 }
 
 int64_t ETJump::EventLoop::getNow()
 {
-    return static_cast<int64_t>(cg.time);
+	return getTime();
 }
 
 void ETJump::EventLoop::execute(int taskId)
 {
-	auto now = getNow();
-	Task *target = findTask(taskId);
-	if (target)
+	auto slot = findTask(taskId);
+	if (slot < 0)
 	{
-		target->end = 0;
-		target->fn();
+		return;
 	}
+
+	auto &task = tasks[slot];
+	if (task.persistent)
+	{
+		// copy, the task might unschedule itself
+		auto fn = task.fn;
+		fn();
+		return;
+	}
+
+	auto fn = std::move(task.fn);
+	releaseTask(slot);
+	fn();
 }
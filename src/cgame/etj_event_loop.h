@@ -24,6 +24,11 @@
 
 /*
 	Single threaded(non thread safe) ordered task scheduler.
+
+	Tasks are kept in a min-heap per priority ordered by their due time, so
+	scheduling and running tasks is O(log n). Task ids carry the generation of
+	their slot, so an id of a task that has already finished never matches a
+	task that reuses the slot.
 */
 #pragma once
 
@@ -49,20 +54,42 @@ namespace ETJump
 	};
 
 	class EventLoop {
+		static const int SlotBits = 16;
+		static const int MaxSlots = 1 << SlotBits;
+		static const int MaxGeneration = (1 << (31 - SlotBits)) - 1;
+
 		struct Task {
 			function<void()> fn;
-			int id;
+			int generation;
 			int delay;
 			int64_t end;
+			uint64_t sequence;
+			TaskPriorities priority;
 			bool persistent;
-			bool deprecated;
+			bool active;
+		};
+
+		// heap entries go stale when their task is unscheduled or rescheduled,
+		// stale entries are skipped when they reach the top of the heap
+		struct HeapEntry {
+			int64_t end;
+			uint64_t sequence;
+			int slot;
 		};
-		vector<Task> ordinaryTasks;
-		vector<Task> importantTasks;
-		int eventCounter = 0;
+
+		vector<Task> tasks;
+		vector<int> freeSlots;
+		vector<HeapEntry> ordinaryTasks;
+		vector<HeapEntry> importantTasks;
+		// tasks scheduled or rescheduled while events are executed,
+		// these are queued after the current batch so they never run in it
+		vector<HeapEntry> deferredTasks;
+		function<int64_t()> getTime;
+		uint64_t sequenceCounter = 0;
+		int activeTasks = 0;
 		bool isExecutingEvents = false;
 	public:
-		EventLoop() {};
+		explicit EventLoop(function<int64_t()> getTime);
 		~EventLoop() {};
 		void run();
 		int schedule(function<void()> fn, int delay, TaskPriorities priority = TaskPriorities::Default);
@@ -73,12 +100,15 @@ namespace ETJump
 		int pendingEventsCount();
 		void execute(int taskId); // nasty little helper to execute non persistent tasks beforehand
 	private:
-		void processEvents();
-		int scheduleEvent(const Task &task, TaskPriorities priority);
-		void cleanUpEvents();
-		void iterateEvents(function<void(Task &task)> fn);
-		void removeEventsIf(function<bool(Task &task)> fn);
-		Task* findTask(int taskId);
+		void processEvents(vector<HeapEntry> &heap, int64_t now);
+		int scheduleEvent(function<void()> fn, int delay, TaskPriorities priority, bool persistent);
+		void queueTask(int slot);
+		void deferTask(int slot);
+		void releaseTask(int slot);
+		void compact(vector<HeapEntry> &heap);
+		bool isCurrent(const HeapEntry &entry) const;
+		int findTask(int taskId) const;
+		static int makeId(int slot, int generation);
 		int64_t getNow();
 	};
-}
\ No newline at end of file
+}
@@ -0,0 +1,131 @@
+#include "etj_movement_context.h"
+
+namespace ETJump
+{
+	MovementContext movementContext;
+
+	const float MovementContext::TraceDistance = 131072;
+
+	playerState_t *getValidPlayerState()
+	{
+		return (cg.snap->ps.clientNum != cg.clientNum)
+			// spectating
+			? &cg.snap->ps
+			// playing
+			: &cg.predictedPlayerState;
+	}
+
+	static usercmd_t getUsercmd(const playerState_t& ps, int8_t ucmdScale)
+	{
+		usercmd_t cmd;
+
+		memset(&cmd, 0, sizeof(cmd));
+
+		if (!cg.demoPlayback && !(ps.pm_flags & PMF_FOLLOW))
+		{
+			trap_GetUserCmd(trap_GetCurrentCmdNumber(), &cmd);
+		}
+		else
+		{
+			cmd.forwardmove = ucmdScale * (!!(ps.stats[STAT_USERCMD_MOVE] & UMOVE_FORWARD) -
+				!!(ps.stats[STAT_USERCMD_MOVE] & UMOVE_BACKWARD));
+			cmd.rightmove = ucmdScale * (!!(ps.stats[STAT_USERCMD_MOVE] & UMOVE_RIGHT) -
+				!!(ps.stats[STAT_USERCMD_MOVE] & UMOVE_LEFT));
+			cmd.upmove = ucmdScale * (!!(ps.stats[STAT_USERCMD_MOVE] & UMOVE_UP) -
+				!!(ps.stats[STAT_USERCMD_MOVE] & UMOVE_DOWN));
+		}
+
+		return cmd;
+	}
+
+	MovementContext::MovementContext()
+	{
+		memset(&cmd, 0, sizeof(cmd));
+	}
+
+	void MovementContext::update()
+	{
+		const playerState_t& ps = cg.predictedPlayerState;
+
+		_viewTraces.clear();
+		_groundTraces.clear();
+
+		speed = sqrt(ps.velocity[0] * ps.velocity[0] + ps.velocity[1] * ps.velocity[1]);
+
+		// based on PM_CmdScale from bg_pmove.c
+		scale = ps.stats[STAT_USERCMD_BUTTONS] & (BUTTON_SPRINT << 8) && cg.pmext.sprintTime > 50
+			? ps.sprintSpeedScale
+			: ps.runSpeedScale;
+
+		cmd = getUsercmd(ps, 127);
+	}
+
+	const trace_t& MovementContext::cachedViewTrace(int contents)
+	{
+		for (const auto& cached : _viewTraces)
+		{
+			if (cached.contents == contents)
+			{
+				return cached.trace;
+			}
+		}
+
+		CachedTrace cached;
+		vec3_t end;
+
+		cached.contents = contents;
+		VectorMA(cg.refdef.vieworg, TraceDistance, cg.refdef.viewaxis[0], end);
+		CG_Trace(&cached.trace, cg.refdef.vieworg, nullptr, nullptr, end, getValidPlayerState()->clientNum, contents);
+
+		_viewTraces.push_back(cached);
+		return _viewTraces.back().trace;
+	}
+
+	trace_t MovementContext::viewTrace(int contents, float maxDist)
+	{
+		const trace_t& full = cachedViewTrace(contents);
+		const float dist = full.fraction * TraceDistance;
+		trace_t trace;
+
+		if (full.fraction < 1.0f && dist <= maxDist)
+		{
+			trace = full;
+			trace.fraction = dist / maxDist;
+			return trace;
+		}
+
+		// same as a trace that stops at maxDist without hitting anything
+		memset(&trace, 0, sizeof(trace));
+		trace.allsolid   = full.allsolid;
+		trace.startsolid = full.startsolid;
+		trace.fraction   = 1.0f;
+		trace.entityNum  = ENTITYNUM_NONE;
+		VectorMA(cg.refdef.vieworg, maxDist, cg.refdef.viewaxis[0], trace.endpos);
+		return trace;
+	}
+
+	const trace_t& MovementContext::groundTrace(int contents)
+	{
+		for (const auto& cached : _groundTraces)
+		{
+			if (cached.contents == contents)
+			{
+				return cached.trace;
+			}
+		}
+
+		const playerState_t *ps = getValidPlayerState();
+		CachedTrace cached;
+		vec3_t start, end;
+
+		cached.contents = contents;
+		VectorCopy(ps->origin, start);
+		start[2] += ps->mins[2];
+		VectorCopy(start, end);
+		end[2] -= TraceDistance;
+		CG_Trace(&cached.trace, start, nullptr, nullptr, end, ps->clientNum, contents);
+
+		_groundTraces.push_back(cached);
+		return _groundTraces.back().trace;
+	}
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <vector>
+#include "cg_local.h"
+
+namespace ETJump
+{
+	// Movement state of the player on screen, shared by the HUD elements.
+	// Values are updated once per frame right after prediction, traces
+	// are done the first time they're asked for in a frame.
+	class MovementContext
+	{
+		struct CachedTrace
+		{
+			int contents;
+			trace_t trace;
+		};
+
+		std::vector<CachedTrace> _viewTraces;
+		std::vector<CachedTrace> _groundTraces;
+
+		const trace_t& cachedViewTrace(int contents);
+	public:
+		static const float TraceDistance;
+
+		// horizontal speed
+		float speed{ 0 };
+		// PM_CmdScale speed scale, depends on whether the player is sprinting
+		float scale{ 0 };
+		// latest usercmd, or the movement keys of the followed player scaled to 127
+		usercmd_t cmd;
+
+		MovementContext();
+		void update();
+
+		// trace along the view direction, hits further than maxDist are misses
+		trace_t viewTrace(int contents, float maxDist);
+		// trace straight down from the feet of the player
+		const trace_t& groundTrace(int contents);
+	};
+
+	// the player state HUD elements should look at, the snapshot one when spectating
+	playerState_t *getValidPlayerState();
+
+	extern MovementContext movementContext;
+}
@@ -1,68 +1,39 @@
 #include "etj_snaphud.h"
+#include "etj_snaphud_zones.h"
 #include "etj_utilities.h"
+#include "etj_movement_context.h"
 #include "../game/etj_numeric_utilities.h"
 
 // Snaphud implementation based on iodfe
 
 namespace ETJump
 {
-	constexpr int SNAPHUD_MAXZONES{ 128 };
-	float snapSpeed;
-	float snapZones[SNAPHUD_MAXZONES];
-	int snapCount;
-
-	static int QDECL sortSnapZones(const void* a, const void* b)
+	// default g_speed and run and sprint speed scales, see ClientSpawn
+	static const int DefaultSpeed = 320;
+	static const float RunSpeedScale = 0.8f;
+	static const float SprintSpeedScale = 1.1f;
+
+	static SnapZoneCache snapZoneCache(16);
+	static float snapSpeed;
+	static int snapBaseSpeed;
+	static const std::vector<float> *snapZones;
+
+	// computes the zones for running and sprinting at the given g_speed,
+	// so the table doesn't have to be built when the player starts sprinting
+	static void PrecomputeSnapZones(int baseSpeed, float runSpeedScale, float sprintSpeedScale)
 	{
-		return *(float*)a - *(float*)b;
+		snapBaseSpeed = baseSpeed;
+		snapZoneCache.zones(baseSpeed * runSpeedScale);
+		snapZoneCache.zones(baseSpeed * sprintSpeedScale);
+		// cached tables may have been dropped
+		snapSpeed = 0;
+		snapZones = nullptr;
 	}
 
-	// FIXME: share this with cgaz
-	static float PM_CalcScale(playerState_t* ps)
+	void InitSnapHUD()
 	{
-		// based on PM_CmdScale from bg_pmove.c
-		float scale = ps->stats[STAT_USERCMD_BUTTONS] & (BUTTON_SPRINT << 8) && cg.pmext.sprintTime > 50 ? ps->sprintSpeedScale : ps->runSpeedScale;
-		return scale;
-	}
-
-	static usercmd_t getUsercmd(playerState_t const& pm_ps, int8_t ucmdScale)
-	{
-		usercmd_t cmd;
-		if (!cg.demoPlayback && !(pm_ps.pm_flags & PMF_FOLLOW))
-		{
-			int cmdNum = trap_GetCurrentCmdNumber();
-			trap_GetUserCmd(cmdNum, &cmd);
-		}
-		else
-		{
-			cmd.forwardmove = ucmdScale * (!!(pm_ps.stats[STAT_USERCMD_MOVE] & UMOVE_FORWARD) -
-				!!(pm_ps.stats[STAT_USERCMD_MOVE] & UMOVE_BACKWARD));
-			cmd.rightmove = ucmdScale * (!!(pm_ps.stats[STAT_USERCMD_MOVE] & UMOVE_RIGHT) -
-				!!(pm_ps.stats[STAT_USERCMD_MOVE] & UMOVE_LEFT));
-			cmd.upmove = ucmdScale * (!!(pm_ps.stats[STAT_USERCMD_MOVE] & UMOVE_UP) -
-				!!(pm_ps.stats[STAT_USERCMD_MOVE] & UMOVE_DOWN));
-		}
-		// printf("%d %d %d\n", cmd.forwardmove, cmd.rightmove, cmd.upmove);
-		return cmd;
-	}
-
-	static void UpdateSnapHUDSettings(float speed)
-	{
-		float step;
-
-		snapSpeed = speed;
-		speed /= 125;
-		snapCount = 0;
-
-		for (step = floor(speed + 0.5) - 0.5; step > 0 && snapCount < SNAPHUD_MAXZONES - 2; step--)
-		{
-			snapZones[snapCount] = RAD2DEG(acos(step / speed));
-			snapCount++;
-			snapZones[snapCount] = RAD2DEG(asin(step / speed));
-			snapCount++;
-		}
-
-		qsort(snapZones, snapCount, sizeof(snapZones[0]), sortSnapZones);
-		snapZones[snapCount] = snapZones[0] + 90;
+		snapZoneCache.clear();
+		PrecomputeSnapZones(DefaultSpeed, RunSpeedScale, SprintSpeedScale);
 	}
 
 	void DrawSnapHUD(void)
@@ -74,9 +45,6 @@ namespace ETJump
 		float fov;
 		vec4_t color[2];
 		int colorID = 0;
-		playerState_t* ps;
-
-		ps = &cg.predictedPlayerState;
 
 		if (!etj_drawSnapHUD.integer)
 		{
@@ -89,21 +57,26 @@ namespace ETJump
 		}
 
 		// get correct speed scaling
-		scale = PM_CalcScale(ps);
+		scale = movementContext.scale;
+
+		if (cg.snap->ps.speed != snapBaseSpeed)
+		{
+			PrecomputeSnapZones(cg.snap->ps.speed, cg.snap->ps.runSpeedScale, cg.snap->ps.sprintSpeedScale);
+		}
 
-		// check whether snapSpeed needs to be updated
+		// check whether snapZones needs to be updated
 		speed = cg.snap->ps.speed * scale;
-		if (speed != snapSpeed)
+		if (!snapZones || speed != snapSpeed)
 		{
-			UpdateSnapHUDSettings(speed);
+			snapSpeed = speed;
+			snapZones = &snapZoneCache.zones(speed);
 		}
 
 		// apply correct yaw offset for different strafe styles,
 		// or if no keys are pressed
 		yaw = cg.predictedPlayerState.viewangles[YAW];
 
-		int8_t const ucmdScale = 127;
-		usercmd_t cmd = getUsercmd(*ps, ucmdScale);
+		const usercmd_t& cmd = movementContext.cmd;
 
 		if (cmd.forwardmove != 0 && cmd.rightmove != 0)
 		{
@@ -127,13 +100,14 @@ namespace ETJump
 			fov = Numeric::clamp(etj_snapHUDFov.value, 1, 180);
 		}
 
-		parseColorString(etj_snapHUDColor1.string, color[0]);
-		parseColorString(etj_snapHUDColor2.string, color[1]);
+		parseColorCvar(etj_snapHUDColor1, color[0]);
+		parseColorCvar(etj_snapHUDColor2, color[1]);
 
-		for (int i = 0; i < snapCount; i++)
+		const std::vector<float>& zones = *snapZones;
+		for (size_t i = 0; i + 1 < zones.size(); i++)
 		{
-			CG_FillAngleYaw(snapZones[i], snapZones[i + 1], yaw, y, h, fov, color[colorID]);
-			CG_FillAngleYaw(snapZones[i] + 90, snapZones[i + 1] + 90, yaw, y, h, fov, color[colorID]);
+			CG_FillAngleYaw(zones[i], zones[i + 1], yaw, y, h, fov, color[colorID]);
+			CG_FillAngleYaw(zones[i] + 90, zones[i + 1] + 90, yaw, y, h, fov, color[colorID]);
 			colorID ^= 1;
 		}
 	}
@@ -4,5 +4,6 @@
 
 namespace ETJump
 {
+	void InitSnapHUD();
 	void DrawSnapHUD();
 }
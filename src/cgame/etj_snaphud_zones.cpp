@@ -0,0 +1,69 @@
+#include "etj_snaphud_zones.h"
+#include <algorithm>
+#include "../game/q_shared.h"
+
+namespace ETJump
+{
+	SnapZoneCache::SnapZoneCache(size_t capacity) : _capacity(std::max<size_t>(capacity, 1))
+	{
+	}
+
+	std::vector<float> SnapZoneCache::computeZones(float speed)
+	{
+		std::vector<float> zones;
+		float              step;
+
+		speed /= 125;
+
+		for (step = floor(speed + 0.5) - 0.5; step > 0 && zones.size() < static_cast<size_t>(MaxZones - 2); step--)
+		{
+			zones.push_back(RAD2DEG(acos(step / speed)));
+			zones.push_back(RAD2DEG(asin(step / speed)));
+		}
+
+		if (zones.empty())
+		{
+			return zones;
+		}
+
+		std::sort(zones.begin(), zones.end());
+		zones.push_back(zones.front() + 90);
+		return zones;
+	}
+
+	const std::vector<float>& SnapZoneCache::zones(float speed)
+	{
+		auto it = _index.find(speed);
+		if (it != _index.end())
+		{
+			_entries.splice(_entries.begin(), _entries, it->second);
+			return it->second->second;
+		}
+
+		if (_entries.size() >= _capacity)
+		{
+			_index.erase(_entries.back().first);
+			_entries.pop_back();
+		}
+
+		_entries.emplace_front(speed, computeZones(speed));
+		_index[speed] = _entries.begin();
+		return _entries.front().second;
+	}
+
+	bool SnapZoneCache::contains(float speed) const
+	{
+		return _index.find(speed) != _index.end();
+	}
+
+	size_t SnapZoneCache::size() const
+	{
+		return _entries.size();
+	}
+
+	void SnapZoneCache::clear()
+	{
+		_entries.clear();
+		_index.clear();
+	}
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstddef>
+#include <list>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace ETJump
+{
+	// Snap zone tables of the snaphud by speed. Zones only depend on the
+	// speed, which only takes a few values (g_speed scaled by run or sprint
+	// speed scale), so tables are computed once and the least recently used
+	// ones are dropped when the cache is full.
+	class SnapZoneCache
+	{
+	public:
+		static const int MaxZones = 128;
+
+		explicit SnapZoneCache(size_t capacity);
+
+		// zone edges in degrees in ascending order, followed by the
+		// first edge + 90 to close the last zone, empty if there are no zones
+		static std::vector<float> computeZones(float speed);
+
+		const std::vector<float>& zones(float speed);
+		bool contains(float speed) const;
+		size_t size() const;
+		void clear();
+	private:
+		typedef std::list<std::pair<float, std::vector<float>>> Entries;
+
+		size_t _capacity;
+		// most recently used first
+		Entries _entries;
+		std::unordered_map<float, Entries::iterator> _index;
+	};
+}
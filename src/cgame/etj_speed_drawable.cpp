@@ -24,6 +24,7 @@
 
 #include "etj_speed_drawable.h"
 #include "etj_utilities.h"
+#include "etj_movement_context.h"
 #include "etj_cvar_update_handler.h"
 #include "etj_client_commands_handler.h"
 #include <string>
@@ -72,7 +73,7 @@ void ETJump::DisplaySpeed::startListeners()
 
 void ETJump::DisplaySpeed::beforeRender()
 {
-	auto speed = sqrt(cg.predictedPlayerState.velocity[0] * cg.predictedPlayerState.velocity[0] + cg.predictedPlayerState.velocity[1] * cg.predictedPlayerState.velocity[1]);
+	auto speed = movementContext.speed;
 	_maxSpeed = speed > _maxSpeed ? speed : _maxSpeed;
 
 	if (etj_speedColorUsesAccel.integer)
@@ -148,19 +149,19 @@ void ETJump::DisplaySpeed::render() const
 
 std::string ETJump::DisplaySpeed::getStatus() const
 {
-	float speed = sqrt(cg.predictedPlayerState.velocity[0] * cg.predictedPlayerState.velocity[0] + cg.predictedPlayerState.velocity[1] * cg.predictedPlayerState.velocity[1]);
+	float speed = movementContext.speed;
 	switch (cg_drawSpeed2.integer)
 	{
-	case 2: return stringFormat("%.0f %.0f", speed, _maxSpeed);
-	case 3: return stringFormat("%.0f ^z%.0f", speed, _maxSpeed);
-	case 4: return stringFormat("%.0f (%.0f)", speed, _maxSpeed);
-	case 5: return stringFormat("%.0f ^z(%.0f)", speed, _maxSpeed);
-	case 6: return stringFormat("%.0f ^z[%.0f]", speed, _maxSpeed);
-	case 7: return stringFormat("%.0f | %.0f", speed, _maxSpeed);
-	case 8: return stringFormat("Speed: %.0f", speed);
+	case 2: return ETJUMP_FORMAT("%.0f %.0f", speed, _maxSpeed);
+	case 3: return ETJUMP_FORMAT("%.0f ^z%.0f", speed, _maxSpeed);
+	case 4: return ETJUMP_FORMAT("%.0f (%.0f)", speed, _maxSpeed);
+	case 5: return ETJUMP_FORMAT("%.0f ^z(%.0f)", speed, _maxSpeed);
+	case 6: return ETJUMP_FORMAT("%.0f ^z[%.0f]", speed, _maxSpeed);
+	case 7: return ETJUMP_FORMAT("%.0f | %.0f", speed, _maxSpeed);
+	case 8: return ETJUMP_FORMAT("Speed: %.0f", speed);
 	// tens
-	case 9: return stringFormat("%02i", static_cast<int>(speed) / 10 % 10 * 10);
-	default: return stringFormat("%.0f", speed);
+	case 9: return ETJUMP_FORMAT("%02i", static_cast<int>(speed) / 10 % 10 * 10);
+	default: return ETJUMP_FORMAT("%.0f", speed);
 	}
 }
 
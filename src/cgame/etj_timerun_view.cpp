@@ -23,11 +23,11 @@
  */
 
 #include <string>
-#include <boost/format.hpp>
 #include "cg_local.h"
 #include "etj_timerun_view.h"
 #include "etj_utilities.h"
 #include "etj_cvar_update_handler.h"
+#include "../game/etj_format.h"
 
 ETJump::TimerunView::TimerunView() : Drawable()
 {
@@ -156,10 +156,8 @@ void ETJump::TimerunView::draw()
 	auto seconds = millis / 1000;
 	millis -= seconds * 1000;
 
-	auto text = (boost::format("%02d:%02d.%03d")
-		% minutes
-		% seconds
-		% millis).str();
+	FormatBuffer<16> text;
+	ETJUMP_FORMAT_TO(text, "%02d:%02d.%03d", minutes, seconds, millis);
 
 	auto textWidth = CG_Text_Width_Ext(text.c_str(), 0.3, 0, &cgs.media.limboFont1) / 2;
 	auto x = player_runTimerX.value;
@@ -23,8 +23,10 @@
  */
 
 #include "etj_trickjump_lines.h"
+#include "etj_trickjump_lines_format.h"
 #include "../json/json.h"
 #include "etj_client_utilities.h"
+#include "etj_utilities.h"
 #include <sstream>
 #include <memory>
 #include <string>
@@ -34,12 +36,21 @@
 #include "cg_local.h"
 
 static const char* EnumStrings[] = { "mapper", "loaded", "recorded" };
+
+// Douglas-Peucker tolerances (in units) of each level of detail, and how many
+// pixels a simplified trail may be off on screen before a finer level is used.
+static const float lodTolerances[TrickjumpLines::NUM_LOD_LEVELS] = { 1.0f, 4.0f, 16.0f };
+static const float lodMaxScreenError = 1.0f;
+
+const int TrickjumpLines::BEZIER_DIVISIONS;
 const char* getTextForEnum(int enumVal)
 {
 	return EnumStrings[enumVal];
 }
 
-TrickjumpLines::TrickjumpLines() : _nextRecording(1), _nextAddTime(0), _currentRouteToRender(-1)
+TrickjumpLines::TrickjumpLines() : _nextRecording(1), _nextAddTime(0), _currentRouteToRender(-1),
+	_geometryVersion(0), _mapperRouteCount(0), _lineColorBySpeed(false), _lineColorModificationCount(-1),
+	_markerColorModificationCount(-1), _markerEndColorModificationCount(-1), _smoothLines(false), _smoothLinesModificationCount(-1)
 {
 	this->_recording = false;
 	this->_jumpRelease = true;
@@ -57,6 +68,61 @@ TrickjumpLines::TrickjumpLines() : _nextRecording(1), _nextAddTime(0), _currentR
 	colorMap.insert(std::pair<std::string, std::vector<unsigned char>>("cyan", { 0, 128, 128, 255 }));
 	colorMap.insert(std::pair<std::string, std::vector<unsigned char>>("orange", { 128, 128, 0, 255 }));
 	colorMap.insert(std::pair<std::string, std::vector<unsigned char>>("speed", { 0, 0, 0, 0 }));
+
+	memset(lineColor, 0, sizeof(lineColor));
+	memset(markerColor, 0, sizeof(markerColor));
+	memset(markerEndColor, 0, sizeof(markerEndColor));
+}
+
+void TrickjumpLines::resolveColor(const char *colorString, vec4_c &color)
+{
+	auto it = colorMap.find(colorString);
+	if (it != colorMap.end())
+	{
+		for (auto i = 0; i < 4; i++)
+		{
+			color[i] = it->second[i];
+		}
+		return;
+	}
+
+	// anything else that is a valid color string (0xff0000, 255 0 0 etc.)
+	::vec4_t parsed;
+	ETJump::parseColorString(colorString, parsed);
+	for (auto i = 0; i < 4; i++)
+	{
+		color[i] = static_cast<unsigned char>(parsed[i] * 255.0f);
+	}
+}
+
+void TrickjumpLines::updateColors()
+{
+	if (_lineColorModificationCount != etj_tjlLineColor.modificationCount)
+	{
+		_lineColorModificationCount = etj_tjlLineColor.modificationCount;
+		_lineColorBySpeed = !Q_stricmp(etj_tjlLineColor.string, "speed");
+		resolveColor(etj_tjlLineColor.string, lineColor);
+		++_geometryVersion;
+	}
+
+	if (_smoothLinesModificationCount != etj_tjlSmoothLine.modificationCount)
+	{
+		_smoothLinesModificationCount = etj_tjlSmoothLine.modificationCount;
+		_smoothLines = etj_tjlSmoothLine.integer != 0;
+		++_geometryVersion;
+	}
+
+	if (_markerColorModificationCount != etj_tjlMarkerColor.modificationCount)
+	{
+		_markerColorModificationCount = etj_tjlMarkerColor.modificationCount;
+		resolveColor(etj_tjlMarkerColor.string, markerColor);
+	}
+
+	if (_markerEndColorModificationCount != etj_tjlMarkerEndColor.modificationCount)
+	{
+		_markerEndColorModificationCount = etj_tjlMarkerEndColor.modificationCount;
+		resolveColor(etj_tjlMarkerEndColor.string, markerEndColor);
+	}
 }
 
 TrickjumpLines::~TrickjumpLines() {}
@@ -141,6 +207,7 @@ void TrickjumpLines::overwriteRecording(const char *name)
 		}
 	}
 
+	decodeRoute(_routes[z]);
 	Route route = _routes[z];
 	CG_Printf("Over-writing : %s\n", route.name.c_str());
 	_currentRoute = std::move(route);
@@ -222,7 +289,10 @@ void TrickjumpLines::stopRecord()
 	_currentTrail.clear();
 	_currentRoute.trails.push_back(trail);
 	_recording = false;
-	_routes.push_back(_currentRoute);
+	// an overwritten route still carries the geometry of its old trails
+	_currentRoute.geometry = RouteGeometry();
+	updateRouteBounds(_currentRoute);
+	addRoute(_currentRoute);
 
 
 	CG_Printf("Stopped recording: %s\n", _currentRoute.name.c_str());
@@ -234,430 +304,506 @@ void TrickjumpLines::stopRecord()
 
 void TrickjumpLines::displayCurrentRoute(int x)
 {
-	static int nextRotationTime = 0;
+	updateColors();
 
-	// Loop on every trail into the route.
-	const int nbTrails = _routes[x].trails.size();
+	Route& route = _routes[x];
+	decodeRoute(route);
 
-	// Get min and max speed of the current jump.
-	float minSpeed = 9999999999999;
-	float maxSpeed = 0;
+	// Loop on every trail into the route.
+	const int nbTrails = route.trails.size();
 
-	for (auto i = 0; i < nbTrails; ++i)
+	// Add the lines of every trail.
+	if (isEnableLine())
 	{
-		std::vector<Node> cTrail = _routes[x].trails[i];
-		const int nbPoints = cTrail.size();
-		for (int j = 0; j < nbPoints; ++j)
-		{
-			if (cTrail[j].speed < minSpeed)
-				minSpeed = cTrail[j].speed;
+		updateRouteGeometry(route);
+		addRouteGeometry(route);
+	}
 
-			if (cTrail[j].speed > maxSpeed)
-				maxSpeed = cTrail[j].speed;
-		}
+	// Add curve indicator.
+	if (!isEnableMarker())
+	{
+		return;
 	}
 
+	auto& colorEndMarker = markerEndColor;
+	auto& colorMarker = markerColor;
+
 	for (auto i = 0; i < nbTrails; ++i)
 	{
-		// Get current trail into tmp var.
-		std::vector<Node> cTrail = _routes[x].trails[i];
+		const std::vector<Node>& cTrail = route.trails[i];
 		const int nbPoints = cTrail.size();
 
-		// Add the bezier curve of this trail.		
-		if (isEnableLine())
+		if (nbPoints == 0)
 		{
-			//addTrickjumpRecursiveBezier(cTrail, _blue, _routes[x].width, 150);
-			const std::string tmp = etj_tjlLineColor.string;
-			if (tmp == "speed" || tmp == "Speed")
-			{
-				addTrickjumpLinesColor(cTrail, minSpeed, maxSpeed, _routes[x].width);
-			}
-			else
-			{
-				vec4_c colorLine;
-				colorLine[0] = colorMap[etj_tjlLineColor.string][0];
-				colorLine[1] = colorMap[etj_tjlLineColor.string][1];
-				colorLine[2] = colorMap[etj_tjlLineColor.string][2];
-				colorLine[3] = colorMap[etj_tjlLineColor.string][3];
-				addTrickjumpLines(cTrail, colorLine, _routes[x].width);
-			}
+			continue;
 		}
 
-		// Add curve indicator.
-		if (isEnableMarker())
+		vec3_t start, end;
+		VectorCopy(cTrail[0].coor, start);
+		VectorCopy(cTrail[nbPoints - 1].coor, end);
+
+		// check if only 1 trail.
+		if (nbTrails == 1)
 		{
-			vec3_t start, end;
-			VectorCopy(cTrail[0].coor, start);
-			VectorCopy(cTrail[nbPoints - 1].coor, end);
-
-			std::ostringstream ss;
-			ss << (cTrail[0].speed);
-			const std::string speedStr(ss.str());
-			vec4_c colorEndMarker, colorMarker;
-			colorEndMarker[0] = colorMap[etj_tjlMarkerEndColor.string][0];
-			colorEndMarker[1] = colorMap[etj_tjlMarkerEndColor.string][1];
-			colorEndMarker[2] = colorMap[etj_tjlMarkerEndColor.string][2];
-			colorEndMarker[3] = colorMap[etj_tjlMarkerEndColor.string][3];
-			colorMarker[0] = colorMap[etj_tjlMarkerColor.string][0];
-			colorMarker[1] = colorMap[etj_tjlMarkerColor.string][1];
-			colorMarker[2] = colorMap[etj_tjlMarkerColor.string][2];
-			colorMarker[3] = colorMap[etj_tjlMarkerColor.string][3];
-
-			// check if only 1 trail.
-			if (nbTrails == 1)
-			{
-				addJumpIndicator(start, colorEndMarker, 10.0);
-				addJumpIndicator(end, colorEndMarker, 10.0);
-			}
-			// Check if it is the first curve of the route.
-			else if (i == 0)
-			{
-				addJumpIndicator(start, colorEndMarker, 10.0);
-			}
-			// Check if it is the last curve of the route.
-			else if (i == _routes[x].trails.size() - 1)
-			{
-				addJumpIndicator(start, colorMarker, 10.0);
-				addJumpIndicator(end, colorEndMarker, 10.0);
-				//drawFloatingText(speedStr, start, _red, 3); // TODO: Not working yet. (Xis)
-			}
-			// If any another curve of the route.
-			else
-			{
-				addJumpIndicator(start, colorMarker, 10.0);
-				//drawFloatingText(speedStr, start, _red, 3); // TODO: Not working yet. (Xis)
-			}
+			addJumpIndicator(start, colorEndMarker, 10.0);
+			addJumpIndicator(end, colorEndMarker, 10.0);
+		}
+		// Check if it is the first curve of the route.
+		else if (i == 0)
+		{
+			addJumpIndicator(start, colorEndMarker, 10.0);
+		}
+		// Check if it is the last curve of the route.
+		else if (i == nbTrails - 1)
+		{
+			addJumpIndicator(start, colorMarker, 10.0);
+			addJumpIndicator(end, colorEndMarker, 10.0);
+			//drawFloatingText(speedStr, start, _red, 3); // TODO: Not working yet. (Xis)
+		}
+		// If any another curve of the route.
+		else
+		{
+			addJumpIndicator(start, colorMarker, 10.0);
+			//drawFloatingText(speedStr, start, _red, 3); // TODO: Not working yet. (Xis)
 		}
 	}
 }
 
-// gcd_ui, use in Binomial coefficient function.
-unsigned long TrickjumpLines::gcd_ui(unsigned long x, unsigned long y) {
-	unsigned long t;
-	if (y < x)
-	{
-		t = x;
-		x = y;
-		y = t;
-	}
-	while (y > 0)
+// Precompute the per node colors (and speed range), bounds and LOD levels of the route.
+// Only redone when the route was changed or the line color was changed.
+void TrickjumpLines::updateRouteGeometry(Route& route)
+{
+	RouteGeometry& geometry = route.geometry;
+
+	if (geometry.version == _geometryVersion)
 	{
-		t = y;
-		y = x % y;
-		x = t;  /* y1 <- x0 % y0 ; x1 <- y0 */
+		return;
 	}
-	return x;
-}
 
-// Compute the binomial coefficient base on k in n
-unsigned long TrickjumpLines::binomial(unsigned long n, unsigned long k) {
-	unsigned long d, g, r = 1;
+	geometry.version = _geometryVersion;
+	geometry.colors.clear();
+	geometry.trails.clear();
 
-	// Trivial case.
-	if (k == 0) return 1;
-	if (k == 1) return n;
-	if (k >= n) return (k == n);
-	if (k > n / 2) k = n - k;
+	// Get min and max speed of the current jump.
+	float minSpeed = 9999999999999;
+	float maxSpeed = 0;
+	size_t nbNodes = 0;
 
-	for (d = 1; d <= k; ++d)
+	for (const auto& trail : route.trails)
 	{
-		if (r >= ULONG_MAX / n) /* Possible overflow */
+		for (const auto& node : trail)
 		{
-			unsigned long nr, dr;  /* reduced numerator / denominator */
-			g = gcd_ui(n, d);  nr = n / g;  dr = d / g;
-			g = gcd_ui(r, dr);  r = r / g;  dr = dr / g;
-			if (r >= ULONG_MAX / nr) return 0;  /* Unavoidable overflow */
-			r *= nr;
-			r /= dr;
-			n--;
-		}
-		else
-		{
-			r *= n--;
-			r /= d;
+			if (node.speed < minSpeed)
+				minSpeed = node.speed;
+
+			if (node.speed > maxSpeed)
+				maxSpeed = node.speed;
 		}
+		nbNodes += trail.size();
 	}
-	return r;
-}
-
-// Draw all 4 vertices to make the quad (line) with the width and color define by user.
-void TrickjumpLines::draw4VertexLine(vec3_t start, vec3_t end, float width, vec4_c color)
-{
-	// Draw a small line between each start/end 
-	polyVert_t verts[4];
-	vec3_t up, pDraw;
-	int cIdx = 0;
 
-	// Obtain Up vector, base on player location
-	GetPerpendicularViewVector(cg.refdef_current->vieworg, start, end, up);
+	geometry.minSpeed = minSpeed;
+	geometry.maxSpeed = maxSpeed;
+	geometry.colors.reserve(nbNodes);
+	geometry.trails.resize(route.trails.size());
 
-	// 1 vertex
-	VectorMA(start, 0.5 * width, up, pDraw);
-	VectorCopy(pDraw, verts[cIdx].xyz);
-	verts[cIdx].st[0] = 0;
-	verts[cIdx].st[1] = 1.0;
+	for (size_t t = 0; t < route.trails.size(); ++t)
+	{
+		const auto& trail = route.trails[t];
+		TrailGeometry& trailGeometry = geometry.trails[t];
 
-	for (int k = 0; k < 4; ++k)
-		verts[cIdx].modulate[k] = (unsigned char)(color[k]);
+		trailGeometry.firstColor = geometry.colors.size();
+		ClearBounds(trailGeometry.mins, trailGeometry.maxs);
 
-	++cIdx;
+		for (const auto& node : trail)
+		{
+			geometry.colors.push_back(nodeColor(node.speed, minSpeed, maxSpeed));
+			AddPointToBounds(node.coor, trailGeometry.mins, trailGeometry.maxs);
+		}
 
-	// 2 vertex
-	VectorMA(pDraw, -1.0 * width, up, pDraw);
-	VectorCopy(pDraw, verts[cIdx].xyz);
-	verts[cIdx].st[0] = 0;
-	verts[cIdx].st[1] = 0;
+		if (trail.empty())
+		{
+			VectorClear(trailGeometry.mins);
+			VectorClear(trailGeometry.maxs);
+		}
 
-	for (int k = 0; k < 4; ++k)
-		verts[cIdx].modulate[k] = (unsigned char)(color[k]);
+		VectorAdd(trailGeometry.mins, trailGeometry.maxs, trailGeometry.center);
+		VectorScale(trailGeometry.center, 0.5, trailGeometry.center);
+		trailGeometry.radius = euclideanDist(trailGeometry.center, trailGeometry.maxs);
 
-	++cIdx;
+		for (int l = 0; l < NUM_LOD_LEVELS; ++l)
+		{
+			simplifyTrail(trail, lodTolerances[l], trailGeometry.lods[l]);
+		}
 
-	// 3 vertex
-	VectorMA(end, -0.5 * width, up, pDraw);
-	VectorCopy(pDraw, verts[cIdx].xyz);
-	verts[cIdx].st[0] = 1.0;
-	verts[cIdx].st[1] = 0.0;
+		trailGeometry.curve.clear();
+		trailGeometry.curveColors.clear();
+		if (_smoothLines)
+		{
+			buildBezierCurve(trail, trailGeometry.curve);
+			for (const auto& node : trailGeometry.curve)
+			{
+				trailGeometry.curveColors.push_back(nodeColor(node.speed, minSpeed, maxSpeed));
+			}
+		}
+	}
+}
 
-	for (int k = 0; k < 4; ++k)
-		verts[cIdx].modulate[k] = (unsigned char)(color[k]);
+// Douglas-Peucker simplification, keeps the indices of the nodes that are
+// needed so that no dropped node is further than tolerance from the line.
+void TrickjumpLines::simplifyTrail(const std::vector< Node >& points, float tolerance, std::vector<int>& indices)
+{
+	const int n = points.size();
 
-	++cIdx;
-	// 4 vertex
-	VectorMA(pDraw, width, up, pDraw);
-	VectorCopy(pDraw, verts[cIdx].xyz);
-	verts[cIdx].st[0] = 1.0;
-	verts[cIdx].st[1] = 1.0;
+	indices.clear();
 
-	for (int k = 0; k < 4; ++k)
-		verts[cIdx].modulate[k] = (unsigned char)(color[k]);
+	if (n < 3)
+	{
+		for (int i = 0; i < n; ++i)
+			indices.push_back(i);
+		return;
+	}
 
-	// Add vertices to scene as quad.
-	trap_R_AddPolyToScene(cgs.media.railCoreShader, 4, verts);
+	std::vector<bool> keep(n, false);
+	std::vector<std::pair<int, int>> stack;
 
-	return;
-}
+	keep[0] = keep[n - 1] = true;
+	stack.push_back(std::make_pair(0, n - 1));
 
-void TrickjumpLines::draw4VertexLine2Color(vec3_t start, vec3_t end, float width, vec4_c colorStart, vec4_c colorEnd)
-{
-	// Draw a small line between each start/end 
-	polyVert_t verts[4];
-	vec3_t up, pDraw;
-	int cIdx = 0;
+	while (!stack.empty())
+	{
+		const int first = stack.back().first;
+		const int last = stack.back().second;
+		stack.pop_back();
 
-	// Obtain Up vector, base on player location
-	GetPerpendicularViewVector(cg.refdef_current->vieworg, start, end, up);
+		vec3_t dir;
+		VectorSubtract(points[last].coor, points[first].coor, dir);
+		const float lengthSquared = DotProduct(dir, dir);
 
-	// 1 vertex
-	VectorMA(start, 0.5 * width, up, pDraw);
-	VectorCopy(pDraw, verts[cIdx].xyz);
-	verts[cIdx].st[0] = 0;
-	verts[cIdx].st[1] = 1.0;
+		float maxDist = 0;
+		int farthest = -1;
 
-	for (int k = 0; k < 4; ++k)
-		verts[cIdx].modulate[k] = (unsigned char)(colorStart[k]);
+		for (int i = first + 1; i < last; ++i)
+		{
+			// distance to the segment between first and last
+			vec3_t toPoint, closest;
+			VectorSubtract(points[i].coor, points[first].coor, toPoint);
 
-	++cIdx;
+			float frac = lengthSquared > 0 ? DotProduct(toPoint, dir) / lengthSquared : 0;
+			frac = Com_Clamp(0, 1, frac);
+			VectorMA(points[first].coor, frac, dir, closest);
 
-	// 2 vertex
-	VectorMA(pDraw, -1.0 * width, up, pDraw);
-	VectorCopy(pDraw, verts[cIdx].xyz);
-	verts[cIdx].st[0] = 0;
-	verts[cIdx].st[1] = 0;
+			const float dist = euclideanDist(points[i].coor, closest);
+			if (dist > maxDist)
+			{
+				maxDist = dist;
+				farthest = i;
+			}
+		}
 
-	for (int k = 0; k < 4; ++k)
-		verts[cIdx].modulate[k] = (unsigned char)(colorStart[k]);
+		if (farthest != -1 && maxDist > tolerance)
+		{
+			keep[farthest] = true;
+			stack.push_back(std::make_pair(first, farthest));
+			stack.push_back(std::make_pair(farthest, last));
+		}
+	}
 
-	++cIdx;
+	for (int i = 0; i < n; ++i)
+	{
+		if (keep[i])
+			indices.push_back(i);
+	}
+}
 
-	// 3 vertex
-	VectorMA(end, -0.5 * width, up, pDraw);
-	VectorCopy(pDraw, verts[cIdx].xyz);
-	verts[cIdx].st[0] = 1.0;
-	verts[cIdx].st[1] = 0.0;
+// Picks the coarsest level whose tolerance still projects to less than
+// lodMaxScreenError pixels at the nearest point of the trail bounds.
+// Returns -1 for full detail.
+int TrickjumpLines::selectTrailLod(const TrailGeometry& trail, float width)
+{
+	const float *viewOrg = cg.refdef_current->vieworg;
+	float distSquared = 0;
 
-	for (int k = 0; k < 4; ++k)
-		verts[cIdx].modulate[k] = (unsigned char)(colorEnd[k]);
+	for (int i = 0; i < 3; ++i)
+	{
+		float d = 0;
+		if (viewOrg[i] < trail.mins[i])
+			d = trail.mins[i] - viewOrg[i];
+		else if (viewOrg[i] > trail.maxs[i])
+			d = viewOrg[i] - trail.maxs[i];
+		distSquared += d * d;
+	}
 
-	++cIdx;
-	// 4 vertex
-	VectorMA(pDraw, width, up, pDraw);
-	VectorCopy(pDraw, verts[cIdx].xyz);
-	verts[cIdx].st[0] = 1.0;
-	verts[cIdx].st[1] = 1.0;
+	const float dist = std::sqrt(distSquared) - width;
+	if (dist <= 0)
+	{
+		return -1;
+	}
 
-	for (int k = 0; k < 4; ++k)
-		verts[cIdx].modulate[k] = (unsigned char)(colorEnd[k]);
+	// pixels per world unit at distance 1
+	const float projection = cg.refdef_current->width / (2 * tan(DEG2RAD(cg.refdef_current->fov_x) * 0.5f));
 
-	// Add vertices to scene as quad.
-	trap_R_AddPolyToScene(cgs.media.railCoreShader, 4, verts);
+	for (int l = NUM_LOD_LEVELS - 1; l >= 0; --l)
+	{
+		if (lodTolerances[l] * projection / dist <= lodMaxScreenError)
+		{
+			return l;
+		}
+	}
 
-	return;
+	return -1;
 }
 
-// Compute the bezier's curves base on recursive function (so N-degree). 
-// The function is able to draw the line between start and end point, plus any number of controls points between them.
-// Just by passing an array of vec3_t where points[0] = start and points[end] = end.
-// Color is an array of size 4, which contain, rgb-a color.
-// Width is the width for the line and nbDivision is the number of division process during bezier curves
-// Less divison = more straight line and more division = better curve (longer processing)
-void TrickjumpLines::addTrickjumpRecursiveBezier(std::vector< Node > points, vec4_c color, float width, int nbDivision)
+// Adds a camera facing quad for every segment of the route through the poly buffers.
+// The view direction of each node is shared by the two segments around it,
+// which gives the same up vector as GetPerpendicularViewVector.
+void TrickjumpLines::addRouteGeometry(const Route& route)
 {
 	static int nextPrintTime = 0;
-	vec3_t zeros = { 0.0, 0.0, 0.0 };
-	const int n = points.size();
+	const float width = route.width;
+	const float *viewOrg = cg.refdef_current->vieworg;
+	polyBuffer_t *pPolyBuffer = nullptr;
 
-	if (n < 2)
+	for (size_t t = 0; t < route.trails.size(); ++t)
 	{
-		if (nextPrintTime < cg.time)
+		const auto& trail = route.trails[t];
+		const TrailGeometry& trailGeometry = route.geometry.trails[t];
+		const auto *colors = route.geometry.colors.data() + trailGeometry.firstColor;
+
+		if (trail.size() < 2)
 		{
-			if (isDebug())
+			if (nextPrintTime < cg.time)
 			{
-				CG_Printf("Exit Bezier drawing, not enought points. \n");
+				if (isDebug())
+				{
+					CG_Printf("Exit line drawing, not enought points. \n");
+				}
+				nextPrintTime = cg.time + 1000;
 			}
-			nextPrintTime = cg.time + 1000;
+			continue;
 		}
-		return;
-	}
 
-	if (n > nbDivision)
-	{
-		nbDivision = n;
-	}
+		if (CG_CullPointAndRadius(trailGeometry.center, trailGeometry.radius + width))
+		{
+			continue;
+		}
 
-	// Hold previous point on each iter (start)
-	vec3_t prev;
-	VectorCopy(points[0].coor, prev);
+		const Node *nodes = trail.data();
+		const int *indices = nullptr;
+		int n = trail.size();
 
-	// Divide bezier line into nbDivision points
-	for (int i = 0; i < nbDivision; ++i)
-	{
-		// Compute bezier cubic equation values.
-		const float t = i / (float)nbDivision;
-		const float u = 1 - t;
+		if (_smoothLines)
+		{
+			// the curve lies inside the bounds of its control points, so the culling above still holds
+			nodes = trailGeometry.curve.data();
+			colors = trailGeometry.curveColors.data();
+			n = trailGeometry.curve.size();
+		}
+		else
+		{
+			// full detail walks the trail itself, otherwise the simplified indices
+			const int lod = selectTrailLod(trailGeometry, width);
+			if (lod >= 0)
+			{
+				indices = trailGeometry.lods[lod].data();
+				n = trailGeometry.lods[lod].size();
+			}
+		}
 
-		// Computed points variable
-		vec3_t p, finalp, tmp;
+		_viewDirs.resize(n);
+		for (int i = 0; i < n; ++i)
+		{
+			const int node = indices ? indices[i] : i;
+			VectorSubtract(viewOrg, nodes[node].coor, _viewDirs[i].data());
+			VectorNormalize(_viewDirs[i].data());
+		}
+
+		for (int i = 0; i < n - 1; ++i)
+		{
+			const int startNode = indices ? indices[i] : i;
+			const int endNode = indices ? indices[i + 1] : i + 1;
+			vec3_t up, xyz[4];
+			CrossProduct(_viewDirs[i].data(), _viewDirs[i + 1].data(), up);
+			VectorNormalize(up);
 
-		// To get a full line base on start/end plus X control points for a total of N = X + 2 points.
-		// https://en.wikipedia.org/wiki/B%C3%A9zier_curve see Explicit definition of Recursive definition
-		// Compute the recursive equation into point p.
+			VectorMA(nodes[startNode].coor, 0.5 * width, up, xyz[0]);
+			VectorMA(xyz[0], -1.0 * width, up, xyz[1]);
+			VectorMA(nodes[endNode].coor, -0.5 * width, up, xyz[2]);
+			VectorMA(xyz[2], width, up, xyz[3]);
 
-		// Do equation on P0 (start)
-		VectorMA(zeros, pow(u, n), points[0].coor, p);
+			const vec_c *c[4] = { colors[startNode].data(), colors[startNode].data(), colors[endNode].data(), colors[endNode].data() };
+			const float st[4][2] = { { 0, 1.0 }, { 0, 0 }, { 1.0, 0 }, { 1.0, 1.0 } };
 
-		// Do equation on P1 to Pn-1 (Control points).
-		for (int l = 1; l < n; ++l)
-		{
-			VectorMA(zeros, binomial(n, l) * pow(u, n - l) * pow(t, l), points[l].coor, tmp);
-			VectorAdd(p, tmp, p);
-		}
+			if (!pPolyBuffer || pPolyBuffer->numVerts + 4 >= MAX_PB_VERTS || pPolyBuffer->numIndicies + 6 >= MAX_PB_INDICIES)
+			{
+				pPolyBuffer = CG_PB_FindFreePolyBuffer(cgs.media.railCoreShader, 4, 6);
+			}
+
+			if (!pPolyBuffer)
+			{
+				// out of poly buffers, add the quad on its own
+				polyVert_t verts[4];
+				for (int v = 0; v < 4; ++v)
+				{
+					VectorCopy(xyz[v], verts[v].xyz);
+					verts[v].st[0] = st[v][0];
+					verts[v].st[1] = st[v][1];
+					for (int k = 0; k < 4; ++k)
+						verts[v].modulate[k] = c[v][k];
+				}
+				trap_R_AddPolyToScene(cgs.media.railCoreShader, 4, verts);
+				continue;
+			}
 
-		// Do equation on Pn (end) into finalp
-		VectorMA(zeros, pow(t, n), points[n - 1].coor, tmp);
-		VectorAdd(p, tmp, finalp);
+			const int pos = pPolyBuffer->numVerts;
+			for (int v = 0; v < 4; ++v)
+			{
+				VectorCopy(xyz[v], pPolyBuffer->xyz[pos + v]);
+				pPolyBuffer->st[pos + v][0] = st[v][0];
+				pPolyBuffer->st[pos + v][1] = st[v][1];
+				for (int k = 0; k < 4; ++k)
+					pPolyBuffer->color[pos + v][k] = c[v][k];
+			}
 
-		// Draw line between previous and finalp with trap_R_AddPolyToScene.
-		draw4VertexLine(prev, finalp, width, color);
+			int *indicies = pPolyBuffer->indicies + pPolyBuffer->numIndicies;
+			indicies[0] = pos;
+			indicies[1] = pos + 1;
+			indicies[2] = pos + 2;
+			indicies[3] = pos + 2;
+			indicies[4] = pos + 3;
+			indicies[5] = pos;
 
-		// Copy current point into prev for next iteration.
-		VectorCopy(finalp, prev);
+			pPolyBuffer->numVerts    += 4;
+			pPolyBuffer->numIndicies += 6;
+		}
 	}
-	return;
 }
 
-void TrickjumpLines::addTrickjumpLines(std::vector< Node > points, vec4_c color, float width)
+std::array<TrickjumpLines::vec_c, 4> TrickjumpLines::nodeColor(float speed, float minSpeed, float maxSpeed)
 {
-	static int nextPrintTime = 0;
-	const int n = points.size();
+	std::array<vec_c, 4> c;
 
-	if (n < 2)
+	if (_lineColorBySpeed)
 	{
-		if (nextPrintTime < cg.time)
-		{
-			nextPrintTime = cg.time + 1000;
-		}
-		return;
+		// Obtain color base on speed.
+		vec3_t color;
+		computeColorForNode(maxSpeed, minSpeed, speed, color);
+		c[0] = static_cast<unsigned char>(color[0]);
+		c[1] = static_cast<unsigned char>(color[1]);
+		c[2] = static_cast<unsigned char>(color[2]);
+		c[3] = static_cast<unsigned char>(255);
 	}
+	else
+	{
+		for (int k = 0; k < 4; ++k)
+			c[k] = lineColor[k];
+	}
+
+	return c;
+}
 
-	for (int i = 0; i < n - 1; ++i)
+// Bernstein basis of the given degree sampled at t = i / divisions for i = 0..divisions,
+// (divisions + 1) rows of (degree + 1) weights. Built with the de Casteljau recurrence
+// so there are no pow() or binomial coefficients involved, and cached per degree and divisions.
+const std::vector<double>& TrickjumpLines::bernsteinWeights(int degree, int divisions)
+{
+	const auto key = std::make_pair(degree, divisions);
+	auto it = _bernsteinWeights.find(key);
+	if (it != _bernsteinWeights.end())
+	{
+		return it->second;
+	}
+
+	std::vector<double> weights((divisions + 1) * (degree + 1));
+
+	for (int i = 0; i <= divisions; ++i)
 	{
-		vec3_t s, e;
-		VectorCopy(points[i].coor, s);
-		VectorCopy(points[i + 1].coor, e);
+		const double t = i / static_cast<double>(divisions);
+		const double u = 1 - t;
+		double *row = &weights[i * (degree + 1)];
 
-		// Draw line between previous and finalp with trap_R_AddPolyToScene.
-		draw4VertexLine(s, e, width, color);
+		row[0] = 1;
+		for (int k = 1; k <= degree; ++k)
+		{
+			row[k] = t * row[k - 1];
+			for (int l = k - 1; l > 0; --l)
+			{
+				row[l] = u * row[l] + t * row[l - 1];
+			}
+			row[0] *= u;
+		}
 	}
 
-	return;
+	return _bernsteinWeights.emplace(key, std::move(weights)).first->second;
 }
 
-void TrickjumpLines::addTrickjumpLinesColor(std::vector< Node > points, float minSpeed, float maxSpeed, float width)
+// Compute the bezier curve through the trail, the first and last node are the ends
+// and the nodes between them the control points. Long trails are split into pieces of
+// at most MAX_BEZIER_DEGREE + 1 nodes sharing their end points, a single curve of that
+// degree would just be the average of the trail.
+// Less divison = more straight line and more division = better curve.
+void TrickjumpLines::buildBezierCurve(const std::vector< Node >& points, std::vector< Node >& curve)
 {
-	static int nextPrintTime = 0;
 	const int n = points.size();
 
+	curve.clear();
+
 	if (n < 2)
 	{
-		if (nextPrintTime < cg.time)
+		if (isDebug())
 		{
-			if (isDebug())
-			{
-				CG_Printf("Exit line drawing, not enought points. \n");
-			}
-			nextPrintTime = cg.time + 1000;
+			CG_Printf("Exit Bezier drawing, not enought points. \n");
 		}
 		return;
 	}
 
-	for (int i = 0; i < n - 1; ++i)
-	{
-		vec3_t s, e;
-		VectorCopy(points[i].coor, s);
-		VectorCopy(points[i + 1].coor, e);
+	const int totalDivisions = std::max(BEZIER_DIVISIONS, n);
+	const int nbPieces = (n - 2) / MAX_BEZIER_DEGREE + 1;
 
-		// Obtain color base on speed.
-		vec3_t color1, color2;
-		computeColorForNode(maxSpeed, minSpeed, points[i].speed, color1);
-		computeColorForNode(maxSpeed, minSpeed, points[i + 1].speed, color2);
+	curve.push_back(points[0]);
 
-		vec4_c c1, c2;
-		c1[0] = static_cast<unsigned char>(color1[0]);
-		c1[1] = static_cast<unsigned char>(color1[1]);
-		c1[2] = static_cast<unsigned char>(color1[2]);
-		c1[3] = static_cast<unsigned char>(255);
+	for (int piece = 0; piece < nbPieces; ++piece)
+	{
+		const int first = piece * (n - 1) / nbPieces;
+		const int last = (piece + 1) * (n - 1) / nbPieces;
+		const int degree = last - first;
+		const int divisions = std::max(1, totalDivisions * degree / (n - 1));
+		const auto& weights = bernsteinWeights(degree, divisions);
+
+		// first sample of every piece is the end of the previous one
+		for (int i = 1; i <= divisions; ++i)
+		{
+			const double *row = &weights[i * (degree + 1)];
+			double p[4] = { 0, 0, 0, 0 };
 
-		c2[0] = static_cast<unsigned char>(color2[0]);
-		c2[1] = static_cast<unsigned char>(color2[1]);
-		c2[2] = static_cast<unsigned char>(color2[2]);
-		c2[3] = static_cast<unsigned char>(255);
+			for (int l = 0; l <= degree; ++l)
+			{
+				const Node& control = points[first + l];
+				p[0] += row[l] * control.coor[0];
+				p[1] += row[l] * control.coor[1];
+				p[2] += row[l] * control.coor[2];
+				p[3] += row[l] * control.speed;
+			}
 
-		// Draw line between previous and finalp with trap_R_AddPolyToScene.
-		draw4VertexLine2Color(s, e, width, c1, c2);
+			Node node;
+			node.coor[0] = static_cast<float>(p[0]);
+			node.coor[1] = static_cast<float>(p[1]);
+			node.coor[2] = static_cast<float>(p[2]);
+			node.speed = static_cast<float>(p[3]);
+			curve.push_back(node);
+		}
 	}
-
 }
 
 bool TrickjumpLines::loadedRoutes(const char *loadname)
 {
-	for (auto&route : _routes)
+	if (loadname == nullptr)
 	{
-		if (loadname == nullptr)
-		{
-			CG_Printf("You request to load mapper TJL.\n");
-			if (route.status == routeStatus::map)
-				return true;
-		}
-		else
-		{
-			std::string tmp = loadname;
-			if (route.filename == tmp)
-				return true;
-		}
+		CG_Printf("You request to load mapper TJL.\n");
+		return _mapperRouteCount > 0;
 	}
 
-	return false;
+	return _routeCountByFile.count(loadname) > 0;
 }
 
 void TrickjumpLines::loadRoutes(const char *loadname)
@@ -679,35 +825,53 @@ void TrickjumpLines::loadRoutes(const char *loadname)
 		loadStatus = routeStatus::map;
 		//CG_Printf("Will load mapper TJL for map : %s.\n", cgs.rawmapname);
 	}
-	else if (loadname != nullptr)
+	else
 	{
 		map = (std::string("tjllines/") + cgs.rawmapname + std::string("/") + loadname + std::string(".tjl"));
 		loadStatus = routeStatus::load;
-
-		if (trap_FS_FOpenFile(map.c_str(), &f, FS_READ) > 0)
-		{
-			//CG_Printf("Will load local TJL file : %s.\n", loadname);
-		}
 	}
 
 	const int len = trap_FS_FOpenFile(map.c_str(), &f, FS_READ);
 	if (len <= 0)
 	{
 		//CG_Printf("File not found : %s.\n", map.c_str());
+		if (f)
+		{
+			trap_FS_FCloseFile(f);
+		}
 		return;
 	}
 
-	std::shared_ptr<char> buf(new char[len + 1], [](char *p) { delete[] p; });
-	trap_FS_Read(buf.get(), len, f);
-	buf.get()[len] = 0;
+	// Peek at the header to tell binary files from json ones.
+	std::vector<unsigned char> headerData(std::min(len, static_cast<int>(ETJump::TrickjumpLinesFormat::HeaderSize)));
+	trap_FS_Read(headerData.data(), headerData.size(), f);
 
-	std::string json(buf.get());
+	if (ETJump::TrickjumpLinesFormat::isBinary(headerData.data(), headerData.size()))
+	{
+		loadBinaryRoutes(f, len, headerData, map, loadname, loadStatus);
+	}
+	else
+	{
+		std::string json(headerData.begin(), headerData.end());
+		json.resize(len);
+		if (len > static_cast<int>(headerData.size()))
+		{
+			trap_FS_Read(&json[headerData.size()], len - headerData.size(), f);
+		}
+		loadJsonRoutes(json, map, loadname, loadStatus);
+	}
+
+	trap_FS_FCloseFile(f);
+}
+
+void TrickjumpLines::loadJsonRoutes(const std::string& json, const std::string& path, const char *loadname, routeStatus loadStatus)
+{
 	Json::Value root;
 	Json::Reader reader;
 
 	if (!reader.parse(json, root))
 	{
-		CG_Printf("Json parser error in file: %s\n", map.c_str());
+		CG_Printf("Json parser error in file: %s\n", path.c_str());
 		return;
 	}
 
@@ -753,33 +917,179 @@ void TrickjumpLines::loadRoutes(const char *loadname)
 				routeVec.push_back(trailVec); // Add trail to route.
 			}
 			loadRoute.trails = routeVec;
-			_routes.push_back(loadRoute); // Add route to object
+			updateRouteBounds(loadRoute);
+			addRoute(std::move(loadRoute)); // Add route to object
 		}
 	}
 	catch (...)
 	{
-		CG_Printf("There was a read error in %s parser\n", map.c_str());
+		CG_Printf("There was a read error in %s parser\n", path.c_str());
 		return;
 	}
-	return;
 }
 
-void TrickjumpLines::saveRoutes(const char *savename)
+// Reads the route index and keeps the trails of every route encoded,
+// they are decoded by decodeRoute once the route is needed.
+void TrickjumpLines::loadBinaryRoutes(int f, int len, const std::vector<unsigned char>& headerData, const std::string& path, const char *loadname, routeStatus loadStatus)
+{
+	ETJump::TrickjumpLinesFormat::Header header;
+	std::string error;
+
+	if (!ETJump::TrickjumpLinesFormat::readHeader(headerData.data(), headerData.size(), header, error))
+	{
+		CG_Printf("Failed to load %s: %s\n", path.c_str(), error.c_str());
+		return;
+	}
+
+	auto remaining = static_cast<uint32_t>(len - headerData.size());
+	if (header.indexSize > remaining)
+	{
+		CG_Printf("Failed to load %s: truncated route index\n", path.c_str());
+		return;
+	}
+
+	std::vector<unsigned char> indexData(header.indexSize);
+	trap_FS_Read(indexData.data(), indexData.size(), f);
+	remaining -= header.indexSize;
+
+	std::vector<Route> routes;
+	std::vector<uint32_t> dataSizes;
+	if (!ETJump::TrickjumpLinesFormat::readIndex(header, indexData.data(), indexData.size(), routes, dataSizes, error))
+	{
+		CG_Printf("Failed to load %s: %s\n", path.c_str(), error.c_str());
+		return;
+	}
+
+	for (size_t i = 0; i < routes.size(); ++i)
+	{
+		if (dataSizes[i] > remaining)
+		{
+			CG_Printf("Failed to load %s: truncated route %s\n", path.c_str(), routes[i].name.c_str());
+			return;
+		}
+
+		Route& route = routes[i];
+		route.encodedTrails.resize(dataSizes[i]);
+		trap_FS_Read(route.encodedTrails.data(), route.encodedTrails.size(), f);
+		remaining -= dataSizes[i];
+
+		if (loadname != nullptr)
+		{
+			route.filename = loadname;
+		}
+		route.status = loadStatus;
+		addRoute(std::move(route));
+	}
+}
+
+bool TrickjumpLines::decodeRoute(Route& route)
 {
+	if (route.encodedTrails.empty())
+	{
+		return true;
+	}
+
+	std::vector<unsigned char> encoded;
+	encoded.swap(route.encodedTrails);
+	route.geometry = RouteGeometry();
+
+	if (!ETJump::TrickjumpLinesFormat::readTrails(encoded.data(), encoded.size(), route.trails))
+	{
+		CG_Printf("Route %s is corrupted and can't be displayed.\n", route.name.c_str());
+		route.trails.clear();
+		return false;
+	}
+
+	return true;
+}
+
+void TrickjumpLines::updateRouteBounds(Route& route)
+{
+	VectorClear(route.start);
+	VectorClear(route.end);
+	ClearBounds(route.mins, route.maxs);
+
+	bool first = true;
+	for (const auto& trail : route.trails)
+	{
+		for (const auto& node : trail)
+		{
+			if (first)
+			{
+				VectorCopy(node.coor, route.start);
+				first = false;
+			}
+			VectorCopy(node.coor, route.end);
+			AddPointToBounds(node.coor, route.mins, route.maxs);
+		}
+	}
+
+	if (first)
+	{
+		VectorClear(route.mins);
+		VectorClear(route.maxs);
+	}
+}
+
+bool TrickjumpLines::openRouteFile(const char *savename, int& f)
+{
+	const std::string path = std::string("tjllines/") + cgs.rawmapname + std::string("/") + savename + std::string(".tjl");
+
 	// TODO (xis) : if file name already exist, overwrite?
-	fileHandle_t f = 0;
-	if (trap_FS_FOpenFile((std::string("tjllines/") + cgs.rawmapname + std::string("/") + savename + std::string(".tjl")).c_str(), &f, FS_READ) > 0)
+	f = 0;
+	if (trap_FS_FOpenFile(path.c_str(), &f, FS_READ) > 0)
 	{
+		trap_FS_FCloseFile(f);
 		CG_Printf("This file already exists, cannot save.\n");
+		return false;
+	}
+	if (f)
+	{
+		trap_FS_FCloseFile(f);
+	}
+
+	if (trap_FS_FOpenFile(path.c_str(), &f, FS_WRITE) < 0)
+	{
+		CG_Printf("Couldn't open %s for saving tjlines.\n", path.c_str());
+		return false;
+	}
+
+	return true;
+}
+
+void TrickjumpLines::saveRoutes(const char *savename)
+{
+	std::vector<const Route *> routes;
+	for (auto&route : _routes)
+	{
+		if (route.status == routeStatus::record)
+		{
+			decodeRoute(route);
+			routes.push_back(&route);
+		}
+	}
+
+	fileHandle_t f = 0;
+	if (!openRouteFile(savename, f))
+	{
 		return;
 	}
 
+	const auto data = ETJump::TrickjumpLinesFormat::write(routes);
+	trap_FS_Write(data.data(), data.size(), f);
+	trap_FS_FCloseFile(f);
+}
+
+void TrickjumpLines::exportRoutes(const char *savename)
+{
 	Json::Value root = Json::arrayValue;
 	for (auto&route : _routes)
 	{
 		//if (route.status == routeStatus::record || route.status == routeStatus::load)
 		if (route.status == routeStatus::record)
 		{
+			decodeRoute(route);
+
 			Json::Value jsonRoute;
 			jsonRoute["name"] = route.name;
 			// TODO: based on a cvar or something? No magic values, yay! (See trickjumplines::recording for frame information)
@@ -811,17 +1121,16 @@ void TrickjumpLines::saveRoutes(const char *savename)
 		}
 	}
 
-	if (trap_FS_FOpenFile((std::string("tjllines/") + cgs.rawmapname + std::string("/") + savename + std::string(".tjl")).c_str(), &f, FS_WRITE) < 0)
+	fileHandle_t f = 0;
+	if (!openRouteFile(savename, f))
 	{
-		throw "ERROR: couldn't open file for saving tjlines";
+		return;
 	}
 
 	auto writer = Json::FastWriter();
-	std::stringstream ss;
 	auto str = writer.write(root);
 	trap_FS_Write(str.c_str(), str.length(), f);
 	trap_FS_FCloseFile(f);
-	f = 0;
 }
 
 // This is a top face with sparkParticleShader
@@ -891,7 +1200,7 @@ void TrickjumpLines::listRoutes()
 
 	// Display name of the route with the associate status.
 	int id = 0;
-	for (auto route : _routes)
+	for (const auto& route : _routes)
 	{
 		if (route.status == routeStatus::map)
 		{
@@ -947,54 +1256,78 @@ void TrickjumpLines::displayNearestRoutes()
 	vec3_t p;
 	VectorCopy(cg.predictedPlayerState.origin, p);
 
-	std::vector<Route> routeCopy = _routes;
-
-	// Sort the _routes with a lambda function that taking p (position of player) as search param
-	// Check if player is near by a start point of a route.
-	std::sort(begin(routeCopy), end(routeCopy),
-		[&](const Route& lhs, const Route& rhs) { return euclideanDist(p, lhs.trails[0][0].coor) < euclideanDist(p, rhs.trails[0][0].coor); });
-
-	Route nearestStart = routeCopy[0];
+	// Check if player is near by a start or end point of a route.
+	bool isEnd = false;
+	const int z = findNearestRoutePoint(p, isEnd);
+	if (z < 0)
+	{
+		return;
+	}
 
-	// Check if player is near by a end point of a route.
-	std::sort(begin(routeCopy), end(routeCopy),
-		[&](const Route& lhs, const Route& rhs) {
+	return displayByName(routeDisplayName(_routes[z]).c_str()); // Display the route by its name.
+}
 
-		const int endLTrail = lhs.trails.size() - 1;
-		const int endLNode = lhs.trails[endLTrail].size() - 1;
-		const int endRTrail = rhs.trails.size() - 1;
-		const int endRNode = rhs.trails[endRTrail].size() - 1;
+// Walks the grid in growing square rings around the point. A ring r cells away
+// can't contain anything closer than (r - 1) cells, so the search stops once the
+// closest point found so far is nearer than that.
+int TrickjumpLines::findNearestRoutePoint(const vec3_t point, bool& isEnd) const
+{
+	if (_routeGrid.empty())
+	{
+		return -1;
+	}
 
-		return euclideanDist(p, lhs.trails[endLTrail][endLNode].coor) < euclideanDist(p, rhs.trails[endRTrail][endRNode].coor);
-	});
+	const int cellX = static_cast<int>(std::floor(point[0] / ROUTE_GRID_CELL_SIZE));
+	const int cellY = static_cast<int>(std::floor(point[1] / ROUTE_GRID_CELL_SIZE));
+	const int maxRing = std::max(
+		std::max(std::abs(cellX - _routeGridMins[0]), std::abs(cellX - _routeGridMaxs[0])),
+		std::max(std::abs(cellY - _routeGridMins[1]), std::abs(cellY - _routeGridMaxs[1])));
 
-	Route nearestEnd = routeCopy[0];
-	const int endTrail = nearestEnd.trails.size() - 1;
-	const int endNode = nearestEnd.trails[endTrail].size() - 1;
+	int best = -1;
+	float bestDist = 0;
 
-	// Check if nearest start route is nearest compare to the nearest end route.
-	if (euclideanDist(p, nearestStart.trails[0][0].coor) < euclideanDist(p, nearestEnd.trails[endTrail][endNode].coor))
+	for (int ring = 0; ring <= maxRing; ++ring)
 	{
-		if (nearestStart.status == routeStatus::map)
+		if (best >= 0 && (ring - 1) * ROUTE_GRID_CELL_SIZE > bestDist)
 		{
-			return displayByName(nearestStart.name.c_str()); // Display the route by its name.
+			break;
 		}
-		else
+
+		for (int x = cellX - ring; x <= cellX + ring; ++x)
 		{
-			return displayByName((nearestStart.filename + std::string("_") + nearestStart.name).c_str()); // Display the route by its name.
+			// only the border of the ring, the inside was already searched
+			const int step = (x == cellX - ring || x == cellX + ring) ? 1 : 2 * ring;
+			for (int y = cellY - ring; y <= cellY + ring; y += std::max(step, 1))
+			{
+				const auto it = _routeGrid.find(routeGridCell(x, y));
+				if (it == _routeGrid.end())
+				{
+					continue;
+				}
+
+				for (const auto entry : it->second)
+				{
+					const Route& route = _routes[entry / 2];
+					const float dist = euclideanDist(point, entry & 1 ? route.end : route.start);
+
+					// ties go to the earlier route, and to its start over its end
+					if (best < 0 || dist < bestDist || (dist == bestDist && entry < best))
+					{
+						best = entry;
+						bestDist = dist;
+					}
+				}
+			}
 		}
 	}
-	else
+
+	if (best < 0)
 	{
-		if (nearestEnd.status == routeStatus::map)
-		{
-			return displayByName(nearestEnd.name.c_str()); // Display the route by its name.
-		}
-		else
-		{
-			return displayByName((nearestEnd.filename + std::string("_") + nearestStart.name).c_str()); // Display the route by its name.
-		}
+		return -1;
 	}
+
+	isEnd = (best & 1) != 0;
+	return best / 2;
 }
 
 void TrickjumpLines::renameRoute(const char *oldName, const char *newName)
@@ -1033,6 +1366,7 @@ void TrickjumpLines::renameRoute(const char *oldName, const char *newName)
 
 		// Change name of the route.
 		_routes[z].name = tmp2;
+		rebuildRouteIndex();
 		CG_Printf("Route has been correctly rename to %s. \n", newName);
 		return;
 	}
@@ -1142,30 +1476,90 @@ int TrickjumpLines::getRoutePositionByName(const char *name)
 		return 0;
 	}
 
-	// Search in _routes.
-	for (int z = 0; z < _routes.size(); ++z)
+	const auto it = _routePositionByName.find(tmp);
+	if (it != _routePositionByName.end())
 	{
-		if (_routes[z].status == routeStatus::map)
+		return it->second;
+	}
+
+	if (isDebug())
+	{
+		CG_Printf("No route with name : %s has been found. \n", name);
+	}
+
+	return -1;
+}
+
+std::string TrickjumpLines::routeDisplayName(const Route& route) const
+{
+	if (route.status == routeStatus::map)
+	{
+		return route.name;
+	}
+
+	return route.filename + std::string("_") + route.name;
+}
+
+void TrickjumpLines::addRoute(Route route)
+{
+	_routes.push_back(std::move(route));
+	indexRoute(_routes.size() - 1);
+}
+
+long long TrickjumpLines::routeGridCell(int x, int y) const
+{
+	return (static_cast<long long>(x) << 32) | static_cast<unsigned int>(y);
+}
+
+void TrickjumpLines::indexRoute(int position)
+{
+	const Route& route = _routes[position];
+
+	_routePositionByName.emplace(routeDisplayName(route), position);
+
+	if (route.status == routeStatus::map)
+	{
+		++_mapperRouteCount;
+	}
+	else if (!route.filename.empty())
+	{
+		++_routeCountByFile[route.filename];
+	}
+
+	const float *points[2] = { route.start, route.end };
+	for (int i = 0; i < 2; ++i)
+	{
+		const int x = static_cast<int>(std::floor(points[i][0] / ROUTE_GRID_CELL_SIZE));
+		const int y = static_cast<int>(std::floor(points[i][1] / ROUTE_GRID_CELL_SIZE));
+
+		if (_routeGrid.empty())
 		{
-			if (_routes[z].name == tmp)
-			{
-				return z;
-			}
+			_routeGridMins[0] = _routeGridMaxs[0] = x;
+			_routeGridMins[1] = _routeGridMaxs[1] = y;
 		}
 		else
 		{
-			if ((_routes[z].filename + std::string("_") + _routes[z].name) == tmp)
-			{
-				return z;
-			}
+			_routeGridMins[0] = std::min(_routeGridMins[0], x);
+			_routeGridMins[1] = std::min(_routeGridMins[1], y);
+			_routeGridMaxs[0] = std::max(_routeGridMaxs[0], x);
+			_routeGridMaxs[1] = std::max(_routeGridMaxs[1], y);
 		}
+
+		_routeGrid[routeGridCell(x, y)].push_back(position * 2 + i);
 	}
-	if (isDebug())
+}
+
+void TrickjumpLines::rebuildRouteIndex()
+{
+	_routePositionByName.clear();
+	_routeCountByFile.clear();
+	_mapperRouteCount = 0;
+	_routeGrid.clear();
+
+	for (int z = 0; z < static_cast<int>(_routes.size()); ++z)
 	{
-		CG_Printf("No route with name : %s has been found. \n", name);
+		indexRoute(z);
 	}
-
-	return -1;
 }
 
 void TrickjumpLines::deleteRoute(const char *name)
@@ -1185,6 +1579,7 @@ void TrickjumpLines::deleteRoute(const char *name)
 			return;
 		}
 		_routes.erase(_routes.begin() + z);
+		rebuildRouteIndex();
 		return;
 	}
 	else
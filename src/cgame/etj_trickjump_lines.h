@@ -30,6 +30,7 @@
 #include <array>
 #include "etj_rotation_matrix.h"
 #include <map>
+#include <unordered_map>
 
 enum routeStatus{
 	map,
@@ -60,6 +61,42 @@ public:
 		//bool isProne; // TODO: Add for ghost
 	};
 
+	static const int NUM_LOD_LEVELS = 3;
+	static const int BEZIER_DIVISIONS = 150;
+	static const int MAX_BEZIER_DEGREE = 32;
+	static const int ROUTE_GRID_CELL_SIZE = 512;
+
+	struct TrailGeometry
+	{
+		// bounds for view culling and picking the level of detail
+		vec3_t mins;
+		vec3_t maxs;
+		vec3_t center;
+		float radius;
+		// index of the first node color in RouteGeometry::colors
+		size_t firstColor;
+		// node indices simplified with the matching LOD tolerance,
+		// the full trail is used below the first one
+		std::vector<int> lods[NUM_LOD_LEVELS];
+		// bezier curve through the trail and its colors, only built when lines are smoothed
+		std::vector<Node> curve;
+		std::vector< std::array<vec_c, 4> > curveColors;
+	};
+
+	// Per route render data that only depends on the trails and the line color,
+	// so it is built once instead of every frame.
+	struct RouteGeometry
+	{
+		RouteGeometry() : version(-1), minSpeed(0), maxSpeed(0) {}
+
+		int version;
+		float minSpeed;
+		float maxSpeed;
+		// one color per node, trails concatenated
+		std::vector< std::array<vec_c, 4> > colors;
+		std::vector<TrailGeometry> trails;
+	};
+
 	struct Route
 	{
 		std::string name;		
@@ -68,6 +105,15 @@ public:
 		float width;
 		routeStatus status;
 		std::string filename;
+		// first and last node and bounds of the whole route,
+		// known without decoding the trails of binary routes
+		vec3_t start;
+		vec3_t end;
+		vec3_t mins;
+		vec3_t maxs;
+		// routes loaded from binary files keep their trails encoded until needed
+		std::vector<unsigned char> encodedTrails;
+		RouteGeometry geometry;
 	};
 
 	TrickjumpLines();
@@ -113,7 +159,17 @@ public:
 
 	void overwriteRecording(const char *name);
 
+	/**
+	 * Saves the recorded routes in the binary format
+	 */
 	void saveRoutes(const char *savename);
+	/**
+	 * Saves the recorded routes as json, the format used before the binary one
+	 */
+	void exportRoutes(const char *savename);
+	/**
+	 * Loads binary or json routes, the format is detected from the file
+	 */
 	void loadRoutes(const char *loadname);
 	bool loadedRoutes(const char *loadname);
 
@@ -129,15 +185,27 @@ public:
 private:
 
 	// Private function.
-	unsigned long gcd_ui(unsigned long x, unsigned long y);
-	unsigned long binomial(unsigned long n, unsigned long k);
-	void addTrickjumpRecursiveBezier(std::vector< Node > points, vec4_c color, float width, int nbDivision);
+	const std::vector<double>& bernsteinWeights(int degree, int divisions);
+	void buildBezierCurve(const std::vector< Node >& points, std::vector< Node >& curve);
+	std::array<vec_c, 4> nodeColor(float speed, float minSpeed, float maxSpeed);
 
-	void draw4VertexLine(vec3_t start, vec3_t end, float width, vec4_c color);
-	void draw4VertexLine2Color(vec3_t start, vec3_t end, float width, vec4_c colorStart, vec4_c colorEnd);
+	bool openRouteFile(const char *savename, int& f);
+	void loadJsonRoutes(const std::string& json, const std::string& path, const char *loadname, routeStatus loadStatus);
+	void loadBinaryRoutes(int f, int len, const std::vector<unsigned char>& headerData, const std::string& path, const char *loadname, routeStatus loadStatus);
+	bool decodeRoute(Route& route);
 
-	void addTrickjumpLines(std::vector< Node > points, vec4_c color, float width);
-	void addTrickjumpLinesColor(std::vector< Node > points, float minSpeed, float maxSpeed, float width);
+	std::string routeDisplayName(const Route& route) const;
+	void addRoute(Route route);
+	void indexRoute(int position);
+	void rebuildRouteIndex();
+	long long routeGridCell(int x, int y) const;
+	int findNearestRoutePoint(const vec3_t point, bool& isEnd) const;
+	void updateRouteBounds(Route& route);
+
+	void updateRouteGeometry(Route& route);
+	void addRouteGeometry(const Route& route);
+	void simplifyTrail(const std::vector< Node >& points, float tolerance, std::vector<int>& indices);
+	int selectTrailLod(const TrailGeometry& trail, float width);
 
 	void addJumpIndicator(vec3_t point, vec4_c color, float quadSize);	
 	
@@ -162,12 +230,40 @@ private:
 	int _currentRouteToRender;
 	RotationMatrix _currentRotation;
 
+	// bumped whenever the line color changes, invalidates every RouteGeometry
+	int _geometryVersion;
+	// lookups over _routes, rebuilt when routes are removed or renamed.
+	// Names map to the first route with that name, like the linear search did.
+	std::unordered_map<std::string, int> _routePositionByName;
+	std::unordered_map<std::string, int> _routeCountByFile;
+	int _mapperRouteCount;
+	// start and end points of the routes bucketed into a 2D grid,
+	// each entry is route position * 2 + 1 for end points
+	std::unordered_map<long long, std::vector<int>> _routeGrid;
+	int _routeGridMins[2];
+	int _routeGridMaxs[2];
+
+	// scratch buffer for the per node view directions
+	std::vector< std::array<float, 3> > _viewDirs;
+
+	// resolved from the color cvars only when they change
 	vec4_c lineColor;
 	vec4_c markerColor;
 	vec4_c markerEndColor;
+	bool _lineColorBySpeed;
+	int _lineColorModificationCount;
+	int _markerColorModificationCount;
+	int _markerEndColorModificationCount;
+	bool _smoothLines;
+	int _smoothLinesModificationCount;
+	// basis weights of the bezier curves by degree and number of divisions
+	std::map<std::pair<int, int>, std::vector<double>> _bernsteinWeights;
+
+	void resolveColor(const char *colorString, vec4_c &color);
+	void updateColors();
 
 	// Private inline function.
-	float euclideanDist(const vec3_t a, const vec3_t b)
+	float euclideanDist(const vec3_t a, const vec3_t b) const
 	{
 		float sum = 0;
 
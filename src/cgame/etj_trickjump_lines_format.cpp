@@ -0,0 +1,376 @@
+/*
+ * MIT License
+ * 
+ * Copyright (c) 2020 ETJump team <zero@etjump.com>
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <cmath>
+#include <cstring>
+#include "etj_trickjump_lines_format.h"
+
+namespace
+{
+	const char Magic[4] = { 'T', 'J', 'L', 'B' };
+
+	class Writer
+	{
+	public:
+		explicit Writer(std::vector<unsigned char>& buffer) : _buffer(buffer) {}
+
+		void u8(uint8_t value)
+		{
+			_buffer.push_back(value);
+		}
+
+		void u16(uint16_t value)
+		{
+			u8(value & 0xff);
+			u8(value >> 8);
+		}
+
+		void u32(uint32_t value)
+		{
+			u16(value & 0xffff);
+			u16(value >> 16);
+		}
+
+		void f32(float value)
+		{
+			uint32_t bits;
+			memcpy(&bits, &value, sizeof(bits));
+			u32(bits);
+		}
+
+		void vec3(const float *v)
+		{
+			f32(v[0]);
+			f32(v[1]);
+			f32(v[2]);
+		}
+
+		void varint(uint32_t value)
+		{
+			while (value >= 0x80)
+			{
+				u8((value & 0x7f) | 0x80);
+				value >>= 7;
+			}
+			u8(value);
+		}
+
+		void zigzag(int32_t value)
+		{
+			varint((static_cast<uint32_t>(value) << 1) ^ static_cast<uint32_t>(value >> 31));
+		}
+
+	private:
+		std::vector<unsigned char>& _buffer;
+	};
+
+	// every read checks the remaining size, a truncated file just fails
+	class Reader
+	{
+	public:
+		Reader(const unsigned char *data, size_t size) : _data(data), _size(size), _pos(0), _ok(true) {}
+
+		bool ok() const { return _ok; }
+		bool atEnd() const { return _pos == _size; }
+
+		uint8_t u8()
+		{
+			if (_pos >= _size)
+			{
+				_ok = false;
+				return 0;
+			}
+			return _data[_pos++];
+		}
+
+		uint16_t u16()
+		{
+			uint16_t low = u8();
+			return low | (u8() << 8);
+		}
+
+		uint32_t u32()
+		{
+			uint32_t low = u16();
+			return low | (static_cast<uint32_t>(u16()) << 16);
+		}
+
+		float f32()
+		{
+			uint32_t bits = u32();
+			float value;
+			memcpy(&value, &bits, sizeof(value));
+			return value;
+		}
+
+		void vec3(float *v)
+		{
+			v[0] = f32();
+			v[1] = f32();
+			v[2] = f32();
+		}
+
+		std::string string(size_t length)
+		{
+			if (_size - _pos < length)
+			{
+				_ok = false;
+				return "";
+			}
+			std::string value(reinterpret_cast<const char *>(_data + _pos), length);
+			_pos += length;
+			return value;
+		}
+
+		uint32_t varint()
+		{
+			uint32_t value = 0;
+			for (int shift = 0; shift < 35; shift += 7)
+			{
+				uint8_t byte = u8();
+				value |= static_cast<uint32_t>(byte & 0x7f) << shift;
+				if (!(byte & 0x80))
+				{
+					return value;
+				}
+			}
+			_ok = false;
+			return 0;
+		}
+
+		int32_t zigzag()
+		{
+			uint32_t value = varint();
+			return static_cast<int32_t>((value >> 1) ^ (~(value & 1) + 1));
+		}
+
+	private:
+		const unsigned char *_data;
+		size_t _size;
+		size_t _pos;
+		bool _ok;
+	};
+
+	// quantized values are kept within this range, so the delta
+	// of any two of them fits in an int32_t
+	const int32_t MaxQuantized = (1 << 30) - 1;
+
+	int32_t quantize(float value, int scale)
+	{
+		const auto scaled = static_cast<double>(value) * scale;
+		if (!(scaled > -MaxQuantized))
+		{
+			return -MaxQuantized;
+		}
+		if (!(scaled < MaxQuantized))
+		{
+			return MaxQuantized;
+		}
+		return static_cast<int32_t>(std::lround(scaled));
+	}
+
+	void writeTrails(Writer& writer, const ETJump::TrickjumpLinesFormat::Route& route)
+	{
+		using ETJump::TrickjumpLinesFormat;
+
+		writer.varint(route.trails.size());
+		for (const auto& trail : route.trails)
+		{
+			int32_t previous[4] = { 0, 0, 0, 0 };
+
+			writer.varint(trail.size());
+			for (const auto& node : trail)
+			{
+				const int32_t current[4] = {
+					quantize(node.coor[0], TrickjumpLinesFormat::CoordinateScale),
+					quantize(node.coor[1], TrickjumpLinesFormat::CoordinateScale),
+					quantize(node.coor[2], TrickjumpLinesFormat::CoordinateScale),
+					quantize(node.speed, TrickjumpLinesFormat::SpeedScale)
+				};
+
+				for (int i = 0; i < 4; ++i)
+				{
+					writer.zigzag(current[i] - previous[i]);
+					previous[i] = current[i];
+				}
+			}
+		}
+	}
+}
+
+bool ETJump::TrickjumpLinesFormat::isBinary(const unsigned char *data, size_t size)
+{
+	return size >= sizeof(Magic) && !memcmp(data, Magic, sizeof(Magic));
+}
+
+std::vector<unsigned char> ETJump::TrickjumpLinesFormat::write(const std::vector<const Route *>& routes)
+{
+	std::vector<unsigned char> index;
+	std::vector<unsigned char> data;
+	Writer indexWriter(index);
+	Writer dataWriter(data);
+
+	for (const auto route : routes)
+	{
+		const auto dataStart = data.size();
+		writeTrails(dataWriter, *route);
+
+		const auto name = route->name.substr(0, 0xffff);
+		indexWriter.u16(name.size());
+		for (auto c : name)
+		{
+			indexWriter.u8(c);
+		}
+		for (auto i = 0; i < 4; ++i)
+		{
+			indexWriter.u8(route->color[i]);
+		}
+		indexWriter.f32(route->width);
+		indexWriter.vec3(route->start);
+		indexWriter.vec3(route->end);
+		indexWriter.vec3(route->mins);
+		indexWriter.vec3(route->maxs);
+		indexWriter.u32(data.size() - dataStart);
+	}
+
+	std::vector<unsigned char> file;
+	Writer writer(file);
+
+	file.insert(file.end(), Magic, Magic + sizeof(Magic));
+	writer.u16(Version);
+	writer.u16(0);
+	writer.u32(routes.size());
+	writer.u32(index.size());
+	file.insert(file.end(), index.begin(), index.end());
+	file.insert(file.end(), data.begin(), data.end());
+
+	return file;
+}
+
+bool ETJump::TrickjumpLinesFormat::readHeader(const unsigned char *data, size_t size, Header& header, std::string& error)
+{
+	if (size < static_cast<size_t>(HeaderSize) || !isBinary(data, size))
+	{
+		error = "not a binary trickjump lines file";
+		return false;
+	}
+
+	Reader reader(data + sizeof(Magic), size - sizeof(Magic));
+	header.version = reader.u16();
+	reader.u16();
+	header.routeCount = reader.u32();
+	header.indexSize = reader.u32();
+
+	if (header.version > Version)
+	{
+		error = "unsupported version " + std::to_string(header.version);
+		return false;
+	}
+
+	return true;
+}
+
+bool ETJump::TrickjumpLinesFormat::readIndex(const Header& header, const unsigned char *data, size_t size,
+	std::vector<Route>& routes, std::vector<uint32_t>& dataSizes, std::string& error)
+{
+	Reader reader(data, size);
+
+	for (uint32_t i = 0; i < header.routeCount && reader.ok(); ++i)
+	{
+		Route route;
+
+		route.name = reader.string(reader.u16());
+		for (auto j = 0; j < 4; ++j)
+		{
+			route.color[j] = reader.u8();
+		}
+		route.width = reader.f32();
+		reader.vec3(route.start);
+		reader.vec3(route.end);
+		reader.vec3(route.mins);
+		reader.vec3(route.maxs);
+		dataSizes.push_back(reader.u32());
+		routes.push_back(std::move(route));
+	}
+
+	if (!reader.ok())
+	{
+		error = "truncated route index";
+		return false;
+	}
+
+	return true;
+}
+
+bool ETJump::TrickjumpLinesFormat::readTrails(const unsigned char *data, size_t size, std::vector<std::vector<Node>>& trails)
+{
+	Reader reader(data, size);
+
+	trails.clear();
+
+	const auto trailCount = reader.varint();
+	// every trail and node takes at least a byte, don't trust the counts further than that
+	if (trailCount > size)
+	{
+		return false;
+	}
+	trails.resize(trailCount);
+
+	for (auto& trail : trails)
+	{
+		// wider than the stored values, a crafted file can't overflow it
+		int64_t current[4] = { 0, 0, 0, 0 };
+
+		const auto nodeCount = reader.varint();
+		if (!reader.ok() || nodeCount > size)
+		{
+			return false;
+		}
+		trail.resize(nodeCount);
+
+		for (auto& node : trail)
+		{
+			for (int i = 0; i < 4; ++i)
+			{
+				current[i] += reader.zigzag();
+				if (current[i] < -MaxQuantized || current[i] > MaxQuantized)
+				{
+					return false;
+				}
+			}
+
+			node.coor[0] = static_cast<float>(current[0]) / CoordinateScale;
+			node.coor[1] = static_cast<float>(current[1]) / CoordinateScale;
+			node.coor[2] = static_cast<float>(current[2]) / CoordinateScale;
+			node.speed = static_cast<float>(current[3]) / SpeedScale;
+		}
+
+		if (!reader.ok())
+		{
+			return false;
+		}
+	}
+
+	return reader.ok() && reader.atEnd();
+}
@@ -0,0 +1,83 @@
+/*
+ * MIT License
+ * 
+ * Copyright (c) 2020 ETJump team <zero@etjump.com>
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*
+	Binary trickjump line format.
+
+	File layout (little endian):
+		header: "TJLB", uint16 version, uint16 reserved, uint32 route count, uint32 index size
+		index:  one entry per route with the name, color, width, start and end
+		        points, bounds and the size of the route data
+		data:   the trails of each route, in index order
+
+	Node coordinates are quantized to 1/8 units and speeds to 1/16 ups, and
+	stored as zigzag varint deltas to the previous node of the trail. The index
+	is enough to list routes and find the nearest ones, so the trails of a
+	route are only decoded when it is displayed.
+*/
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "etj_trickjump_lines.h"
+
+namespace ETJump
+{
+	class TrickjumpLinesFormat
+	{
+	public:
+		typedef TrickjumpLines::Route Route;
+		typedef TrickjumpLines::Node Node;
+
+		static const uint16_t Version = 1;
+		static const int HeaderSize = 16;
+		static const int CoordinateScale = 8;
+		static const int SpeedScale = 16;
+
+		struct Header
+		{
+			uint16_t version;
+			uint32_t routeCount;
+			uint32_t indexSize;
+		};
+
+		// returns true if data starts with the binary format magic
+		static bool isBinary(const unsigned char *data, size_t size);
+
+		// encodes routes into a complete file
+		static std::vector<unsigned char> write(const std::vector<const Route *>& routes);
+
+		// parses the fixed size header at the start of the file
+		static bool readHeader(const unsigned char *data, size_t size, Header& header, std::string& error);
+
+		// parses the index, filling everything but the trails of each route.
+		// The data size of each route is stored into dataSizes.
+		static bool readIndex(const Header& header, const unsigned char *data, size_t size,
+			std::vector<Route>& routes, std::vector<uint32_t>& dataSizes, std::string& error);
+
+		// decodes the trails of a route from its data
+		static bool readTrails(const unsigned char *data, size_t size, std::vector<std::vector<Node>>& trails);
+	};
+}
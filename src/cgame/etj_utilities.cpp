@@ -22,11 +22,11 @@
  * SOFTWARE.
  */
 
-#include <regex>
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
 #include <unordered_map>
-#include <sstream>
 #include <memory>
-#include <boost/algorithm/string.hpp>
 
 #include "etj_utilities.h"
 #include "etj_event_loop.h"
@@ -66,125 +66,324 @@ std::string ETJump::composeShader(const char *name, ShaderStages stages)
 	return composeShader(name, { "" }, stages);
 }
 
-static std::unordered_map<std::string, vec4_t*> validColorNames =
+namespace
 {
-	{ "white",    &colorWhite },
-	{ "red",      &colorRed },
-	{ "green",    &colorGreen },
-	{ "blue",     &colorBlue },
-	{ "yellow",   &colorYellow },
-	{ "magenta",  &colorMagenta },
-	{ "cyan",     &colorCyan },
-	{ "orange",   &colorOrange },
-	{ "mdred",    &colorMdRed },
-	{ "mdgreen",  &colorMdGreen },
-	{ "dkgreen",  &colorDkGreen },
-	{ "mdcyan",   &colorMdCyan },
-	{ "mdyellow", &colorMdYellow },
-	{ "mdorange", &colorMdOrange },
-	{ "mdblue",   &colorMdBlue },
-	{ "gray",     &colorMdGrey },
-	{ "grey",     &colorMdGrey },
-	{ "ltgrey",   &colorLtGrey },
-	{ "mdgrey",   &colorMdGrey },
-	{ "dkgrey",   &colorDkGrey },
-	{ "black",    &colorBlack },
-};
-
-static void parseNamedColorString(const std::string &token, vec4_t &color)
-{
-	auto validColor = validColorNames[token];
-	if (validColor)
+	struct NamedColor
+	{
+		const char *name;
+		vec4_t     *color;
+	};
+
+	const NamedColor validColorNames[] =
 	{
-		color[0] = (*validColor)[0];
-		color[1] = (*validColor)[1];
-		color[2] = (*validColor)[2];
+		{ "white",    &colorWhite },
+		{ "red",      &colorRed },
+		{ "green",    &colorGreen },
+		{ "blue",     &colorBlue },
+		{ "yellow",   &colorYellow },
+		{ "magenta",  &colorMagenta },
+		{ "cyan",     &colorCyan },
+		{ "orange",   &colorOrange },
+		{ "mdred",    &colorMdRed },
+		{ "mdgreen",  &colorMdGreen },
+		{ "dkgreen",  &colorDkGreen },
+		{ "mdcyan",   &colorMdCyan },
+		{ "mdyellow", &colorMdYellow },
+		{ "mdorange", &colorMdOrange },
+		{ "mdblue",   &colorMdBlue },
+		{ "gray",     &colorMdGrey },
+		{ "grey",     &colorMdGrey },
+		{ "ltgrey",   &colorLtGrey },
+		{ "mdgrey",   &colorMdGrey },
+		{ "dkgrey",   &colorDkGrey },
+		{ "black",    &colorBlack },
+	};
+
+	bool isSpace(char c)
+	{
+		return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\v' || c == '\f';
 	}
-}
 
-static void parseRGBAValuedColorString(const std::string colorString, vec4_t &color)
-{
-	std::istringstream tokenStream{ colorString };
-	std::string token;
-	auto colorChannel = 0;
-	while (tokenStream >> token)
+	bool isDigit(char c)
+	{
+		return c >= '0' && c <= '9';
+	}
+
+	char toLower(char c)
+	{
+		return c >= 'A' && c <= 'Z' ? c - 'A' + 'a' : c;
+	}
+
+	int hexValue(char c)
 	{
-		if (colorChannel > 3)
+		c = toLower(c);
+		if (isDigit(c))
+		{
+			return c - '0';
+		}
+		if (c >= 'a' && c <= 'f')
 		{
-			break;
+			return c - 'a' + 10;
 		}
-		auto value = std::min(std::max(std::stof(token), 0.f), 255.f);
-		color[colorChannel] = value;
-		colorChannel++;
+		return -1;
 	}
-}
 
-static void parseHexValuedColorString(const std::string &token, vec4_t &color)
-{
-	auto colorValue = std::stoll(token, nullptr, 16);
-	auto channelCount = ((token.size() - 1) >> 1) + 1;
-	auto maxShift = 8 * channelCount;
-	for (auto i = 0; i < channelCount; i++)
+	// white, black, etc
+	void parseNamedColor(const char *begin, const char *end, vec4_t &color)
 	{
-		color[i] = (colorValue >> (maxShift - 8 * (i + 1))) & 0xff;
+		auto length = end - begin;
+		for (const auto& named : validColorNames)
+		{
+			if (static_cast<std::ptrdiff_t>(strlen(named.name)) != length)
+			{
+				continue;
+			}
+
+			auto matches = true;
+			for (auto i = 0; i < length && matches; i++)
+			{
+				matches = toLower(begin[i]) == named.name[i];
+			}
+
+			if (matches)
+			{
+				color[0] = (*named.color)[0];
+				color[1] = (*named.color)[1];
+				color[2] = (*named.color)[2];
+				return;
+			}
+		}
 	}
-}
 
-static void normalizeColorIfRequired(vec4_t &v)
-{
-	float max = 0.f;
-	for (auto i = 0; i < 3; i++)
+	// 255 0 0, 1.0 0 0
+	// numbers may also follow each other without whitespace, e.g. 1-1
+	bool isValuedColor(const char *begin, const char *end)
 	{
-		max = std::max(v[i], max);
+		auto c = begin;
+		while (c != end)
+		{
+			if (*c == '-' || *c == '+')
+			{
+				c++;
+			}
+
+			auto integerDigits = 0;
+			while (c != end && isDigit(*c))
+			{
+				c++;
+				integerDigits++;
+			}
+
+			if (c != end && *c == '.')
+			{
+				c++;
+				// a fraction needs at least one digit
+				if (c == end || !isDigit(*c))
+				{
+					return false;
+				}
+				while (c != end && isDigit(*c))
+				{
+					c++;
+				}
+			}
+			else if (!integerDigits)
+			{
+				return false;
+			}
+
+			while (c != end && isSpace(*c))
+			{
+				c++;
+			}
+		}
+		return true;
 	}
 
-	// non-normalized color
-	if (max > 1.0f)
+	void parseValuedColor(const char *begin, const char *end, vec4_t &color)
 	{
-		for (auto i = 0; i < 3; i++)
+		// each whitespace separated token is one channel
+		char token[64];
+		auto channel = 0;
+		auto c       = begin;
+		while (c != end && channel < 4)
 		{
-			v[i] /= 255.f;
+			auto tokenStart = c;
+			while (c != end && !isSpace(*c))
+			{
+				c++;
+			}
+
+			auto length = std::min(static_cast<std::size_t>(c - tokenStart), sizeof(token) - 1);
+			memcpy(token, tokenStart, length);
+			token[length] = '\0';
+
+			color[channel++] = std::min(std::max(static_cast<float>(strtod(token, nullptr)), 0.f), 255.f);
+
+			while (c != end && isSpace(*c))
+			{
+				c++;
+			}
 		}
 	}
 
-	// handle alpha separately
-	if (v[3] > 1.0)
+	// 0xff0000, #ff0000, digits after the first 8 are ignored
+	bool parseHexColor(const char *begin, const char *end, vec4_t &color)
 	{
-		v[3] /= 255.f;
+		if (begin == end)
+		{
+			return false;
+		}
+
+		unsigned long long value  = 0;
+		auto               digits = 0;
+		for (auto c = begin; c != end; c++)
+		{
+			auto digit = hexValue(*c);
+			if (digit < 0)
+			{
+				return false;
+			}
+
+			if (digits < 8)
+			{
+				value = (value << 4) | digit;
+				digits++;
+			}
+		}
+
+		auto channelCount = ((digits - 1) >> 1) + 1;
+		auto maxShift     = 8 * channelCount;
+		for (auto i = 0; i < channelCount; i++)
+		{
+			color[i] = (value >> (maxShift - 8 * (i + 1))) & 0xff;
+		}
+		return true;
 	}
-}
 
-const std::string alphaRegex{ "^[a-z]+" }; // white, black, etc
-const std::string digitRegex{ "^([-+]?[0-9]*\\.?[0-9]+\\s*)+" }; // 255 0 0, 1.0 0 0
-const std::string hexedRegex{ "^0[x][a-f0-9]+" }; // 0xff0000
-const std::string hashdRegex{ "^#[a-f0-9]+" }; // #ff0000
+	void normalizeColorIfRequired(vec4_t &v)
+	{
+		float max = 0.f;
+		for (auto i = 0; i < 3; i++)
+		{
+			max = std::max(v[i], max);
+		}
 
-void ETJump::parseColorString(const std::string &colorString, vec4_t &color)
-{	
+		// non-normalized color
+		if (max > 1.0f)
+		{
+			for (auto i = 0; i < 3; i++)
+			{
+				v[i] /= 255.f;
+			}
+		}
+
+		// handle alpha separately
+		if (v[3] > 1.0)
+		{
+			v[3] /= 255.f;
+		}
+	}
+
+	struct CachedColor
+	{
+		vec4_t color;
+	};
+
+	// parsed colors by color string, cleared if it grows too large
+	std::unordered_map<std::string, CachedColor> colorCache;
+	const std::size_t MaxCachedColors = 256;
+
+	struct CvarColor
+	{
+		int    modificationCount;
+		vec4_t color;
+	};
+
+	std::unordered_map<const vmCvar_t *, CvarColor> cvarColors;
+}
+
+void ETJump::parseColorString(const char *colorString, vec4_t &color)
+{
 	Vector4Set(color, 0.0f, 0.0f, 0.0f, 1.0); // set defaults
-	std::string token{ boost::algorithm::to_lower_copy(boost::algorithm::trim_copy(colorString)) };
 
-	if (std::regex_match(token, std::regex(alphaRegex)))
+	auto begin = colorString;
+	auto end   = colorString + strlen(colorString);
+	while (begin != end && isSpace(*begin))
+	{
+		begin++;
+	}
+	while (end != begin && isSpace(*(end - 1)))
+	{
+		end--;
+	}
+
+	if (begin == end)
+	{
+		return;
+	}
+
+	auto alpha = true;
+	for (auto c = begin; c != end && alpha; c++)
+	{
+		alpha = (*c >= 'a' && *c <= 'z') || (*c >= 'A' && *c <= 'Z');
+	}
+
+	if (alpha)
 	{
-		parseNamedColorString(token, color);
+		parseNamedColor(begin, end, color);
 		return;
 	}
-	else if (std::regex_match(token, std::regex(digitRegex)))
+
+	if (isValuedColor(begin, end))
 	{
-		parseRGBAValuedColorString(token, color);
+		parseValuedColor(begin, end, color);
 	}
-	else if (std::regex_match(token, std::regex(hexedRegex)))
+	else if (end - begin > 2 && begin[0] == '0' && toLower(begin[1]) == 'x')
 	{
-		parseHexValuedColorString(token.substr(2, 8), color);
+		parseHexColor(begin + 2, end, color);
 	}
-	else if (std::regex_match(token, std::regex(hashdRegex)))
+	else if (begin[0] == '#')
 	{
-		parseHexValuedColorString(token.substr(1, 8), color);
+		parseHexColor(begin + 1, end, color);
 	}
 
 	normalizeColorIfRequired(color);
 }
 
+void ETJump::parseColorString(const std::string &colorString, vec4_t &color)
+{
+	auto cached = colorCache.find(colorString);
+	if (cached != colorCache.end())
+	{
+		Vector4Copy(cached->second.color, color);
+		return;
+	}
+
+	parseColorString(colorString.c_str(), color);
+
+	if (colorCache.size() >= MaxCachedColors)
+	{
+		colorCache.clear();
+	}
+	Vector4Copy(color, colorCache[colorString].color);
+}
+
+void ETJump::parseColorCvar(const vmCvar_t &cvar, vec4_t &color)
+{
+	auto cached = cvarColors.find(&cvar);
+	if (cached == cvarColors.end() || cached->second.modificationCount != cvar.modificationCount)
+	{
+		auto& entry = cvarColors[&cvar];
+		entry.modificationCount = cvar.modificationCount;
+		parseColorString(cvar.string, entry.color);
+		Vector4Copy(entry.color, color);
+		return;
+	}
+
+	Vector4Copy(cached->second.color, color);
+}
+
 #ifdef CGAMEDLL
 
 int ETJump::setTimeout(std::function<void()> fun, int delay)
@@ -34,7 +34,12 @@ namespace ETJump
 	typedef std::initializer_list<ShaderStage> ShaderStages;
 	std::string composeShader(const char *name, ShaderStage general, ShaderStages stages);
 	std::string composeShader(const char *name, ShaderStages stages);
+	// parses named (white), valued (255 0 0, 1.0 0 0) and hex (0xff0000, #ff0000) colors
+	void parseColorString(const char *colorString, vec4_t &color);
+	// same as above, but each distinct string is only parsed once
 	void parseColorString(const std::string &colorString, vec4_t &color);
+	// returns the color of a color cvar, parsed again only after the cvar changes
+	void parseColorCvar(const vmCvar_t &cvar, vec4_t &color);
 
 	template<typename T, std::size_t N>
 	constexpr std::size_t nelem(T(&)[N]) 
@@ -0,0 +1,122 @@
+/*
+ * MIT License
+ * 
+ * Copyright (c) 2020 ETJump team <zero@etjump.com>
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <cstring>
+
+#include "etj_argument_tokenizer.h"
+
+const int ETJump::ArgumentTokenizer::MaxLineLength;
+const int ETJump::ArgumentTokenizer::MaxArguments;
+
+ETJump::ArgumentTokenizer::ArgumentTokenizer() : _argc(0)
+{
+	_line[0]   = '\0';
+	_tokens[0] = '\0';
+}
+
+ETJump::ArgumentTokenizer::~ArgumentTokenizer()
+{
+}
+
+void ETJump::ArgumentTokenizer::tokenize(const char *line)
+{
+	auto len = 0;
+	while (line[len] && len < MaxLineLength - 1)
+	{
+		_line[len]   = line[len];
+		_tokens[len] = line[len];
+		++len;
+	}
+	_line[len]   = '\0';
+	_tokens[len] = '\0';
+
+	_argc = 0;
+	auto i = 0;
+	while (i < len && _argc < MaxArguments)
+	{
+		while (i < len && _tokens[i] == ' ')
+		{
+			_tokens[i++] = '\0';
+		}
+
+		if (i == len)
+		{
+			break;
+		}
+
+		_offsets[_argc] = i;
+		while (i < len && _tokens[i] != ' ')
+		{
+			++i;
+		}
+		_lengths[_argc] = i - _offsets[_argc];
+		++_argc;
+	}
+
+	// ran out of argument slots, make sure the last one is terminated
+	while (i < len)
+	{
+		if (_tokens[i] == ' ')
+		{
+			_tokens[i] = '\0';
+		}
+		++i;
+	}
+}
+
+int ETJump::ArgumentTokenizer::argc() const
+{
+	return _argc;
+}
+
+const char *ETJump::ArgumentTokenizer::argv(int n) const
+{
+	if (n < 0 || n >= _argc)
+	{
+		return "";
+	}
+	return _tokens + _offsets[n];
+}
+
+int ETJump::ArgumentTokenizer::length(int n) const
+{
+	if (n < 0 || n >= _argc)
+	{
+		return 0;
+	}
+	return _lengths[n];
+}
+
+const char *ETJump::ArgumentTokenizer::argsFrom(int n) const
+{
+	if (n < 0)
+	{
+		n = 0;
+	}
+	if (n >= _argc)
+	{
+		return "";
+	}
+	return _line + _offsets[n];
+}
@@ -0,0 +1,82 @@
+/*
+ * MIT License
+ * 
+ * Copyright (c) 2020 ETJump team <zero@etjump.com>
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+namespace ETJump
+{
+	/**
+	 * Splits a command line into space separated arguments without
+	 * allocating. The line is copied into a fixed size buffer once and the
+	 * arguments are views into that buffer, so they stay valid until the
+	 * next call to tokenize.
+	 *
+	 * Used for chat lines, where the client might send the whole
+	 * message as a single argument (say "!cmd arg0 arg1") or as
+	 * multiple arguments (say !cmd arg0 arg1).
+	 */
+	class ArgumentTokenizer
+	{
+	public:
+		static const int MaxLineLength = 1024;
+		static const int MaxArguments = 256;
+
+		ArgumentTokenizer();
+		~ArgumentTokenizer();
+
+		/**
+		 * Tokenizes the line, replacing the previous arguments. Lines
+		 * longer than MaxLineLength - 1 are truncated.
+		 * @param line
+		 */
+		void tokenize(const char *line);
+		/**
+		 * @return the number of arguments
+		 */
+		int argc() const;
+		/**
+		 * @param n
+		 * @return nth argument, or an empty string if there aren't so many
+		 */
+		const char *argv(int n) const;
+		/**
+		 * @param n
+		 * @return length of the nth argument, 0 if there aren't so many
+		 */
+		int length(int n) const;
+		/**
+		 * @param n
+		 * @return the rest of the original line starting from the nth argument
+		 */
+		const char *argsFrom(int n) const;
+	private:
+		// original line, for argsFrom
+		char _line[MaxLineLength];
+		// same as _line, except argument separators are replaced with '\0'
+		char _tokens[MaxLineLength];
+		int _offsets[MaxArguments];
+		int _lengths[MaxArguments];
+		int _argc;
+	};
+}
@@ -35,6 +35,7 @@
 #include "etj_map_statistics.h"
 #include "etj_utilities.h"
 #include "etj_tokens.h"
+#include "etj_paced_printer.h"
 
 typedef boost::function<bool (gentity_t *ent, Arguments argv)> Command;
 typedef std::pair<boost::function<bool (gentity_t *ent, Arguments argv)>, char> AdminCommandPair;
@@ -133,6 +134,18 @@ bool Records(gentity_t *ent, Arguments argv)
 	game.timerun->printRecords(ClientNum(ent), map, runName);
 	return true;
 }
+
+bool StopOutput(gentity_t *ent, Arguments argv)
+{
+	if (!ETJump::pacedPrinter->cancel(ClientNum(ent)))
+	{
+		ChatPrintTo(ent, "^3stopoutput: ^7nothing is being printed.");
+		return false;
+	}
+
+	ConsolePrintTo(ent, "^3stopoutput: ^7output stopped.");
+	return true;
+}
 }
 
 void PrintManual(gentity_t *ent, const std::string& command)
@@ -581,6 +594,7 @@ bool EditCommands(gentity_t *ent, Arguments argv)
 		currentPermissions += deleteCommands;
 	}
 	game.levels->Edit(level, "", currentPermissions, "", 1);
+	ETJump::session->LevelEdited(level);
 
 	ChatPrintTo(ent, "^3editcommands: ^7edited level " + (*argv)[1] + " permissions. New permissions are: " + game.levels->GetLevel(level)->commands);
 
@@ -687,13 +701,7 @@ bool EditLevel(gentity_t *ent, Arguments argv)
 	}
 
 	game.levels->Edit(adminLevel, title, commands, greeting, updated);
-
-	for (int i = 0; i < level.numConnectedClients; i++)
-	{
-		int num = level.sortedClients[i];
-
-		ETJump::session->ParsePermissions(num);
-	}
+	ETJump::session->LevelEdited(adminLevel);
 
 	ChatPrintTo(ent, va("^3editlevel: ^7updated level %d.", adminLevel));
 
@@ -2240,6 +2248,7 @@ Commands::Commands()
 	commands_["records"]  = ClientCommands::Records;
 	commands_["times"]    = ClientCommands::Records;
 	commands_["ranks"]    = ClientCommands::Records;
+	commands_["stopoutput"] = ClientCommands::StopOutput;
 }
 
 bool Commands::ClientCommand(gentity_t *ent, std::string commandStr)
@@ -2288,13 +2297,15 @@ bool Commands::List(gentity_t *ent)
 
 bool Commands::AdminCommand(gentity_t *ent)
 {
-	std::string command = "",
-	            arg     = SayArgv(0);
-	int skip            = 0;
+	// reused between calls so that looking up a command doesn't allocate
+	static std::string command;
+	const auto& tokens = TokenizeSayArgs();
+	const char *arg    = tokens.argv(0);
+	int skip           = 0;
 
-	if (arg == "say" || arg == "enc_say")
+	if (!strcmp(arg, "say") || !strcmp(arg, "enc_say"))
 	{
-		arg  = SayArgv(1);
+		arg  = tokens.argv(1);
 		skip = 1;
 	}
 	else
@@ -2304,31 +2315,30 @@ bool Commands::AdminCommand(gentity_t *ent)
 			return false;
 		}
 	}
-	Arguments argv = GetSayArgs(skip);
 
-	if (arg.length() == 0)
+	if (arg[0] == '\0')
 	{
 		return false;
 	}
 
 	if (arg[0] == '!')
 	{
-		if (arg.length() == 1)
+		if (arg[1] == '\0')
 		{
 			return false;
 		}
-		command = &arg[1];
-	}
-	else if (ent == NULL)
-	{
-		command = arg;
+		arg++;
 	}
-	else
+	else if (ent != NULL)
 	{
 		return false;
 	}
 
-	boost::to_lower(command);
+	command.assign(arg);
+	for (auto& c : command)
+	{
+		c = static_cast<char>(tolower(static_cast<unsigned char>(c)));
+	}
 
 	ConstAdminCommandIterator it = adminCommands_.lower_bound(command);
 
@@ -2364,7 +2374,7 @@ bool Commands::AdminCommand(gentity_t *ent)
 			Q_CleanStr(nameBuf);
 		}
 
-		foundCommands[0]->second.first(ent, argv);
+		foundCommands[0]->second.first(ent, GetSayArgs(tokens, skip));
 		return true;
 	}
 
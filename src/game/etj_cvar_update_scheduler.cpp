@@ -0,0 +1,135 @@
+/*
+ * MIT License
+ * 
+ * Copyright (c) 2020 ETJump team <zero@etjump.com>
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include <algorithm>
+#include <cctype>
+
+#include "etj_cvar_update_scheduler.h"
+
+const int ETJump::CvarUpdateScheduler::DefaultSliceSize;
+
+namespace
+{
+	int compareNoCase(const char *lhs, const char *rhs)
+	{
+		for (;; ++lhs, ++rhs)
+		{
+			auto l = std::tolower(static_cast<unsigned char>(*lhs));
+			auto r = std::tolower(static_cast<unsigned char>(*rhs));
+			if (l != r || !l)
+			{
+				return l - r;
+			}
+		}
+	}
+}
+
+ETJump::CvarUpdateScheduler::CvarUpdateScheduler(int sliceSize) :
+	_sliceSize(sliceSize > 0 ? sliceSize : 1), _roundRobinPosition(0), _byNameSorted(true)
+{
+}
+
+ETJump::CvarUpdateScheduler::~CvarUpdateScheduler()
+{
+}
+
+void ETJump::CvarUpdateScheduler::clear()
+{
+	_everyFrame.clear();
+	_roundRobin.clear();
+	_roundRobinPosition = 0;
+	_byName.clear();
+	_byNameSorted = true;
+	_pending.clear();
+	_frame.clear();
+}
+
+void ETJump::CvarUpdateScheduler::add(int index, const char *name, bool everyFrame)
+{
+	if (everyFrame)
+	{
+		_everyFrame.push_back(index);
+	}
+	else
+	{
+		_roundRobin.push_back(index);
+	}
+
+	NamedEntry entry;
+	entry.name  = name;
+	entry.index = index;
+	_byName.push_back(entry);
+	_byNameSorted = false;
+}
+
+void ETJump::CvarUpdateScheduler::cvarSet(const char *name)
+{
+	if (!name)
+	{
+		return;
+	}
+
+	if (!_byNameSorted)
+	{
+		// stable so that duplicate names keep their table order
+		std::stable_sort(_byName.begin(), _byName.end(), [](const NamedEntry& lhs, const NamedEntry& rhs)
+		{
+			return compareNoCase(lhs.name, rhs.name) < 0;
+		});
+		_byNameSorted = true;
+	}
+
+	auto it = std::lower_bound(_byName.begin(), _byName.end(), name, [](const NamedEntry& entry, const char *value)
+	{
+		return compareNoCase(entry.name, value) < 0;
+	});
+	for (; it != _byName.end() && compareNoCase(it->name, name) == 0; ++it)
+	{
+		if (std::find(_pending.begin(), _pending.end(), it->index) == _pending.end())
+		{
+			_pending.push_back(it->index);
+		}
+	}
+}
+
+const std::vector<int>& ETJump::CvarUpdateScheduler::nextFrame()
+{
+	_frame.clear();
+	_frame.insert(_frame.end(), _pending.begin(), _pending.end());
+	_pending.clear();
+	_frame.insert(_frame.end(), _everyFrame.begin(), _everyFrame.end());
+
+	auto count = std::min(static_cast<std::size_t>(_sliceSize), _roundRobin.size());
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		if (_roundRobinPosition >= _roundRobin.size())
+		{
+			_roundRobinPosition = 0;
+		}
+		_frame.push_back(_roundRobin[_roundRobinPosition++]);
+	}
+
+	return _frame;
+}
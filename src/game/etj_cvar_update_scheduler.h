@@ -0,0 +1,91 @@
+/*
+ * MIT License
+ * 
+ * Copyright (c) 2020 ETJump team <zero@etjump.com>
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace ETJump
+{
+	/**
+	 * Decides which entries of a module's cvar table are polled with
+	 * trap_Cvar_Update on a frame. Polling hundreds of cvars every frame
+	 * costs a syscall each, while most of them change a few times per
+	 * session, so only entries added as every frame cvars are polled on
+	 * each frame. The rest are polled a slice at a time in round-robin
+	 * order, and cvars set by the module itself are polled on the
+	 * following frame so that the module sees its own changes right away.
+	 */
+	class CvarUpdateScheduler
+	{
+	public:
+		static const int DefaultSliceSize = 32;
+
+		explicit CvarUpdateScheduler(int sliceSize = DefaultSliceSize);
+		~CvarUpdateScheduler();
+
+		/**
+		 * Removes all entries
+		 */
+		void clear();
+		/**
+		 * Adds a cvar table entry. The name must stay valid as long as
+		 * the entry is in the scheduler.
+		 * @param index index of the entry in the cvar table
+		 * @param name cvar name
+		 * @param everyFrame true if the entry is polled on every frame
+		 */
+		void add(int index, const char *name, bool everyFrame);
+		/**
+		 * Schedules every entry of the cvar to be polled on the next frame.
+		 * Unknown cvars are ignored.
+		 * @param name case insensitive cvar name
+		 */
+		void cvarSet(const char *name);
+		/**
+		 * Advances to the next frame.
+		 * @return table indices to poll on this frame. Stays valid until
+		 * the next call.
+		 */
+		const std::vector<int>& nextFrame();
+	private:
+		struct NamedEntry
+		{
+			const char *name;
+			int index;
+		};
+
+		int _sliceSize;
+		std::vector<int> _everyFrame;
+		std::vector<int> _roundRobin;
+		std::size_t _roundRobinPosition;
+		// sorted by name on first use, for cvarSet
+		std::vector<NamedEntry> _byName;
+		bool _byNameSorted;
+		std::vector<int> _pending;
+		std::vector<int> _frame;
+	};
+}
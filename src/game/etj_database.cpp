@@ -24,8 +24,11 @@
 
 #include "etj_database.h"
 #include "utilities.hpp"
+#include "etj_printer.h"
 #include <boost/format.hpp>
 #include <boost/algorithm/string.hpp>
+#include <algorithm>
+#include <iterator>
 
 Database::Database()
 {
@@ -260,28 +263,40 @@ bool Database::ListUsers(gentity_t *ent, int page)
 		return false;
 	}
 
-	ConstIdIterator it  = users_.get<0>().begin();
-	ConstIdIterator end = users_.get<0>().end();
-
 	ChatPrintTo(ent, "^3listusers: ^7check console for more information.");
-	BeginBufferPrint();
 
-	BufferPrint(ent, va("Listing page %d/%d\n", page, pages));
-	int    curr = 0;
+	// users are printed as the output is sent, continuing from the
+	// id of the previous user as users may be added in between
+	ConstIdIterator first = users_.get<0>().begin();
+	std::advance(first, std::min(i, size));
+
+	auto   header    = true;
+	auto   nextId    = first != users_.get<0>().end() ? first->get()->id : 0u;
+	auto   remaining = first != users_.get<0>().end() ? USERS_PER_PAGE : 0;
 	time_t t;
 	time(&t);
-	BufferPrint(ent, va("^7%-5s %-10s %-15s %-36s\n", "ID", "Level", "Last seen", "Name"));
-	while (it != end)
+	Printer::SendConsoleStream(ent ? ClientNum(ent) : Printer::CONSOLE_CLIENT_NUMBER,
+		[this, header, nextId, remaining, page, pages, t](std::string& output) mutable
 	{
-		if (curr >= i && curr < i + USERS_PER_PAGE)
+		if (header)
 		{
-			BufferPrint(ent, va("^7%-5d %-10d %-15s %-36s\n", it->get()->id, it->get()->level, (TimeStampDifferenceToString(static_cast<unsigned>(t) - it->get()->lastSeen) + " ago").c_str(), it->get()->name.c_str()));
+			header = false;
+			output += va("Listing page %d/%d\n", page, pages);
+			output += va("^7%-5s %-10s %-15s %-36s\n", "ID", "Level", "Last seen", "Name");
+			return true;
 		}
 
-		curr++;
-		it++;
-	}
-	FinishBufferPrint(ent, false);
+		ConstIdIterator it = users_.get<0>().lower_bound(nextId);
+		if (remaining <= 0 || it == users_.get<0>().end())
+		{
+			return false;
+		}
+
+		output += va("^7%-5d %-10d %-15s %-36s\n", it->get()->id, it->get()->level, (TimeStampDifferenceToString(static_cast<unsigned>(t) - it->get()->lastSeen) + " ago").c_str(), it->get()->name.c_str());
+		nextId = it->get()->id + 1;
+		--remaining;
+		return true;
+	});
 
 	return true;
 }
@@ -343,32 +358,44 @@ bool Database::ListBans(gentity_t *ent, int page)
 	const int BANS_PER_PAGE = 10;
 	// 0-19, 20-39
 	int i       = (page - 1) * BANS_PER_PAGE;
-	int printed = 0;
 	int size    = bans_.size();
 	int pages   = (size / BANS_PER_PAGE) + 1;
 
 	if (page > pages)
 	{
 		ChatPrintTo(ent, "^3listbans: ^7no page #" + std::to_string(page));
+		return false;
 	}
 
 	ChatPrintTo(ent, "^3listbans: ^7check console for more information.");
-	BeginBufferPrint();
-	BufferPrint(ent, va("^7Showing page %d/%d\n", page, pages));
-	for (; i < size; i++, printed++)
+
+	auto header = true;
+	auto end    = i + BANS_PER_PAGE;
+	Printer::SendConsoleStream(ent ? ClientNum(ent) : Printer::CONSOLE_CLIENT_NUMBER,
+		[this, header, i, end, page, pages](std::string& output) mutable
 	{
-		if (printed == BANS_PER_PAGE)
+		if (header)
 		{
-			break;
+			header = false;
+			output += va("^7Showing page %d/%d\n", page, pages);
+			return true;
 		}
-		BufferPrint(ent, va("%d %s ^7%s %s %s %s\n",
-		                    bans_[i]->id, bans_[i]->name.c_str(),
-		                    bans_[i]->banDate.c_str(),
-		                    bans_[i]->bannedBy.c_str(),
-		                    bans_[i]->expires != 0 ? TimeStampToString(bans_[i]->expires).c_str() : "PERMANENTLY",
-		                    bans_[i]->reason.c_str()));
-	}
-	FinishBufferPrint(ent, false);
+
+		// bans may have been removed while printing
+		if (i >= end || i >= static_cast<int>(bans_.size()))
+		{
+			return false;
+		}
+
+		output += va("%d %s ^7%s %s %s %s\n",
+		             bans_[i]->id, bans_[i]->name.c_str(),
+		             bans_[i]->banDate.c_str(),
+		             bans_[i]->bannedBy.c_str(),
+		             bans_[i]->expires != 0 ? TimeStampToString(bans_[i]->expires).c_str() : "PERMANENTLY",
+		             bans_[i]->reason.c_str());
+		++i;
+		return true;
+	});
 	return true;
 }
 
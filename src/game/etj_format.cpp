@@ -0,0 +1,437 @@
+/*
+ * MIT License
+ * 
+ * Copyright (c) 2020 ETJump team <zero@etjump.com>
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <cstdio>
+#include <cstring>
+
+#include "etj_format.h"
+
+ETJump::FormatOutput::FormatOutput(char *storage, std::size_t capacity) :
+	_storage(storage), _capacity(capacity), _length(0), _overflowed(false)
+{
+	_storage[0] = '\0';
+}
+
+ETJump::FormatOutput::~FormatOutput()
+{
+}
+
+void ETJump::FormatOutput::overflow()
+{
+	_overflow.reserve(_capacity * 2);
+	_overflow.assign(_storage, _length);
+	_overflowed = true;
+}
+
+void ETJump::FormatOutput::append(const char *text, std::size_t length)
+{
+	if (!_overflowed && _length + length >= _capacity)
+	{
+		overflow();
+	}
+
+	if (_overflowed)
+	{
+		_overflow.append(text, length);
+	}
+	else
+	{
+		memcpy(_storage + _length, text, length);
+		_storage[_length + length] = '\0';
+	}
+	_length += length;
+}
+
+void ETJump::FormatOutput::append(std::size_t count, char c)
+{
+	if (!_overflowed && _length + count >= _capacity)
+	{
+		overflow();
+	}
+
+	if (_overflowed)
+	{
+		_overflow.append(count, c);
+	}
+	else
+	{
+		memset(_storage + _length, c, count);
+		_storage[_length + count] = '\0';
+	}
+	_length += count;
+}
+
+void ETJump::FormatOutput::clear()
+{
+	_overflow.clear();
+	_overflowed = false;
+	_length     = 0;
+	_storage[0] = '\0';
+}
+
+const char *ETJump::FormatOutput::c_str() const
+{
+	return _overflowed ? _overflow.c_str() : _storage;
+}
+
+std::size_t ETJump::FormatOutput::length() const
+{
+	return _length;
+}
+
+std::string ETJump::FormatOutput::str() const
+{
+	return _overflowed ? _overflow : std::string(_storage, _length);
+}
+
+ETJump::FormatArgument::FormatArgument() : type(Type::None), signedValue(0), string(nullptr), length(0)
+{
+}
+
+ETJump::FormatArgument ETJump::makeFormatArgument(char value)
+{
+	FormatArgument argument;
+	argument.type      = FormatArgument::Type::Char;
+	argument.charValue = value;
+	return argument;
+}
+
+ETJump::FormatArgument ETJump::makeFormatArgument(bool value)
+{
+	FormatArgument argument;
+	argument.type          = FormatArgument::Type::Unsigned;
+	argument.unsignedValue = value ? 1 : 0;
+	return argument;
+}
+
+ETJump::FormatArgument ETJump::makeFormatArgument(const char *value)
+{
+	FormatArgument argument;
+	argument.type   = FormatArgument::Type::String;
+	argument.string = value ? value : "(null)";
+	argument.length = strlen(argument.string);
+	return argument;
+}
+
+ETJump::FormatArgument ETJump::makeFormatArgument(const std::string& value)
+{
+	FormatArgument argument;
+	argument.type   = FormatArgument::Type::String;
+	argument.string = value.c_str();
+	argument.length = value.length();
+	return argument;
+}
+
+namespace
+{
+	struct ConversionSpec
+	{
+		char flags[8];
+		int  width;
+		int  precision;
+		char conversion;
+	};
+
+	// parses the conversion after '%', returns the character after it
+	const char *parseConversion(const char *fmt, ConversionSpec& spec)
+	{
+		auto numFlags = 0;
+		while (*fmt == '-' || *fmt == '+' || *fmt == ' ' || *fmt == '#' || *fmt == '0')
+		{
+			if (numFlags < static_cast<int>(sizeof(spec.flags)) - 1)
+			{
+				spec.flags[numFlags++] = *fmt;
+			}
+			++fmt;
+		}
+		spec.flags[numFlags] = '\0';
+
+		spec.width = -1;
+		while (*fmt >= '0' && *fmt <= '9')
+		{
+			spec.width = (spec.width < 0 ? 0 : spec.width * 10) + (*fmt - '0');
+			++fmt;
+		}
+
+		spec.precision = -1;
+		if (*fmt == '.')
+		{
+			spec.precision = 0;
+			++fmt;
+			while (*fmt >= '0' && *fmt <= '9')
+			{
+				spec.precision = spec.precision * 10 + (*fmt - '0');
+				++fmt;
+			}
+		}
+
+		// arguments are converted by their type, length modifiers don't matter
+		while (*fmt == 'h' || *fmt == 'l' || *fmt == 'L' || *fmt == 'q' || *fmt == 'j' || *fmt == 'z' || *fmt == 't')
+		{
+			++fmt;
+		}
+
+		spec.conversion = *fmt;
+		return *fmt ? fmt + 1 : fmt;
+	}
+
+	bool hasFlag(const ConversionSpec& spec, char flag)
+	{
+		return strchr(spec.flags, flag) != nullptr;
+	}
+
+	void appendPadded(ETJump::FormatOutput& output, const ConversionSpec& spec, const char *text, std::size_t length)
+	{
+		std::size_t padding = spec.width > static_cast<int>(length) ? spec.width - length : 0;
+		if (!hasFlag(spec, '-'))
+		{
+			output.append(padding, ' ');
+		}
+		output.append(text, length);
+		if (hasFlag(spec, '-'))
+		{
+			output.append(padding, ' ');
+		}
+	}
+
+	// formats a single number with snprintf using the given conversion and length modifier
+	template <typename T>
+	void appendNumber(ETJump::FormatOutput& output, const ConversionSpec& spec, const char *length, char conversion, T value)
+	{
+		char format[32];
+		auto pos = 0;
+		format[pos++] = '%';
+		for (auto flag = spec.flags; *flag; ++flag)
+		{
+			format[pos++] = *flag;
+		}
+		if (spec.width >= 0)
+		{
+			pos += snprintf(format + pos, sizeof(format) - pos, "%d", spec.width);
+		}
+		if (spec.precision >= 0)
+		{
+			pos += snprintf(format + pos, sizeof(format) - pos, ".%d", spec.precision);
+		}
+		for (; *length; ++length)
+		{
+			format[pos++] = *length;
+		}
+		format[pos++] = conversion;
+		format[pos]   = '\0';
+
+		char buffer[128];
+		auto written = snprintf(buffer, sizeof(buffer), format, value);
+		if (written < 0)
+		{
+			return;
+		}
+
+		if (written < static_cast<int>(sizeof(buffer)))
+		{
+			output.append(buffer, written);
+			return;
+		}
+
+		// wider than the buffer, only happens with huge widths or precisions
+		std::string large(written + 1, '\0');
+		snprintf(&large[0], large.size(), format, value);
+		output.append(large.c_str(), written);
+	}
+
+	// plain decimal conversions are the common case and don't need snprintf
+	bool isPlainDecimal(const ConversionSpec& spec)
+	{
+		for (auto flag = spec.flags; *flag; ++flag)
+		{
+			if (*flag != '0' && *flag != '-')
+			{
+				return false;
+			}
+		}
+		return spec.precision < 0;
+	}
+
+	void appendDecimal(ETJump::FormatOutput& output, const ConversionSpec& spec, bool negative, unsigned long long magnitude)
+	{
+		char digits[24];
+		auto end   = digits + sizeof(digits);
+		auto begin = end;
+		do
+		{
+			*--begin   = static_cast<char>('0' + magnitude % 10);
+			magnitude /= 10;
+		}
+		while (magnitude);
+
+		std::size_t length  = (end - begin) + (negative ? 1 : 0);
+		std::size_t padding = spec.width > static_cast<int>(length) ? spec.width - length : 0;
+		auto leftAlign = hasFlag(spec, '-');
+		auto zeroPad   = !leftAlign && hasFlag(spec, '0');
+
+		if (!leftAlign && !zeroPad)
+		{
+			output.append(padding, ' ');
+		}
+		if (negative)
+		{
+			output.append("-", 1);
+		}
+		if (zeroPad)
+		{
+			output.append(padding, '0');
+		}
+		output.append(begin, end - begin);
+		if (leftAlign)
+		{
+			output.append(padding, ' ');
+		}
+	}
+
+	void formatArgument(ETJump::FormatOutput& output, const ConversionSpec& spec, const ETJump::FormatArgument& argument)
+	{
+		typedef ETJump::FormatArgument::Type Type;
+
+		auto conversion = spec.conversion;
+		switch (argument.type)
+		{
+		case Type::Signed:
+			if (conversion == 'c')
+			{
+				auto c = static_cast<char>(argument.signedValue);
+				appendPadded(output, spec, &c, 1);
+			}
+			else if (ETJump::isFloatConversion(conversion))
+			{
+				appendNumber(output, spec, "", conversion, static_cast<double>(argument.signedValue));
+			}
+			else if (conversion == 'x' || conversion == 'X' || conversion == 'o' || conversion == 'u')
+			{
+				appendNumber(output, spec, "ll", conversion, static_cast<unsigned long long>(argument.signedValue));
+			}
+			else if (isPlainDecimal(spec))
+			{
+				auto negative = argument.signedValue < 0;
+				// negated as unsigned so that the smallest value doesn't overflow
+				auto magnitude = static_cast<unsigned long long>(argument.signedValue);
+				appendDecimal(output, spec, negative, negative ? 0 - magnitude : magnitude);
+			}
+			else
+			{
+				appendNumber(output, spec, "ll", 'd', argument.signedValue);
+			}
+			break;
+		case Type::Unsigned:
+			if (conversion == 'c')
+			{
+				auto c = static_cast<char>(argument.unsignedValue);
+				appendPadded(output, spec, &c, 1);
+			}
+			else if (ETJump::isFloatConversion(conversion))
+			{
+				appendNumber(output, spec, "", conversion, static_cast<double>(argument.unsignedValue));
+			}
+			else if (conversion == 'x' || conversion == 'X' || conversion == 'o')
+			{
+				appendNumber(output, spec, "ll", conversion, argument.unsignedValue);
+			}
+			else if (isPlainDecimal(spec))
+			{
+				appendDecimal(output, spec, false, argument.unsignedValue);
+			}
+			else
+			{
+				appendNumber(output, spec, "ll", 'u', argument.unsignedValue);
+			}
+			break;
+		case Type::Float:
+			// like boost::format, non float conversions print the value as is
+			appendNumber(output, spec, "", ETJump::isFloatConversion(conversion) ? conversion : 'g', argument.floatValue);
+			break;
+		case Type::Char:
+			if (conversion == 'c' || conversion == 's')
+			{
+				appendPadded(output, spec, &argument.charValue, 1);
+			}
+			else
+			{
+				appendNumber(output, spec, "", 'd', static_cast<int>(argument.charValue));
+			}
+			break;
+		case Type::String:
+		{
+			auto length = argument.length;
+			if (spec.precision >= 0 && static_cast<std::size_t>(spec.precision) < length)
+			{
+				length = spec.precision;
+			}
+			appendPadded(output, spec, argument.string, length);
+			break;
+		}
+		case Type::None:
+			break;
+		}
+	}
+}
+
+void ETJump::formatArguments(FormatOutput& output, const char *fmt, const FormatArgument *arguments, std::size_t count)
+{
+	std::size_t argument = 0;
+	while (*fmt)
+	{
+		auto literal = fmt;
+		while (*fmt && *fmt != '%')
+		{
+			++fmt;
+		}
+		if (fmt != literal)
+		{
+			output.append(literal, fmt - literal);
+		}
+
+		if (!*fmt)
+		{
+			break;
+		}
+
+		if (fmt[1] == '%')
+		{
+			output.append("%", 1);
+			fmt += 2;
+			continue;
+		}
+
+		ConversionSpec spec;
+		fmt = parseConversion(fmt + 1, spec);
+		if (!spec.conversion)
+		{
+			break;
+		}
+
+		if (argument < count)
+		{
+			formatArgument(output, spec, arguments[argument++]);
+		}
+	}
+}
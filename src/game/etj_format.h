@@ -0,0 +1,306 @@
+/*
+ * MIT License
+ * 
+ * Copyright (c) 2020 ETJump team <zero@etjump.com>
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <type_traits>
+
+namespace ETJump
+{
+	/**
+	 * Output of the formatting functions. Text is written to the storage
+	 * of the derived class and only moves to a heap allocated string if
+	 * it doesn't fit.
+	 */
+	class FormatOutput
+	{
+	public:
+		FormatOutput(const FormatOutput&) = delete;
+		FormatOutput& operator=(const FormatOutput&) = delete;
+
+		void append(const char *text, std::size_t length);
+		void append(std::size_t count, char c);
+		void clear();
+
+		const char *c_str() const;
+		std::size_t length() const;
+		std::string str() const;
+	protected:
+		FormatOutput(char *storage, std::size_t capacity);
+		~FormatOutput();
+	private:
+		void overflow();
+
+		char        *_storage;
+		std::size_t _capacity;
+		std::size_t _length;
+		bool        _overflowed;
+		std::string _overflow;
+	};
+
+	template <std::size_t Size = 256>
+	class FormatBuffer : public FormatOutput
+	{
+		static_assert(Size > 0, "format buffer needs room for the terminating null character");
+	public:
+		FormatBuffer() : FormatOutput(_data, Size)
+		{
+		}
+	private:
+		char _data[Size];
+	};
+
+	struct FormatArgument
+	{
+		enum class Type
+		{
+			None,
+			Signed,
+			Unsigned,
+			Float,
+			Char,
+			String
+		};
+
+		FormatArgument();
+
+		Type type;
+		union
+		{
+			long long          signedValue;
+			unsigned long long unsignedValue;
+			double             floatValue;
+			char               charValue;
+		};
+		const char  *string;
+		std::size_t length;
+	};
+
+	FormatArgument makeFormatArgument(char value);
+	FormatArgument makeFormatArgument(bool value);
+	FormatArgument makeFormatArgument(const char *value);
+	FormatArgument makeFormatArgument(const std::string& value);
+
+	template <typename T>
+	typename std::enable_if<std::is_integral<T>::value && std::is_signed<T>::value, FormatArgument>::type
+	makeFormatArgument(T value)
+	{
+		FormatArgument argument;
+		argument.type        = FormatArgument::Type::Signed;
+		argument.signedValue = value;
+		return argument;
+	}
+
+	template <typename T>
+	typename std::enable_if<std::is_integral<T>::value && std::is_unsigned<T>::value, FormatArgument>::type
+	makeFormatArgument(T value)
+	{
+		FormatArgument argument;
+		argument.type          = FormatArgument::Type::Unsigned;
+		argument.unsignedValue = value;
+		return argument;
+	}
+
+	template <typename T>
+	typename std::enable_if<std::is_floating_point<T>::value, FormatArgument>::type
+	makeFormatArgument(T value)
+	{
+		FormatArgument argument;
+		argument.type       = FormatArgument::Type::Float;
+		argument.floatValue = static_cast<double>(value);
+		return argument;
+	}
+
+	template <typename T>
+	typename std::enable_if<std::is_enum<T>::value, FormatArgument>::type
+	makeFormatArgument(T value)
+	{
+		return makeFormatArgument(static_cast<typename std::underlying_type<T>::type>(value));
+	}
+
+	/**
+	 * Formats printf style conversions. Arguments are converted by their
+	 * type like boost::format does, e.g. %s prints numbers and %d prints
+	 * strings. Conversions without an argument print nothing.
+	 */
+	void formatArguments(FormatOutput& output, const char *fmt, const FormatArgument *arguments, std::size_t count);
+
+	template <typename... Targs>
+	void formatTo(FormatOutput& output, const char *fmt, const Targs&... args)
+	{
+		// the extra argument keeps the array from being empty
+		const FormatArgument arguments[] = { makeFormatArgument(args)..., FormatArgument() };
+		formatArguments(output, fmt, arguments, sizeof...(Targs));
+	}
+
+	template <typename... Targs>
+	std::string stringFormat(const char *fmt, const Targs&... args)
+	{
+		FormatBuffer<> buffer;
+		formatTo(buffer, fmt, args...);
+		return buffer.str();
+	}
+
+	template <typename... Targs>
+	std::string stringFormat(const std::string& fmt, const Targs&... args)
+	{
+		return stringFormat(fmt.c_str(), args...);
+	}
+
+	///////////////////////////////////////////////////////////////////////////
+	// Compile time checks for format string literals
+	///////////////////////////////////////////////////////////////////////////
+
+	constexpr bool isFormatSpecifier(char c)
+	{
+		return c == '-' || c == '+' || c == ' ' || c == '#' || c == '.' || (c >= '0' && c <= '9') ||
+		       c == 'h' || c == 'l' || c == 'L' || c == 'q' || c == 'j' || c == 'z' || c == 't';
+	}
+
+	// skips flags, width, precision and length modifiers
+	constexpr const char *skipFormatSpecifiers(const char *spec)
+	{
+		return isFormatSpecifier(*spec) ? skipFormatSpecifiers(spec + 1) : spec;
+	}
+
+	// returns the conversion character of the next conversion, or the terminating null
+	constexpr const char *nextConversion(const char *fmt)
+	{
+		return *fmt == '\0' ? fmt
+		       : *fmt != '%' ? nextConversion(fmt + 1)
+		       : fmt[1] == '%' ? nextConversion(fmt + 2)
+		       : skipFormatSpecifiers(fmt + 1);
+	}
+
+	constexpr bool isIntegerConversion(char c)
+	{
+		return c == 'd' || c == 'i' || c == 'u' || c == 'x' || c == 'X' || c == 'o' || c == 'c';
+	}
+
+	constexpr bool isFloatConversion(char c)
+	{
+		return c == 'f' || c == 'F' || c == 'e' || c == 'E' || c == 'g' || c == 'G' || c == 'a' || c == 'A';
+	}
+
+	template <typename T, typename Enable = void>
+	struct FormatConversion
+	{
+		static constexpr bool accepts(char)
+		{
+			return false;
+		}
+	};
+
+	template <typename T>
+	struct FormatConversion<T, typename std::enable_if<std::is_integral<T>::value || std::is_enum<T>::value>::type>
+	{
+		static constexpr bool accepts(char c)
+		{
+			return isIntegerConversion(c);
+		}
+	};
+
+	template <typename T>
+	struct FormatConversion<T, typename std::enable_if<std::is_floating_point<T>::value>::type>
+	{
+		static constexpr bool accepts(char c)
+		{
+			return isFloatConversion(c);
+		}
+	};
+
+	template <typename T>
+	struct FormatConversion<T, typename std::enable_if<std::is_same<T, char *>::value || std::is_same<T, const char *>::value || std::is_same<T, std::string>::value>::type>
+	{
+		static constexpr bool accepts(char c)
+		{
+			return c == 's';
+		}
+	};
+
+	template <typename... Ts>
+	struct FormatTypes
+	{
+	};
+
+	// only used in decltype to get the decayed argument types
+	template <typename... Ts>
+	FormatTypes<typename std::decay<Ts>::type...> formatTypes(const Ts&...);
+
+	template <typename Types>
+	struct FormatMatcher;
+
+	template <>
+	struct FormatMatcher<FormatTypes<>>
+	{
+		static constexpr bool matches(const char *fmt)
+		{
+			return *nextConversion(fmt) == '\0';
+		}
+	};
+
+	template <typename T, typename... Ts>
+	struct FormatMatcher<FormatTypes<T, Ts...>>
+	{
+		static constexpr bool matches(const char *fmt)
+		{
+			return matchesConversion(nextConversion(fmt));
+		}
+
+		static constexpr bool matchesConversion(const char *conversion)
+		{
+			return *conversion != '\0' && FormatConversion<T>::accepts(*conversion) &&
+			       FormatMatcher<FormatTypes<Ts...>>::matches(conversion + 1);
+		}
+	};
+
+	template <bool Matches>
+	struct CheckedFormat
+	{
+		static_assert(Matches, "format string doesn't match the argument types");
+
+		template <typename... Targs>
+		static void to(FormatOutput& output, const char *fmt, const Targs&... args)
+		{
+			formatTo(output, fmt, args...);
+		}
+
+		template <typename... Targs>
+		static std::string string(const char *fmt, const Targs&... args)
+		{
+			return stringFormat(fmt, args...);
+		}
+	};
+}
+
+/**
+ * Same as ETJump::formatTo and ETJump::stringFormat, but the format string
+ * literal is checked against the argument types at compile time.
+ */
+#define ETJUMP_FORMAT_TO(output, fmt, ...) \
+	ETJump::CheckedFormat<ETJump::FormatMatcher<decltype(ETJump::formatTypes(__VA_ARGS__))>::matches(fmt)>::to(output, fmt, __VA_ARGS__)
+#define ETJUMP_FORMAT(fmt, ...) \
+	ETJump::CheckedFormat<ETJump::FormatMatcher<decltype(ETJump::formatTypes(__VA_ARGS__))>::matches(fmt)>::string(fmt, __VA_ARGS__)
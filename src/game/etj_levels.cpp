@@ -27,12 +27,79 @@
 #include "etj_local.h"
 #include "utilities.hpp"
 
+Levels::PermissionMask::PermissionMask() : endsInDenyMode(false)
+{
+}
+
+Levels::PermissionMask Levels::ParsePermissions(const std::string& commands, bool startInDenyMode)
+{
+	PermissionMask mask;
+	auto           deny = startInDenyMode;
+
+	for (auto c : commands)
+	{
+		auto flag = static_cast<unsigned char>(c);
+		if (!deny)
+		{
+			if (c == '*')
+			{
+				// Allow all commands
+				mask.allowed.set();
+				mask.denied.reset();
+			}
+			else if (c == '+')
+			{
+				// ignore +
+				continue;
+			}
+			else if (c == '-')
+			{
+				deny = true;
+			}
+			else
+			{
+				mask.allowed.set(flag);
+				mask.denied.reset(flag);
+			}
+		}
+		else
+		{
+			if (c == '*')
+			{
+				// Ignore * while in deny-mode
+				continue;
+			}
+
+			if (c == '+')
+			{
+				deny = false;
+			}
+			else
+			{
+				mask.allowed.reset(flag);
+				mask.denied.set(flag);
+			}
+		}
+	}
+
+	mask.endsInDenyMode = deny;
+	return mask;
+}
+
 Levels::Level::Level(int level, std::string const& name, std::string const& greeting, std::string const& commands)
 {
 	this->level    = level;
 	this->name     = name;
 	this->greeting = greeting;
 	this->commands = commands;
+	UpdatePermissions();
+}
+
+void Levels::Level::UpdatePermissions()
+{
+	auto mask = ParsePermissions(commands, false);
+	permissions              = mask.allowed;
+	permissionsEndInDenyMode = mask.endsInDenyMode;
 }
 
 Levels::Levels()
@@ -54,7 +121,7 @@ bool Levels::Add(int level, std::string const name, std::string const commands,
 	}
 
 	std::shared_ptr<Level> levelPtr(new Level(level, name, greeting, commands));
-	levels_.push_back(levelPtr);
+	AddLevel(levelPtr);
 
 	if (!WriteToConfig())
 	{
@@ -90,18 +157,19 @@ bool Levels::Edit(int level, std::string const& name, std::string const& command
 
 	if (updated & CMDS_UPDATED)
 	{
-		it->get()->commands = commands;
+		it->second->commands = commands;
+		it->second->UpdatePermissions();
 	}
 
 	if (updated & GREETING_UPDATED)
 	{
-		it->get()->greeting = greeting;
+		it->second->greeting = greeting;
 
 	}
 
 	if (updated & NAME_UPDATED)
 	{
-		it->get()->name = name;
+		it->second->name = name;
 
 	}
 
@@ -118,19 +186,19 @@ bool Levels::CreateDefaultLevels()
 
 	auto tempLevel = std::make_shared<Level>(0, "Visitor",
 	                                         "Welcome Visitor [n]^7! Your last visit was on [t]!", "a");
-	levels_.push_back(tempLevel);
+	AddLevel(tempLevel);
 
 	tempLevel = std::make_shared<Level>(1, "Friend",
 	                                    "Welcome Friend [n]^7! Your last visit was [d] ago!", "a");
-	levels_.push_back(tempLevel);
+	AddLevel(tempLevel);
 
 	tempLevel = std::make_shared<Level>(2, "Moderator",
 	                                    "Welcome Moderator [n]^7!", "*-Asv");
-	levels_.push_back(tempLevel);
+	AddLevel(tempLevel);
 
 	tempLevel = std::make_shared<Level>(3, "Administrator",
 	                                    "Welcome Administrator [n]^7!", "*");
-	levels_.push_back(tempLevel);
+	AddLevel(tempLevel);
 
 	if (!WriteToConfig())
 	{
@@ -154,9 +222,10 @@ void WriteInt(int toWrite, fileHandle_t& f)
 	trap_FS_Write("\n", 1, f);
 }
 
-bool Levels::SortByLevel(const std::shared_ptr<Level>& lhs, const std::shared_ptr<Level>& rhs)
+void Levels::AddLevel(const std::shared_ptr<Level>& level)
 {
-	return lhs->level < rhs->level;
+	// first definition of a level wins, same as when levels were searched linearly
+	levels_.insert(std::make_pair(level->level, level));
 }
 
 bool Levels::WriteToConfig()
@@ -164,21 +233,21 @@ bool Levels::WriteToConfig()
 	auto f = 0;
 	trap_FS_FOpenFile(g_levelConfig.string, &f, FS_WRITE);
 
-	sort(levels_.begin(), levels_.end(), SortByLevel);
+	// levels_ is ordered by level number
 	for (ConstIter it = levels_.begin(); it != levels_.end(); ++it)
 	{
 		trap_FS_Write("[level]\n", 8, f);
 		trap_FS_Write("level = ", 8, f);
-		WriteInt(it->get()->level, f);
+		WriteInt(it->second->level, f);
 
 		trap_FS_Write("name = ", 7, f);
-		WriteString(it->get()->name.c_str(), f);
+		WriteString(it->second->name.c_str(), f);
 
 		trap_FS_Write("cmds = ", 7, f);
-		WriteString(it->get()->commands.c_str(), f);
+		WriteString(it->second->commands.c_str(), f);
 
 		trap_FS_Write("greeting = ", 11, f);
-		WriteString(it->get()->greeting.c_str(), f);
+		WriteString(it->second->greeting.c_str(), f);
 		trap_FS_Write("\n", 1, f);
 	}
 
@@ -188,17 +257,12 @@ bool Levels::WriteToConfig()
 
 Levels::Level const *Levels::GetLevel(int level)
 {
-	auto it  = levels_.begin();
-	auto end = levels_.end();
-	for (; it != end; ++it)
+	auto it = levels_.find(level);
+	if (it != levels_.end())
 	{
-		if (it->get()->level == level)
-		{
-			return it->get();
-		}
+		return it->second.get();
 	}
 
-
 	return dummyLevel_.get();
 }
 
@@ -212,46 +276,33 @@ void Levels::PrintLevelInfo(gentity_t *ent)
 	BufferPrint(ent, "Levels: ");
 	for (; it != end; ++it)
 	{
-		if (it + 1 == end)
+		if (std::next(it) == end)
 		{
-			BufferPrint(ent, va("%d", (*it)->level));
+			BufferPrint(ent, va("%d", it->second->level));
 			FinishBufferPrint(ent, true);
 			return;
 		}
-		BufferPrint(ent, va("%d, ", it->get()->level));
+		BufferPrint(ent, va("%d, ", it->second->level));
 	}
 }
 
 void Levels::PrintLevelInfo(gentity_t *ent, int level)
 {
-	auto it  = levels_.begin();
-	auto end = levels_.end();
+	auto it = levels_.find(level);
 
-	for (; it != end; ++it)
+	if (it != levels_.end())
 	{
-		if (it->get()->level == level)
-		{
-			ChatPrintTo(ent, "^3levelinfo: ^7check console for more information.");
-			ConsolePrintTo(ent, va("^5Level: ^7%d\n^5Name: ^7%s\n^5Commands: ^7%s\n^5Greeting: ^7%s",
-			                       level, it->get()->name.c_str(), it->get()->commands.c_str(), it->get()->greeting.c_str()));
-			return;
-		}
+		ChatPrintTo(ent, "^3levelinfo: ^7check console for more information.");
+		ConsolePrintTo(ent, va("^5Level: ^7%d\n^5Name: ^7%s\n^5Commands: ^7%s\n^5Greeting: ^7%s",
+		                       level, it->second->name.c_str(), it->second->commands.c_str(), it->second->greeting.c_str()));
+		return;
 	}
 	ChatPrintTo(ent, "^3levelinfo: ^7undefined level: " + std::to_string(level));
 }
 
 bool Levels::LevelExists(int level) const
 {
-	auto it = levels_.begin();
-
-	for (; it != levels_.end(); ++it)
-	{
-		if (it->get()->level == level)
-		{
-			return true;
-		}
-	}
-	return false;
+	return levels_.find(level) != levels_.end();
 }
 
 void Levels::PrintLevels()
@@ -262,10 +313,10 @@ void Levels::PrintLevels()
 
 	for (; it != levels_.end(); ++it)
 	{
-		level += it->get()->level + "\n" +
-		         it->get()->name + "\n" +
-		         it->get()->commands + "\n" +
-		         it->get()->greeting + "\n";
+		level += it->second->level + "\n" +
+		         it->second->name + "\n" +
+		         it->second->commands + "\n" +
+		         it->second->greeting + "\n";
 
 		G_LogPrintf(level.c_str());
 
@@ -280,28 +331,12 @@ std::string Levels::ErrorMessage() const
 
 Levels::ConstIter Levels::FindConst(int level)
 {
-	ConstIter it = levels_.begin();
-	for (; it != levels_.end(); ++it)
-	{
-		if (it->get()->level == level)
-		{
-			return it;
-		}
-	}
-	return it;
+	return levels_.find(level);
 }
 
 Levels::Iter Levels::Find(int level)
 {
-	auto it = levels_.begin();
-	for (; it != levels_.end(); ++it)
-	{
-		if (it->get()->level == level)
-		{
-			return it;
-		}
-	}
-	return it;
+	return levels_.find(level);
 }
 
 void ReadInt(char **configFile, int& level)
@@ -385,7 +420,8 @@ bool Levels::ReadFromConfig()
 		{
 			if (levelOpen)
 			{
-				levels_.push_back(tempLevel);
+				tempLevel->UpdatePermissions();
+				AddLevel(tempLevel);
 			}
 			levelOpen = false;
 		}
@@ -431,7 +467,8 @@ bool Levels::ReadFromConfig()
 
 	if (levelOpen)
 	{
-		levels_.push_back(tempLevel);
+		tempLevel->UpdatePermissions();
+		AddLevel(tempLevel);
 	}
 	return true;
 }
@@ -32,22 +32,47 @@ typedef gentity_s gentity_t;
 #endif
 
 #include <string>
-#include <vector>
+#include <map>
 #include <memory>
+#include <bitset>
 
 class Levels
 {
 public:
+	static const unsigned MAX_COMMANDS = 256;
+
+	// Command flags explicitly allowed and denied by a permission string
+	// such as "*-Asv". Applying it on top of other permissions is just
+	// (permissions & ~denied) | allowed.
+	struct PermissionMask
+	{
+		PermissionMask();
+
+		std::bitset<MAX_COMMANDS> allowed;
+		std::bitset<MAX_COMMANDS> denied;
+		// whether the string ended in a '-' section. The user's own
+		// permissions are parsed as a continuation of the level's.
+		bool endsInDenyMode;
+	};
+
+	static PermissionMask ParsePermissions(const std::string& commands, bool startInDenyMode);
 
 	struct Level
 	{
 		Level(int level, const std::string& name, const std::string& greeting,
 		      const std::string& commands);
 
+		// must be called whenever commands changes
+		void UpdatePermissions();
+
 		int level;
 		std::string name;
 		std::string commands;
 		std::string greeting;
+
+		// commands, parsed
+		std::bitset<MAX_COMMANDS> permissions;
+		bool permissionsEndInDenyMode;
 	};
 
 	Levels();
@@ -57,7 +82,6 @@ public:
 	bool Edit(int level, std::string const& name, std::string const& commands, std::string const& greeting, int updated);
 	bool Delete(int level);
 	bool ReadFromConfig();
-	static bool SortByLevel(const std::shared_ptr<Level>& lhs, const std::shared_ptr<Level>& rhs);
 	bool WriteToConfig();
 	std::string ErrorMessage() const;
 	void PrintLevels();
@@ -67,12 +91,14 @@ public:
 	void PrintLevelInfo(gentity_t *ent, int level);
 
 private:
-	typedef std::vector< std::shared_ptr< Level > >::const_iterator ConstIter;
-	typedef std::vector< std::shared_ptr< Level > >::iterator Iter;
+	typedef std::map< int, std::shared_ptr< Level > >::const_iterator ConstIter;
+	typedef std::map< int, std::shared_ptr< Level > >::iterator Iter;
 	bool CreateDefaultLevels();
+	void AddLevel(const std::shared_ptr<Level>& level);
 	ConstIter FindConst(int level);
 	Iter Find(int level);
-	std::vector< std::shared_ptr< Level > > levels_;
+	// keyed by level number
+	std::map< int, std::shared_ptr< Level > > levels_;
 	std::string                             errorMessage;
 	std::shared_ptr<Level>                  dummyLevel_;
 };
@@ -0,0 +1,161 @@
+/*
+ * MIT License
+ * 
+ * Copyright (c) 2020 ETJump team <zero@etjump.com>
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <memory>
+
+#include "etj_paced_printer.h"
+
+const std::size_t ETJump::PacedPrinter::MaxPacketLength;
+const int ETJump::PacedPrinter::DefaultPacketsPerFrame;
+
+ETJump::PacedPrinter::PacedPrinter(int maxClients, SendText sendText, int packetsPerFrame) :
+	_sendText(sendText), _clients(maxClients > 0 ? maxClients : 0), _packetsPerFrame(packetsPerFrame)
+{
+}
+
+ETJump::PacedPrinter::~PacedPrinter()
+{
+}
+
+void ETJump::PacedPrinter::print(int clientNum, Producer producer)
+{
+	if (clientNum < 0 || clientNum >= static_cast<int>(_clients.size()))
+	{
+		return;
+	}
+
+	_clients[clientNum].producers.push_back(producer);
+}
+
+void ETJump::PacedPrinter::print(int clientNum, const std::string& text)
+{
+	auto remaining = std::make_shared<std::string>(text);
+	print(clientNum, [remaining](std::string& output)
+	{
+		if (remaining->empty())
+		{
+			return false;
+		}
+
+		output += *remaining;
+		remaining->clear();
+		return true;
+	});
+}
+
+bool ETJump::PacedPrinter::cancel(int clientNum)
+{
+	if (!isPrinting(clientNum))
+	{
+		return false;
+	}
+
+	_clients[clientNum] = Client();
+	return true;
+}
+
+bool ETJump::PacedPrinter::isPrinting(int clientNum) const
+{
+	if (clientNum < 0 || clientNum >= static_cast<int>(_clients.size()))
+	{
+		return false;
+	}
+
+	return !_clients[clientNum].producers.empty() || !_clients[clientNum].pending.empty();
+}
+
+bool ETJump::PacedPrinter::sendNext(int clientNum)
+{
+	if (clientNum < 0 || clientNum >= static_cast<int>(_clients.size()))
+	{
+		return false;
+	}
+
+	std::string packet;
+	if (!nextPacket(_clients[clientNum], packet))
+	{
+		return false;
+	}
+
+	_sendText(clientNum, packet);
+	return true;
+}
+
+bool ETJump::PacedPrinter::nextPacket(Client& client, std::string& packet)
+{
+	packet.clear();
+
+	while (packet.length() < MaxPacketLength)
+	{
+		if (client.pending.empty())
+		{
+			if (client.producers.empty())
+			{
+				break;
+			}
+
+			// a producer that returns without producing anything is done too,
+			// otherwise it could keep the loop going forever
+			if (!client.producers.front()(client.pending) || client.pending.empty())
+			{
+				client.producers.pop_front();
+			}
+			continue;
+		}
+
+		auto space = MaxPacketLength - packet.length();
+		if (client.pending.length() <= space)
+		{
+			packet += client.pending;
+			client.pending.clear();
+		}
+		else if (packet.empty())
+		{
+			// too long for a single packet, split at the last line break if there is one
+			auto lineEnd = client.pending.rfind('\n', space - 1);
+			auto length  = lineEnd == std::string::npos ? space : lineEnd + 1;
+			packet += client.pending.substr(0, length);
+			client.pending.erase(0, length);
+		}
+		else
+		{
+			break;
+		}
+	}
+
+	return !packet.empty();
+}
+
+void ETJump::PacedPrinter::runFrame()
+{
+	std::string packet;
+	for (auto clientNum = 0; clientNum < static_cast<int>(_clients.size()); ++clientNum)
+	{
+		auto& client = _clients[clientNum];
+		for (auto i = 0; i < _packetsPerFrame && nextPacket(client, packet); ++i)
+		{
+			_sendText(clientNum, packet);
+		}
+	}
+}
@@ -0,0 +1,91 @@
+/*
+ * MIT License
+ * 
+ * Copyright (c) 2020 ETJump team <zero@etjump.com>
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace ETJump
+{
+	/**
+	 * Sends long console output to clients a few packets per frame
+	 * instead of all at once. The output is produced lazily, so large
+	 * listings only build the lines that are about to be sent.
+	 */
+	class PacedPrinter
+	{
+	public:
+		// longest print payload, same as BYTES_PER_PACKET
+		static const std::size_t MaxPacketLength = 998;
+		static const int DefaultPacketsPerFrame = 1;
+
+		/**
+		 * Appends the next part of the output to text.
+		 * Returns false once there is nothing left to print.
+		 */
+		typedef std::function<bool(std::string& text)> Producer;
+		typedef std::function<void(int clientNum, const std::string& text)> SendText;
+
+		PacedPrinter(int maxClients, SendText sendText, int packetsPerFrame = DefaultPacketsPerFrame);
+		~PacedPrinter();
+
+		/**
+		 * Queues the output after anything the client is already receiving
+		 */
+		void print(int clientNum, Producer producer);
+		void print(int clientNum, const std::string& text);
+		/**
+		 * Drops the client's remaining output
+		 * @returns true if there was anything to drop
+		 */
+		bool cancel(int clientNum);
+		bool isPrinting(int clientNum) const;
+		/**
+		 * Sends the client's next packet right away
+		 * @returns true if there was anything to send
+		 */
+		bool sendNext(int clientNum);
+		/**
+		 * Sends the next packets to each client
+		 */
+		void runFrame();
+	private:
+		struct Client
+		{
+			std::deque<Producer> producers;
+			// produced text that didn't fit in the previous packet
+			std::string pending;
+		};
+
+		bool nextPacket(Client& client, std::string& packet);
+
+		SendText _sendText;
+		std::vector<Client> _clients;
+		int _packetsPerFrame;
+	};
+}
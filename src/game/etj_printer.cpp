@@ -25,9 +25,73 @@
 #include "etj_printer.h"
 #include <boost/format.hpp>
 #include "etj_string_utilities.h"
+#include "etj_reliable_command_queue.h"
 
 #include "g_local.h"
 
+typedef ETJump::ReliableCommandQueue::Priority Priority;
+
+namespace
+{
+	void queuePrint(int clientNum, Priority priority, const std::string& text)
+	{
+		if (ETJump::reliableCommandQueue)
+		{
+			ETJump::reliableCommandQueue->print(clientNum, priority, text);
+		}
+		else
+		{
+			trap_SendServerCommand(clientNum, va("print \"%s\"", text.c_str()));
+		}
+	}
+
+	void queueLeftPrint(int clientNum, Priority priority, const std::string& text)
+	{
+		if (ETJump::reliableCommandQueue)
+		{
+			ETJump::reliableCommandQueue->leftPrint(clientNum, priority, text);
+		}
+		else
+		{
+			trap_SendServerCommand(clientNum, va("cpm \"%s\"", text.c_str()));
+		}
+	}
+
+	void queueCommand(int clientNum, Priority priority, const std::string& command)
+	{
+		if (ETJump::reliableCommandQueue)
+		{
+			ETJump::reliableCommandQueue->command(clientNum, priority, command);
+		}
+		else
+		{
+			trap_SendServerCommand(clientNum, command.c_str());
+		}
+	}
+
+	// queues the message for every client in the game, or sends it
+	// right away if the queue doesn't exist. Clients that are still
+	// loading are skipped like the engine does for -1 broadcasts, they
+	// don't ack anything until they enter the game.
+	template <typename F>
+	void queueForAll(F queueFor)
+	{
+		if (!ETJump::reliableCommandQueue)
+		{
+			queueFor(-1);
+			return;
+		}
+
+		for (auto i = 0; i < level.maxclients; ++i)
+		{
+			if (level.clients[i].pers.connected == CON_CONNECTED)
+			{
+				queueFor(i);
+			}
+		}
+	}
+}
+
 void Printer::LogPrint(std::string message)
 {
 	std::string partialMessage;
@@ -59,11 +123,49 @@ void Printer::SendConsoleMessage(int clientNum, std::string message)
 		}
 		else
 		{
-			trap_SendServerCommand(clientNum, va("print \"%s\"", split.c_str()));
+			queuePrint(clientNum, Priority::Normal, split);
 		}
 	}
 }
 
+void Printer::SendConsoleStream(int clientNum, const std::string& message)
+{
+	if (clientNum == CONSOLE_CLIENT_NUMBER || !ETJump::pacedPrinter)
+	{
+		SendConsoleMessage(clientNum, message);
+		return;
+	}
+
+	// the first packet goes out right away so the output isn't sent after
+	// prints that come later in the same command, only the rest is paced
+	const auto idle = !ETJump::pacedPrinter->isPrinting(clientNum);
+	ETJump::pacedPrinter->print(clientNum, message);
+	if (idle)
+	{
+		ETJump::pacedPrinter->sendNext(clientNum);
+	}
+}
+
+void Printer::SendConsoleStream(int clientNum, const ETJump::PacedPrinter::Producer& producer)
+{
+	if (clientNum == CONSOLE_CLIENT_NUMBER || !ETJump::pacedPrinter)
+	{
+		std::string message;
+		while (producer(message))
+		{
+		}
+		SendConsoleMessage(clientNum, message);
+		return;
+	}
+
+	const auto idle = !ETJump::pacedPrinter->isPrinting(clientNum);
+	ETJump::pacedPrinter->print(clientNum, producer);
+	if (idle)
+	{
+		ETJump::pacedPrinter->sendNext(clientNum);
+	}
+}
+
 void Printer::SendChatMessage(int clientNum, const std::string &message)
 {
 	if (clientNum == CONSOLE_CLIENT_NUMBER)
@@ -84,7 +186,7 @@ void Printer::SendLeftMessage(int clientNum, const std::string &message)
 	}
 	else
 	{
-		trap_SendServerCommand(clientNum, va("cpm \"%s\"", message.c_str()));
+		queueLeftPrint(clientNum, Priority::Normal, message);
 	}
 }
 
@@ -93,7 +195,10 @@ void Printer::BroadcastConsoleMessage(std::string message)
 	auto splits = ETJump::splitString(message, '\n', BYTES_PER_PACKET);
 	for (auto &split : splits) 
 	{
-		trap_SendServerCommand(-1, va("print \"%s\"", split.c_str()));
+		queueForAll([&split](int clientNum)
+		{
+			queuePrint(clientNum, Priority::Normal, split);
+		});
 		G_Printf("%s", split.c_str());
 	}
 }
@@ -106,20 +211,30 @@ void Printer::BroadcastChatMessage(const std::string &message)
 
 void Printer::BroadcastLeftMessage(const std::string &message)
 {
-	trap_SendServerCommand(-1, va("cpm \"%s\n\"", message.c_str()));
+	queueForAll([&message](int clientNum)
+	{
+		queueLeftPrint(clientNum, Priority::Normal, message + "\n");
+	});
 	G_Printf("%s\n", message.c_str());
 }
 
 void Printer::BroadcastLeftBannerMessage(const std::string &message)
 {
-	trap_SendServerCommand(-1, va("cpm \"%s\n\"", message.c_str()));
+	queueForAll([&message](int clientNum)
+	{
+		queueLeftPrint(clientNum, Priority::Low, message + "\n");
+	});
 	G_Printf("%s\n", message.c_str());
 }
 
 void Printer::BroadCastBannerMessage(const boost::format &fmt)
 {
-	trap_SendServerCommand(-1, va("cpm \"%s\n\"", fmt.str().c_str()));
-	G_Printf("%s\n", fmt.str().c_str());
+	auto message = fmt.str();
+	queueForAll([&message](int clientNum)
+	{
+		queueLeftPrint(clientNum, Priority::Low, message + "\n");
+	});
+	G_Printf("%s\n", message.c_str());
 }
 
 void Printer::SendBannerMessage(int clientNum, const std::string &message)
@@ -130,18 +245,31 @@ void Printer::SendBannerMessage(int clientNum, const std::string &message)
 	}
 	else
 	{
-		trap_SendServerCommand(clientNum, va("cpm \"%s\n\"", message.c_str()));
+		queueLeftPrint(clientNum, Priority::Low, message + "\n");
 	}
 }
 
 void Printer::SendCommand(int clientNum, const std::string &command)
 {
-	trap_SendServerCommand(clientNum, command.c_str());
+	if (clientNum == CONSOLE_CLIENT_NUMBER)
+	{
+		queueForAll([&command](int target)
+		{
+			queueCommand(target, Priority::Command, command);
+		});
+		return;
+	}
+
+	queueCommand(clientNum, Priority::Command, command);
 }
 
 void Printer::BroadcastTopBannerMessage(const std::string& message)
 {
-	trap_SendServerCommand(-1, va("bp \"%s\n\"", message.c_str()));
+	std::string command = va("bp \"%s\n\"", message.c_str());
+	queueForAll([&command](int clientNum)
+	{
+		queueCommand(clientNum, Priority::Low, command);
+	});
 	G_Printf("%s\n", message.c_str());
 }
 
@@ -153,18 +281,23 @@ void Printer::BroadcastCenterMessage(const std::string& message)
 
 void Printer::SendCenterMessage(int clientNum, const std::string& message)
 {
-	trap_SendServerCommand(clientNum, (boost::format("cp \"%s\n\"") % message).str().c_str());
+	ETJump::FormatBuffer<> command;
+	ETJUMP_FORMAT_TO(command, "cp \"%s\n\"", message);
+	trap_SendServerCommand(clientNum, command.c_str());
 }
 
 void Printer::SendCommandToAll(const std::string& command)
 {
-	trap_SendServerCommand(-1, command.c_str());
+	queueForAll([&command](int clientNum)
+	{
+		queueCommand(clientNum, Priority::Command, command);
+	});
 }
 
 void Printer::SendCommand(std::vector<int> clientNums, const std::string &command)
 {
 	for (auto &clientNum : clientNums)
 	{
-		trap_SendServerCommand(clientNum, command.c_str());
+		queueCommand(clientNum, Priority::Command, command);
 	}
 }
@@ -35,6 +35,7 @@
 #include <string>
 #include <vector>
 #include <boost/format.hpp>
+#include "etj_paced_printer.h"
 
 class Printer {
 public:
@@ -61,6 +62,22 @@ public:
 	 */
 	static void SendConsoleMessage(int clientNum, std::string message);
 
+	/**
+	 * Prints to client console a few packets per frame so that long
+	 * listings don't overflow the client. If client num is -1 prints
+	 * everything to console right away.
+	 * @param clientNum The client to send the message to
+	 * @param message The message to be sent
+	 */
+	static void SendConsoleStream(int clientNum, const std::string& message);
+
+	/**
+	 * Same as above but the message is produced lazily, one part at a time
+	 * @param clientNum The client to send the message to
+	 * @param producer Appends the next part of the message, returns false when done
+	 */
+	static void SendConsoleStream(int clientNum, const ETJump::PacedPrinter::Producer& producer);
+
 	/**
 	 * Sends a console message to everyone in the server and to server console.
 	 * Will send multiple messages if the message is longer than 1000 bytes.
@@ -50,7 +50,7 @@ void ETJump::ProgressionTrackers::printParserErrors(const std::vector<std::strin
 	G_Error(buffer.c_str());
 }
 
-void ETJump::ProgressionTrackers::updateTracker(std::vector<ProgressionTrackerParser::IndexValuePair> pairs, int tracker[MaxProgressionTrackers])
+void ETJump::ProgressionTrackers::updateTracker(const std::vector<ProgressionTrackerParser::IndexValuePair>& pairs, TrackerValues& tracker)
 {
 	for (const auto & pair : pairs)
 	{
@@ -75,127 +75,216 @@ std::vector<ETJump::ProgressionTrackerParser::IndexValuePair> ETJump::Progressio
 	return parser.getParsedPairs();
 }
 
+ETJump::ProgressionTrackers::ProgressionTracker ETJump::ProgressionTrackers::compileTracker(const ParsedTracker& parsed)
+{
+	typedef Instruction::Operation Operation;
+
+	ProgressionTracker tracker;
+	auto               add = [](std::vector<Instruction>& instructions, int index, Operation operation, int operand)
+	{
+		Instruction instruction;
+		instruction.index     = index;
+		instruction.operation = operation;
+		instruction.operand   = operand;
+		instructions.push_back(instruction);
+	};
+
+	// instructions are emitted in index order, and for the same index
+	// set before increment, which is the order they used to be applied in
+	for (auto idx = 0; idx < MaxProgressionTrackers; ++idx)
+	{
+		auto modified = false;
+
+		if (parsed.set[idx] >= 0)
+		{
+			add(tracker.onUse, idx, Operation::Set, parsed.set[idx]);
+			modified = true;
+		}
+		if (parsed.increment[idx] != 0)
+		{
+			add(tracker.onUse, idx, Operation::Increment, parsed.increment[idx]);
+			modified = true;
+		}
+
+		if (parsed.equal[idx] != ProgressionTrackerValueNotSet)
+		{
+			add(tracker.conditions, idx, Operation::Equal, parsed.equal[idx]);
+		}
+		if (parsed.notEqual[idx] != ProgressionTrackerValueNotSet)
+		{
+			add(tracker.conditions, idx, Operation::NotEqual, parsed.notEqual[idx]);
+		}
+		if (parsed.lessThan[idx] != ProgressionTrackerValueNotSet)
+		{
+			add(tracker.conditions, idx, Operation::LessThan, parsed.lessThan[idx]);
+		}
+		if (parsed.greaterThan[idx] != ProgressionTrackerValueNotSet)
+		{
+			add(tracker.conditions, idx, Operation::GreaterThan, parsed.greaterThan[idx]);
+		}
+
+		if (parsed.setIf[idx] >= 0)
+		{
+			add(tracker.onActivate, idx, Operation::Set, parsed.setIf[idx]);
+			modified = true;
+		}
+		if (parsed.incrementIf[idx] != 0)
+		{
+			add(tracker.onActivate, idx, Operation::Increment, parsed.incrementIf[idx]);
+			modified = true;
+		}
+
+		if (modified)
+		{
+			tracker.modifiedIndices.push_back(idx);
+		}
+	}
+
+	return tracker;
+}
+
 int ETJump::ProgressionTrackers::registerTracker(ProgressionTrackerKeys keys)
 {
-	auto progressionTracker = ProgressionTracker();
-
-	updateTracker(parseKey(keys.equal), progressionTracker.equal);
-	updateTracker(parseKey(keys.notEqual), progressionTracker.notEqual);
-	updateTracker(parseKey(keys.greaterThan), progressionTracker.greaterThan);
-	updateTracker(parseKey(keys.lessThan), progressionTracker.lessThan);
-	updateTracker(parseKey(keys.set), progressionTracker.set);
-	updateTracker(parseKey(keys.setIf), progressionTracker.setIf);
-	updateTracker(parseKey(keys.increment), progressionTracker.increment);
-	updateTracker(parseKey(keys.incrementIf), progressionTracker.incrementIf);
-
-	_progressionTrackers.push_back(progressionTracker);
+	ParsedTracker parsed;
+
+	updateTracker(parseKey(keys.equal), parsed.equal);
+	updateTracker(parseKey(keys.notEqual), parsed.notEqual);
+	updateTracker(parseKey(keys.greaterThan), parsed.greaterThan);
+	updateTracker(parseKey(keys.lessThan), parsed.lessThan);
+	updateTracker(parseKey(keys.set), parsed.set);
+	updateTracker(parseKey(keys.setIf), parsed.setIf);
+	updateTracker(parseKey(keys.increment), parsed.increment);
+	updateTracker(parseKey(keys.incrementIf), parsed.incrementIf);
+
+	_progressionTrackers.push_back(compileTracker(parsed));
 	return _progressionTrackers.size() - 1;
 }
 
 namespace ETJump
 {
 	static std::unique_ptr<ProgressionTrackers> progressionTrackers;
-}
 
-
-void ETJump::ProgressionTrackers::useTracker(gentity_t *ent, gentity_t* activator, const ProgressionTracker& tracker)
-{
-	int values[MaxProgressionTrackers];
-	memcpy(values, activator->client->sess.progression, sizeof(values));
-
-	auto idx = 0;
-	for (auto & v : tracker.set)
+	static void runInstructions(const std::vector<ProgressionTrackers::Instruction>& instructions, int *progression)
 	{
-		if (v >= 0)
+		for (const auto & instruction : instructions)
 		{
-			activator->client->sess.progression[idx] = v;
+			if (instruction.operation == ProgressionTrackers::Instruction::Operation::Set)
+			{
+				progression[instruction.index] = instruction.operand;
+			}
+			else
+			{
+				progression[instruction.index] += instruction.operand;
+			}
 		}
-
-		++idx;
 	}
 
-	idx = 0;
-	for (auto & v : tracker.increment)
+	static bool conditionsHold(const std::vector<ProgressionTrackers::Instruction>& conditions, const int *progression)
 	{
-		if (v != 0)
+		typedef ProgressionTrackers::Instruction::Operation Operation;
+
+		for (const auto & condition : conditions)
 		{
-			activator->client->sess.progression[idx] += v;
+			auto clientTracker = progression[condition.index];
+
+			switch (condition.operation)
+			{
+			case Operation::Equal:
+				if (condition.operand != clientTracker)
+				{
+					return false;
+				}
+				break;
+			case Operation::NotEqual:
+				if (condition.operand == clientTracker)
+				{
+					return false;
+				}
+				break;
+			case Operation::LessThan:
+				if (condition.operand <= clientTracker)
+				{
+					return false;
+				}
+				break;
+			case Operation::GreaterThan:
+				if (condition.operand >= clientTracker)
+				{
+					return false;
+				}
+				break;
+			default:
+				break;
+			}
 		}
-		++idx;
-	}
 
-	auto activate = true;
+		return true;
+	}
+}
 
-	for (idx = 0; idx < MaxProgressionTrackers; ++idx)
-	{
-		auto clientTracker = activator->client->sess.progression[idx];
 
+void ETJump::ProgressionTrackers::useTracker(gentity_t *ent, gentity_t* activator, const ProgressionTracker& tracker)
+{
+	auto progression = activator->client->sess.progression;
+	auto debug       = g_debugTrackers.integer > 0;
+	int  values[MaxProgressionTrackers];
 
-		if ((tracker.equal[idx] != ProgressionTrackerValueNotSet && tracker.equal[idx] != clientTracker) ||
-			(tracker.notEqual[idx] != ProgressionTrackerValueNotSet && tracker.notEqual[idx] == clientTracker) ||
-			(tracker.lessThan[idx] != ProgressionTrackerValueNotSet && tracker.lessThan[idx] <= clientTracker) ||
-			(tracker.greaterThan[idx] != ProgressionTrackerValueNotSet && tracker.greaterThan[idx] >= clientTracker))
+	// only the indices this tracker modifies are logged
+	if (debug)
+	{
+		auto i = 0;
+		for (auto idx : tracker.modifiedIndices)
 		{
-			activate = false;
-			break;
+			values[i++] = progression[idx];
 		}
 	}
 
-	if (activate)
+	runInstructions(tracker.onUse, progression);
+
+	if (!conditionsHold(tracker.conditions, progression))
 	{
-		G_UseTargetedEntities(ent, activator);
+		return;
+	}
 
-		for (idx = 0; idx < MaxProgressionTrackers; ++idx)
-		{
-			if (tracker.setIf[idx] >= 0)
-			{
-				activator->client->sess.progression[idx] = tracker.setIf[idx];
-			}
+	G_UseTargetedEntities(ent, activator);
 
-			if (tracker.incrementIf[idx] != 0)
-			{
-				activator->client->sess.progression[idx] += tracker.incrementIf[idx];
-			}
-		}
+	runInstructions(tracker.onActivate, progression);
 
+	if (debug)
+	{
 		auto clientNum = ClientNum(activator);
-		
-		if (g_debugTrackers.integer > 0)
+		auto i         = 0;
+
+		for (auto idx : tracker.modifiedIndices)
 		{
-			for (int i = 0; i < MaxProgressionTrackers; i++)
+			auto from = values[i++];
+			if (from != progression[idx])
 			{
-				if (values[i] != activator->client->sess.progression[i])
-				{
-					std::string trackerChangeMsg = stringFormat("^7Tracker change - index: ^3%i ^7value: ^2%i ^7from: ^9%i^7\n", i + 1, activator->client->sess.progression[i], values[i]);
-					Printer::SendLeftMessage(clientNum, trackerChangeMsg);
-				}
+				std::string trackerChangeMsg = stringFormat("^7Tracker change - index: ^3%i ^7value: ^2%i ^7from: ^9%i^7\n", idx + 1, progression[idx], from);
+				Printer::SendLeftMessage(clientNum, trackerChangeMsg);
 			}
-		}		
+		}
 	}
 }
 
 void ETJump::ProgressionTrackers::useTriggerTracker(gentity_t* ent, gentity_t* activator)
 {
-	auto tracker = _progressionTrackers[ent->key];
-
 	if (!activator || !activator->client)
 	{
 		return;
 	}
 
-	useTracker(ent, activator, tracker);
+	useTracker(ent, activator, _progressionTrackers[ent->key]);
 }
 
 void ETJump::ProgressionTrackers::useTargetTracker(gentity_t* ent, gentity_t* other, gentity_t* activator)
 {
-	auto tracker = _progressionTrackers[ent->key];
-
 	if (!activator || !activator->client)
 	{
 		return;
 	}
 
-	useTracker(ent, activator, tracker);
+	useTracker(ent, activator, _progressionTrackers[ent->key]);
 }
 
 void SP_target_tracker(gentity_t *self)
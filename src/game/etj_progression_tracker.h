@@ -24,6 +24,7 @@
 
 #pragma once
 
+#include <deque>
 #include <vector>
 #include <array>
 
@@ -47,9 +48,14 @@ namespace ETJump
 		};
 		
 		static const int MaxProgressionTrackers = 50;
-		struct ProgressionTracker
+		// values of a single tracker key, indexed by tracker index
+		typedef int TrackerValues[MaxProgressionTrackers];
+
+		// tracker keys as parsed from the entity, only used until the
+		// tracker is compiled
+		struct ParsedTracker
 		{
-			ProgressionTracker()
+			ParsedTracker()
 			{
 				for (auto & v : equal) v = -1;
 				for (auto & v : notEqual) v = -1;
@@ -60,28 +66,61 @@ namespace ETJump
 				for (auto & v : increment) v = 0;
 				for (auto & v : incrementIf) v = 0;
 			}
-			int equal[MaxProgressionTrackers];
-			int notEqual[MaxProgressionTrackers];
-			int greaterThan[MaxProgressionTrackers];
-			int lessThan[MaxProgressionTrackers];
-			int set[MaxProgressionTrackers];
-			int setIf[MaxProgressionTrackers];
-			int increment[MaxProgressionTrackers];
-			int incrementIf[MaxProgressionTrackers];
+			TrackerValues equal;
+			TrackerValues notEqual;
+			TrackerValues greaterThan;
+			TrackerValues lessThan;
+			TrackerValues set;
+			TrackerValues setIf;
+			TrackerValues increment;
+			TrackerValues incrementIf;
+		};
+
+		struct Instruction
+		{
+			enum class Operation
+			{
+				Set,
+				Increment,
+				Equal,
+				NotEqual,
+				GreaterThan,
+				LessThan
+			};
+
+			int index;
+			Operation operation;
+			int operand;
+		};
+
+		// tracker keys compiled at spawn to the instructions on the
+		// indices the keys actually use
+		struct ProgressionTracker
+		{
+			// tracker_set and tracker_inc, run whenever the tracker is used
+			std::vector<Instruction> onUse;
+			// all conditions must hold for the tracker to activate
+			std::vector<Instruction> conditions;
+			// tracker_set_if and tracker_inc_if, run when the tracker activates
+			std::vector<Instruction> onActivate;
+			// sorted indices modified by the tracker, for g_debugTrackers
+			std::vector<int> modifiedIndices;
 		};
 
 		ProgressionTrackers();
 		~ProgressionTrackers();
 		void printParserErrors(const std::vector<std::string>& errors, const std::string& text);
 		std::vector<ProgressionTrackerParser::IndexValuePair> parseKey(const std::string& key);
-		void updateTracker(std::vector<ProgressionTrackerParser::IndexValuePair> pairs, int tracker[MaxProgressionTrackers]);
+		void updateTracker(const std::vector<ProgressionTrackerParser::IndexValuePair>& pairs, TrackerValues& tracker);
 		int registerTracker(ProgressionTrackerKeys keys);
 		void useTargetTracker(gentity_t* ent, gentity_t* other, gentity_t* activator);
 		void useTriggerTracker(gentity_t* ent, gentity_t* activator);
 	private:
+		static ProgressionTracker compileTracker(const ParsedTracker& parsed);
 		void useTracker(gentity_t *ent, gentity_t *activator, const ProgressionTracker& tracker);
 
-		std::vector<ProgressionTracker> _progressionTrackers;
+		// deque, so trackers spawned while one is being used don't move it
+		std::deque<ProgressionTracker> _progressionTrackers;
 	};
 }
 
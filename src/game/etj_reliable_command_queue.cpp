@@ -0,0 +1,246 @@
+/*
+ * MIT License
+ * 
+ * Copyright (c) 2020 ETJump team <zero@etjump.com>
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <algorithm>
+
+#include "etj_reliable_command_queue.h"
+
+const std::size_t ETJump::ReliableCommandQueue::MaxPrintLength;
+const std::size_t ETJump::ReliableCommandQueue::MaxQueuedMessages;
+const int ETJump::ReliableCommandQueue::CommandsPerSecond;
+const int ETJump::ReliableCommandQueue::CommandBurst;
+
+ETJump::ReliableCommandQueue::Counters::Counters() :
+	queued(0), sent(0), merged(0), deferred(0), dropped(0)
+{
+}
+
+ETJump::ReliableCommandQueue::Client::Client() : budget(static_cast<float>(CommandBurst)), nextSequence(0)
+{
+}
+
+ETJump::ReliableCommandQueue::ReliableCommandQueue(int maxClients, SendCommand sendCommand) :
+	_sendCommand(sendCommand), _clients(maxClients > 0 ? maxClients : 0), _lastFlushTime(-1)
+{
+}
+
+ETJump::ReliableCommandQueue::~ReliableCommandQueue()
+{
+}
+
+void ETJump::ReliableCommandQueue::print(int clientNum, Priority priority, const std::string& text)
+{
+	queue(clientNum, priority, Type::Print, text);
+}
+
+void ETJump::ReliableCommandQueue::leftPrint(int clientNum, Priority priority, const std::string& text)
+{
+	queue(clientNum, priority, Type::LeftPrint, text);
+}
+
+void ETJump::ReliableCommandQueue::command(int clientNum, Priority priority, const std::string& command)
+{
+	queue(clientNum, priority, Type::Command, command);
+}
+
+void ETJump::ReliableCommandQueue::queue(int clientNum, Priority priority, Type type, const std::string& text)
+{
+	if (clientNum < 0 || clientNum >= static_cast<int>(_clients.size()) || priority == Priority::NumPriorities)
+	{
+		return;
+	}
+
+	auto& client = _clients[clientNum];
+
+	std::size_t queued = 0;
+	for (const auto & queue : client.queues)
+	{
+		queued += queue.size();
+	}
+	if (queued >= MaxQueuedMessages)
+	{
+		dropOldest(client);
+	}
+
+	Message message;
+	message.type = type;
+	message.text = text;
+	message.sequence = client.nextSequence++;
+	client.queues[static_cast<int>(priority)].push_back(message);
+	++_counters.queued;
+}
+
+void ETJump::ReliableCommandQueue::dropOldest(Client& client)
+{
+	// commands are never dropped, the client would end up out of sync
+	for (auto priority = static_cast<int>(Priority::NumPriorities) - 1; priority > static_cast<int>(Priority::Command); --priority)
+	{
+		if (!client.queues[priority].empty())
+		{
+			client.queues[priority].pop_front();
+			++_counters.dropped;
+			return;
+		}
+	}
+}
+
+void ETJump::ReliableCommandQueue::clear(int clientNum)
+{
+	if (clientNum < 0 || clientNum >= static_cast<int>(_clients.size()))
+	{
+		return;
+	}
+
+	_clients[clientNum] = Client();
+}
+
+void ETJump::ReliableCommandQueue::sendNext(int clientNum, std::deque<Message>& queue)
+{
+	auto message = queue.front();
+	queue.pop_front();
+
+	// only messages that were queued right after each other are merged,
+	// anything queued in between with another priority has to go first
+	auto last = message.sequence;
+	auto follows = [&queue, &last]()
+	{
+		return queue.front().sequence == last + 1;
+	};
+
+	if (message.type == Type::Print)
+	{
+		while (!queue.empty() && queue.front().type == Type::Print && follows() &&
+		       message.text.length() + queue.front().text.length() <= MaxPrintLength)
+		{
+			message.text += queue.front().text;
+			last = queue.front().sequence;
+			queue.pop_front();
+			++_counters.merged;
+		}
+
+		_sendCommand(clientNum, "print \"" + message.text + "\"");
+	}
+	else if (message.type == Type::LeftPrint)
+	{
+		_sendCommand(clientNum, "cpm \"" + message.text + "\"");
+	}
+	else
+	{
+		_sendCommand(clientNum, message.text);
+	}
+
+	++_counters.sent;
+}
+
+float ETJump::ReliableCommandQueue::requiredBudget(int priority)
+{
+	// low priority messages leave half of the budget for normal ones
+	if (priority == static_cast<int>(Priority::Low))
+	{
+		return CommandBurst / 2.0f;
+	}
+
+	return 1.0f;
+}
+
+void ETJump::ReliableCommandQueue::sendQueued(int clientNum, bool ignoreBudget)
+{
+	auto& client = _clients[clientNum];
+
+	for (;;)
+	{
+		// oldest message of the priorities that can still be sent
+		auto next = -1;
+		for (auto priority = 0; priority < static_cast<int>(Priority::NumPriorities); ++priority)
+		{
+			const auto& queue = client.queues[priority];
+			if (queue.empty())
+			{
+				continue;
+			}
+
+			if (!ignoreBudget && priority != static_cast<int>(Priority::Command) && client.budget < requiredBudget(priority))
+			{
+				continue;
+			}
+
+			if (next < 0 || queue.front().sequence < client.queues[next].front().sequence)
+			{
+				next = priority;
+			}
+		}
+
+		if (next < 0)
+		{
+			break;
+		}
+
+		sendNext(clientNum, client.queues[next]);
+		client.budget -= 1.0f;
+	}
+
+	for (const auto & queue : client.queues)
+	{
+		_counters.deferred += queue.size();
+	}
+}
+
+void ETJump::ReliableCommandQueue::flush(int levelTime)
+{
+	auto elapsed = _lastFlushTime < 0 ? 0 : levelTime - _lastFlushTime;
+	_lastFlushTime = levelTime;
+
+	auto refill = std::max(0, elapsed) * CommandsPerSecond / 1000.0f;
+
+	for (auto clientNum = 0; clientNum < static_cast<int>(_clients.size()); ++clientNum)
+	{
+		auto& client = _clients[clientNum];
+		client.budget = std::min(client.budget + refill, static_cast<float>(CommandBurst));
+
+		sendQueued(clientNum, false);
+	}
+}
+
+void ETJump::ReliableCommandQueue::flushAll()
+{
+	for (auto clientNum = 0; clientNum < static_cast<int>(_clients.size()); ++clientNum)
+	{
+		sendQueued(clientNum, true);
+	}
+}
+
+void ETJump::ReliableCommandQueue::flushClient(int clientNum)
+{
+	if (clientNum < 0 || clientNum >= static_cast<int>(_clients.size()))
+	{
+		return;
+	}
+
+	sendQueued(clientNum, true);
+}
+
+const ETJump::ReliableCommandQueue::Counters& ETJump::ReliableCommandQueue::counters() const
+{
+	return _counters;
+}
@@ -0,0 +1,162 @@
+/*
+ * MIT License
+ * 
+ * Copyright (c) 2020 ETJump team <zero@etjump.com>
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace ETJump
+{
+	/**
+	 * Per client queues for reliable server commands. Commands queued
+	 * during a frame are sent when the queue is flushed at the end of
+	 * the frame. Adjacent print messages are merged into a single
+	 * command, and each client has a budget of commands per
+	 * second so that message bursts don't overflow the client's
+	 * reliable command buffer. Messages over the budget are deferred to
+	 * later frames. Messages that are not deferred are sent in the order
+	 * they were queued, priority only decides what is deferred.
+	 *
+	 * Popups are sent as one cpm command each, older cgames only show
+	 * the first argument of a cpm.
+	 */
+	class ReliableCommandQueue
+	{
+	public:
+		// longest print payload, same as BYTES_PER_PACKET
+		static const std::size_t MaxPrintLength = 998;
+		// queued messages per client before low priority ones are dropped
+		static const std::size_t MaxQueuedMessages = 512;
+		static const int CommandsPerSecond = 40;
+		static const int CommandBurst = 32;
+
+		enum class Priority
+		{
+			// game state commands, never deferred
+			Command,
+			// prints in response to the client's actions
+			Normal,
+			// banners and other messages that can wait
+			Low,
+			NumPriorities
+		};
+
+		struct Counters
+		{
+			Counters();
+
+			// messages queued
+			unsigned queued;
+			// commands sent
+			unsigned sent;
+			// messages merged into a previous message
+			unsigned merged;
+			// messages left in the queue at the end of a flush
+			unsigned deferred;
+			// low priority messages dropped because the queue was full
+			unsigned dropped;
+		};
+
+		typedef std::function<void(int clientNum, const std::string& command)> SendCommand;
+
+		ReliableCommandQueue(int maxClients, SendCommand sendCommand);
+		~ReliableCommandQueue();
+
+		/**
+		 * Queues a console print
+		 */
+		void print(int clientNum, Priority priority, const std::string& text);
+		/**
+		 * Queues a popup message
+		 */
+		void leftPrint(int clientNum, Priority priority, const std::string& text);
+		/**
+		 * Queues a command as is. Commands are never merged.
+		 */
+		void command(int clientNum, Priority priority, const std::string& command);
+		/**
+		 * Removes the client's queued messages and resets its budget.
+		 * Called when the slot is freed.
+		 */
+		void clear(int clientNum);
+		/**
+		 * Sends queued messages within each client's budget
+		 * @param levelTime current time, used to refill the budgets
+		 */
+		void flush(int levelTime);
+		/**
+		 * Sends every queued message regardless of the budgets
+		 */
+		void flushAll();
+		/**
+		 * Sends every message queued for the client regardless of its
+		 * budget. Called before a command is sent to the client directly
+		 * so that it doesn't overtake messages queued earlier.
+		 */
+		void flushClient(int clientNum);
+
+		const Counters& counters() const;
+	private:
+		enum class Type
+		{
+			Print,
+			LeftPrint,
+			Command
+		};
+
+		struct Message
+		{
+			Type type;
+			std::string text;
+			// order of the message among all of the client's messages
+			unsigned sequence;
+		};
+
+		struct Client
+		{
+			Client();
+
+			std::deque<Message> queues[static_cast<int>(Priority::NumPriorities)];
+			float budget;
+			unsigned nextSequence;
+		};
+
+		void queue(int clientNum, Priority priority, Type type, const std::string& text);
+		void dropOldest(Client& client);
+		// budget needed to send a message of the priority
+		static float requiredBudget(int priority);
+		// merges and sends messages from the front of the queue
+		void sendNext(int clientNum, std::deque<Message>& queue);
+		void sendQueued(int clientNum, bool ignoreBudget);
+
+		SendCommand _sendCommand;
+		std::vector<Client> _clients;
+		int _lastFlushTime;
+		Counters _counters;
+	};
+}
@@ -28,8 +28,10 @@ using std::string;
 using std::vector;
 
 #include "etj_save_system.h"
+#include "etj_saved_positions_database.h"
 #include "utilities.hpp"
 #include "etj_session.h"
+#include "etj_printer.h"
 
 ETJump::SaveSystem::Client::Client()
 {
@@ -52,16 +54,6 @@ ETJump::SaveSystem::Client::Client()
 	}
 }
 
-ETJump::SaveSystem::DisconnectedClient::DisconnectedClient()
-{
-	for (int i = 0; i < MAX_SAVED_POSITIONS; i++)
-	{
-		alliesSavedPositions[i].isValid = false;
-		axisSavedPositions[i].isValid   = false;
-		progression                     = 0;
-	}
-}
-
 // Zero: required for saving saves to db
 std::string UserDatabase_Guid(gentity_t *ent);
 
@@ -429,18 +421,6 @@ void ETJump::SaveSystem::loadBackupPosition(gentity_t *ent)
 	}
 }
 
-void ETJump::SaveSystem::reset()
-{
-	for (int clientIndex = 0; clientIndex < level.numConnectedClients; clientIndex++)
-	{
-		int clientNum = level.sortedClients[clientIndex];
-		// TODO: reset saved positions here
-		resetSavedPositions(g_entities + clientNum);
-	}
-
-	_savedPositions.clear();
-}
-
 // Used to reset positions on map change/restart
 void ETJump::SaveSystem::resetSavedPositions(gentity_t *ent)
 {
@@ -470,6 +450,27 @@ void ETJump::SaveSystem::savePositionsToDatabase(gentity_t *ent)
 		return;
 	}
 
+	storePositions(ent);
+	ent->client->sess.loadPreviousSavedPositions = qfalse;
+}
+
+void ETJump::SaveSystem::saveConnectedPositionsToDatabase()
+{
+	for (int clientNum = 0; clientNum < level.maxclients; clientNum++)
+	{
+		gentity_t *ent = g_entities + clientNum;
+
+		if (ent->client && ent->client->pers.connected == CON_CONNECTED)
+		{
+			storePositions(ent);
+		}
+	}
+
+	_savedPositions->flush();
+}
+
+void ETJump::SaveSystem::storePositions(gentity_t *ent)
+{
 	string guid = _session->Guid(ent);
 
 	DisconnectedClient client;
@@ -492,20 +493,9 @@ void ETJump::SaveSystem::savePositionsToDatabase(gentity_t *ent)
 		    = _clients[ClientNum(ent)].axisSavedPositions[i].isValid;
 	}
 
-	client.progression                           = ent->client->sess.clientMapProgression;
-	ent->client->sess.loadPreviousSavedPositions = qfalse;
-
-	std::map<string, DisconnectedClient>::iterator it = _savedPositions.find(guid);
-
-	if (it != _savedPositions.end())
-	{
-		it->second = client;
-	}
-	else
-	{
-		_savedPositions.insert(std::make_pair(guid, client));
-	}
+	client.progression = ent->client->sess.clientMapProgression;
 
+	_savedPositions->store(guid, client);
 }
 
 // Called on client connect. Loads saves from previous session
@@ -522,51 +512,81 @@ void ETJump::SaveSystem::loadPositionsFromDatabase(gentity_t *ent)
 		return;
 	}
 
-	string guid = _session->Guid(ent);
-
-	std::map<string, DisconnectedClient>::iterator it = _savedPositions.find(guid);
+	auto clientNum = ClientNum(ent);
+	auto guid      = _session->Guid(ent);
 
-	if (it != _savedPositions.end())
+	_savedPositions->fetch(guid, [this, clientNum, guid](const DisconnectedClient *positions)
 	{
+		auto target = g_entities + clientNum;
+
+		if (!positions || !target->client || target->client->pers.connected != CON_CONNECTED)
+		{
+			return;
+		}
 
-		unsigned validPositionsCount = 0;
+		// client might have reconnected or saved already while the positions
+		// were being loaded
+		if (!target->client->sess.loadPreviousSavedPositions || _session->Guid(target) != guid)
+		{
+			return;
+		}
 
 		for (int i = 0; i < MAX_SAVED_POSITIONS; i++)
 		{
-			// Allied
-			VectorCopy(it->second.alliesSavedPositions[i].origin,
-			           _clients[ClientNum(ent)].alliesSavedPositions[i].origin);
-			VectorCopy(it->second.alliesSavedPositions[i].vangles,
-			           _clients[ClientNum(ent)].alliesSavedPositions[i].vangles);
-			_clients[ClientNum(ent)].alliesSavedPositions[i].isValid =
-			    it->second.alliesSavedPositions[i].isValid;
-
-			if (it->second.alliesSavedPositions[i].isValid)
+			if (_clients[clientNum].alliesSavedPositions[i].isValid || _clients[clientNum].axisSavedPositions[i].isValid)
 			{
-				++validPositionsCount;
+				return;
 			}
+		}
 
-			// Axis
-			VectorCopy(it->second.axisSavedPositions[i].origin,
-			           _clients[ClientNum(ent)].axisSavedPositions[i].origin);
-			VectorCopy(it->second.axisSavedPositions[i].vangles,
-			           _clients[ClientNum(ent)].axisSavedPositions[i].vangles);
-			_clients[ClientNum(ent)].axisSavedPositions[i].isValid =
-			    it->second.axisSavedPositions[i].isValid;
+		restorePositions(target, *positions);
+	});
+}
 
-			if (it->second.axisSavedPositions[i].isValid)
-			{
-				++validPositionsCount;
-			}
+void ETJump::SaveSystem::restorePositions(gentity_t *ent, const DisconnectedClient& positions)
+{
+	unsigned validPositionsCount = 0;
+
+	for (int i = 0; i < MAX_SAVED_POSITIONS; i++)
+	{
+		// Allied
+		VectorCopy(positions.alliesSavedPositions[i].origin,
+		           _clients[ClientNum(ent)].alliesSavedPositions[i].origin);
+		VectorCopy(positions.alliesSavedPositions[i].vangles,
+		           _clients[ClientNum(ent)].alliesSavedPositions[i].vangles);
+		_clients[ClientNum(ent)].alliesSavedPositions[i].isValid =
+		    positions.alliesSavedPositions[i].isValid;
+
+		if (positions.alliesSavedPositions[i].isValid)
+		{
+			++validPositionsCount;
 		}
 
-		ent->client->sess.loadPreviousSavedPositions = qfalse;
-		ent->client->sess.clientMapProgression       = it->second.progression;
-		if (validPositionsCount)
+		// Axis
+		VectorCopy(positions.axisSavedPositions[i].origin,
+		           _clients[ClientNum(ent)].axisSavedPositions[i].origin);
+		VectorCopy(positions.axisSavedPositions[i].vangles,
+		           _clients[ClientNum(ent)].axisSavedPositions[i].vangles);
+		_clients[ClientNum(ent)].axisSavedPositions[i].isValid =
+		    positions.axisSavedPositions[i].isValid;
+
+		if (positions.axisSavedPositions[i].isValid)
 		{
-			ChatPrintTo(ent, "^<ETJump: ^7loaded saved positions from previous session.");
+			++validPositionsCount;
 		}
 	}
+
+	ent->client->sess.loadPreviousSavedPositions = qfalse;
+	ent->client->sess.clientMapProgression       = positions.progression;
+	if (validPositionsCount)
+	{
+		ChatPrintTo(ent, "^<ETJump: ^7loaded saved positions from previous session.");
+	}
+}
+
+void ETJump::SaveSystem::runFrame()
+{
+	_savedPositions->runFrame();
 }
 
 void ETJump::SaveSystem::storeTeamQuickDeployPosition(gentity_t *ent, team_t team)
@@ -755,7 +775,18 @@ ETJump::SaveSystem::SaveSystem(const std::shared_ptr<Session> session) :
 	_session(session)
 	//:guidInterface_(guidInterface)
 {
+	std::string databasePath;
+	if (g_savedPositionsDatabase.string[0])
+	{
+		databasePath = GetPath(g_savedPositionsDatabase.string);
+	}
 
+	_savedPositions = std::unique_ptr<SavedPositionsDatabase>(
+		new SavedPositionsDatabase(databasePath, level.rawmapname, g_savedPositionsCacheSize.integer, g_savedPositionsExpiry.integer,
+		                           [](const std::string& error)
+	{
+		Printer::LogPrintln(error);
+	}));
 }
 
 ETJump::SaveSystem::~SaveSystem()
@@ -32,7 +32,7 @@
 #undef max
 #endif
 
-#include <map>
+#include <memory>
 #include <string>
 #include <boost/circular_buffer.hpp>
 
@@ -42,6 +42,8 @@ class Session;
 
 namespace ETJump
 {
+	class SavedPositionsDatabase;
+
 	class SaveSystem {
 	public:
 
@@ -85,7 +87,7 @@ namespace ETJump
 
 		struct DisconnectedClient
 		{
-			DisconnectedClient();
+			DisconnectedClient() : progression(0) {}
 
 			// Allies saved positions at the time of disconnect
 			SavePosition alliesSavedPositions[MAX_SAVED_POSITIONS];
@@ -115,18 +117,23 @@ namespace ETJump
 		// Loads backup position
 		void loadBackupPosition(gentity_t *ent);
 
-		// resets all clients positions
-		void reset();
-
 		// Resets targets positions
 		void resetSavedPositions(gentity_t *ent);
 
 		// Saves positions to db on disconnect
 		void savePositionsToDatabase(gentity_t *ent);
 
-		// Loads positions from db on dc
+		// Saves positions of every client in the game to db, so they
+		// aren't lost when the server shuts down or restarts
+		void saveConnectedPositionsToDatabase();
+
+		// Loads positions from db on connect. Positions that aren't
+		// in memory are restored on a later frame
 		void loadPositionsFromDatabase(gentity_t *ent);
 
+		// Restores positions loaded from db
+		void runFrame();
+
 		void storeTeamQuickDeployPosition(gentity_t *ent, team_t team);
 		void loadTeamQuickDeployPosition(gentity_t *ent, team_t team);
 		void loadOnceTeamQuickDeployPosition(gentity_t *ent, team_t team);
@@ -147,11 +154,16 @@ namespace ETJump
 
 		SavePosition* getValidTeamSaveForSlot(gentity_t *ent, team_t team, int slot);
 
+		// Copies positions from previous session to the client
+		void storePositions(gentity_t *ent);
+
+		void restorePositions(gentity_t *ent, const DisconnectedClient& positions);
+
 		// All clients' save related data
 		Client _clients[MAX_CLIENTS];
 
 		// Disconnected clients saved position data
-		std::map<std::string, DisconnectedClient> _savedPositions;
+		std::unique_ptr<SavedPositionsDatabase> _savedPositions;
 
 		// Interface to get player guid
 		const std::shared_ptr<Session> _session;
@@ -0,0 +1,502 @@
+/*
+ * MIT License
+ * 
+ * Copyright (c) 2020 ETJump team <zero@etjump.com>
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <ctime>
+#include <sstream>
+
+#include "etj_saved_positions_database.h"
+
+namespace
+{
+	const char *createTableStatement =
+		"CREATE TABLE IF NOT EXISTS saved_positions ("
+		"guid TEXT NOT NULL, "
+		"map TEXT NOT NULL, "
+		"progression INTEGER NOT NULL, "
+		"positions TEXT NOT NULL, "
+		"last_seen INTEGER NOT NULL, "
+		"PRIMARY KEY (guid, map));";
+	const char *expireStatement =
+		"DELETE FROM saved_positions WHERE last_seen < ?;";
+	const char *insertStatement =
+		"INSERT OR REPLACE INTO saved_positions (guid, map, progression, positions, last_seen) VALUES (?, ?, ?, ?, ?);";
+	const char *selectStatement =
+		"SELECT progression, positions FROM saved_positions WHERE guid=? AND map=?;";
+
+	typedef ETJump::SaveSystem::SavePosition SavePosition;
+
+	void serializePosition(std::ostringstream& stream, const SavePosition& position)
+	{
+		stream << (position.isValid ? 1 : 0) << ' '
+		       << position.origin[0] << ' ' << position.origin[1] << ' ' << position.origin[2] << ' '
+		       << position.vangles[0] << ' ' << position.vangles[1] << ' ' << position.vangles[2] << ' ';
+	}
+
+	bool deserializePosition(std::istringstream& stream, SavePosition& position)
+	{
+		int isValid = 0;
+		stream >> isValid
+		       >> position.origin[0] >> position.origin[1] >> position.origin[2]
+		       >> position.vangles[0] >> position.vangles[1] >> position.vangles[2];
+		position.isValid = isValid != 0;
+		return !stream.fail();
+	}
+
+	// allies positions followed by axis positions, 7 numbers each
+	std::string serializePositions(const ETJump::SaveSystem::DisconnectedClient& positions)
+	{
+		std::ostringstream stream;
+		// enough digits to read the same float back
+		stream.precision(9);
+		for (const auto & position : positions.alliesSavedPositions)
+		{
+			serializePosition(stream, position);
+		}
+		for (const auto & position : positions.axisSavedPositions)
+		{
+			serializePosition(stream, position);
+		}
+		return stream.str();
+	}
+
+	bool deserializePositions(const std::string& serialized, ETJump::SaveSystem::DisconnectedClient& positions)
+	{
+		std::istringstream stream(serialized);
+		for (auto & position : positions.alliesSavedPositions)
+		{
+			if (!deserializePosition(stream, position))
+			{
+				return false;
+			}
+		}
+		for (auto & position : positions.axisSavedPositions)
+		{
+			if (!deserializePosition(stream, position))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+}
+
+ETJump::SavedPositionsDatabase::SavedPositionsDatabase(const std::string& databasePath, const std::string& map, int cacheSize, int expiryDays, LogError logError) :
+	_databasePath(databasePath), _map(map), _cacheSize(cacheSize > 0 ? cacheSize : 1), _expiryDays(expiryDays), _logError(logError),
+	_stopping(false), _writing(false), _db(nullptr)
+{
+	if (!_databasePath.empty())
+	{
+		_worker = std::thread(&SavedPositionsDatabase::work, this);
+	}
+}
+
+ETJump::SavedPositionsDatabase::~SavedPositionsDatabase()
+{
+	if (_worker.joinable())
+	{
+		flush();
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			_stopping = true;
+		}
+		_condition.notify_one();
+		_worker.join();
+	}
+
+	for (const auto & error : _errors)
+	{
+		_logError(error);
+	}
+}
+
+void ETJump::SavedPositionsDatabase::flush()
+{
+	if (!_worker.joinable())
+	{
+		return;
+	}
+
+	std::unique_lock<std::mutex> lock(_mutex);
+	_drained.wait(lock, [this]
+	{
+		return _writeQueue.empty() && !_writing;
+	});
+}
+
+void ETJump::SavedPositionsDatabase::cache(const std::string& guid, const DisconnectedClient& positions)
+{
+	auto it = _cacheIndex.find(guid);
+	if (it != _cacheIndex.end())
+	{
+		it->second->second = positions;
+		_cache.splice(_cache.begin(), _cache, it->second);
+		return;
+	}
+
+	_cache.push_front(std::make_pair(guid, positions));
+	_cacheIndex[guid] = _cache.begin();
+
+	if (_cache.size() > _cacheSize)
+	{
+		_cacheIndex.erase(_cache.back().first);
+		_cache.pop_back();
+	}
+}
+
+void ETJump::SavedPositionsDatabase::store(const std::string& guid, const DisconnectedClient& positions)
+{
+	cache(guid, positions);
+
+	if (!_worker.joinable())
+	{
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_writeQueue[guid] = positions;
+	}
+	_condition.notify_one();
+}
+
+void ETJump::SavedPositionsDatabase::fetch(const std::string& guid, FetchCallback callback)
+{
+	auto it = _cacheIndex.find(guid);
+	if (it != _cacheIndex.end())
+	{
+		_cache.splice(_cache.begin(), _cache, it->second);
+		callback(&it->second->second);
+		return;
+	}
+
+	if (!_worker.joinable())
+	{
+		callback(nullptr);
+		return;
+	}
+
+	auto alreadyQueued = _pendingFetches.find(guid) != _pendingFetches.end();
+	_pendingFetches.insert(std::make_pair(guid, callback));
+	if (alreadyQueued)
+	{
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_readQueue.push_back(guid);
+	}
+	_condition.notify_one();
+}
+
+void ETJump::SavedPositionsDatabase::runFrame()
+{
+	std::vector<FetchResult> results;
+	std::vector<std::string> errors;
+
+	if (!_worker.joinable())
+	{
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		results.swap(_results);
+		errors.swap(_errors);
+	}
+
+	for (const auto & error : errors)
+	{
+		_logError(error);
+	}
+
+	for (const auto & result : results)
+	{
+		// copied, callbacks might store positions and evict the entry
+		DisconnectedClient positions;
+		auto               found = false;
+
+		// anything stored while the read was in flight is newer
+		auto cached = _cacheIndex.find(result.guid);
+		if (cached != _cacheIndex.end())
+		{
+			positions = cached->second->second;
+			found     = true;
+		}
+		else if (result.found)
+		{
+			cache(result.guid, result.positions);
+			positions = result.positions;
+			found     = true;
+		}
+
+		auto                       range = _pendingFetches.equal_range(result.guid);
+		std::vector<FetchCallback> callbacks;
+		for (auto it = range.first; it != range.second; ++it)
+		{
+			callbacks.push_back(it->second);
+		}
+		_pendingFetches.erase(range.first, range.second);
+
+		for (const auto & callback : callbacks)
+		{
+			callback(found ? &positions : nullptr);
+		}
+	}
+}
+
+void ETJump::SavedPositionsDatabase::work()
+{
+	auto opened = openDatabase();
+
+	for (;;)
+	{
+		std::map<std::string, DisconnectedClient> writes;
+		std::deque<std::string>                   reads;
+		bool                                      stopping;
+
+		{
+			std::unique_lock<std::mutex> lock(_mutex);
+			_condition.wait(lock, [this]
+			{
+				return _stopping || !_writeQueue.empty() || !_readQueue.empty();
+			});
+			writes.swap(_writeQueue);
+			reads.swap(_readQueue);
+			stopping = _stopping;
+			_writing = !writes.empty();
+		}
+
+		// writes go first so that reads see positions stored before them
+		if (opened && !writes.empty())
+		{
+			writePositions(writes);
+		}
+
+		if (!writes.empty())
+		{
+			{
+				std::lock_guard<std::mutex> lock(_mutex);
+				_writing = false;
+			}
+			_drained.notify_all();
+		}
+
+		std::vector<FetchResult> results;
+		for (const auto & guid : reads)
+		{
+			if (opened)
+			{
+				results.push_back(readPositions(guid));
+			}
+			else
+			{
+				FetchResult result;
+				result.guid  = guid;
+				result.found = false;
+				results.push_back(result);
+			}
+		}
+
+		if (!results.empty())
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			_results.insert(_results.end(), results.begin(), results.end());
+		}
+
+		if (stopping)
+		{
+			break;
+		}
+	}
+
+	if (_db)
+	{
+		sqlite3_close(_db);
+		_db = nullptr;
+	}
+}
+
+bool ETJump::SavedPositionsDatabase::openDatabase()
+{
+	std::string error;
+
+	auto rc = sqlite3_open(_databasePath.c_str(), &_db);
+	if (rc != SQLITE_OK)
+	{
+		error = "SavedPositionsDatabase: failed to open database: " + std::string(sqlite3_errmsg(_db));
+	}
+	else
+	{
+		sqlite3_exec(_db, "PRAGMA journal_mode=WAL;", nullptr, nullptr, nullptr);
+		sqlite3_busy_timeout(_db, 5000);
+
+		rc = sqlite3_exec(_db, createTableStatement, nullptr, nullptr, nullptr);
+		if (rc != SQLITE_OK)
+		{
+			error = "SavedPositionsDatabase: failed to create table: " + std::string(sqlite3_errmsg(_db));
+		}
+	}
+
+	if (error.empty())
+	{
+		expirePositions();
+		return true;
+	}
+
+	sqlite3_close(_db);
+	_db = nullptr;
+
+	std::lock_guard<std::mutex> lock(_mutex);
+	_errors.push_back(error);
+	return false;
+}
+
+void ETJump::SavedPositionsDatabase::expirePositions()
+{
+	sqlite3_stmt *stmt = nullptr;
+	std::string  error;
+
+	if (_expiryDays <= 0)
+	{
+		return;
+	}
+
+	auto rc = sqlite3_prepare_v2(_db, expireStatement, -1, &stmt, nullptr);
+	if (rc != SQLITE_OK)
+	{
+		error = "SavedPositionsDatabase: failed to prepare expire statement: " + std::string(sqlite3_errmsg(_db));
+	}
+	else
+	{
+		sqlite3_bind_int64(stmt, 1, static_cast<sqlite3_int64>(std::time(nullptr)) - static_cast<sqlite3_int64>(_expiryDays) * 24 * 60 * 60);
+
+		rc = sqlite3_step(stmt);
+		if (rc != SQLITE_DONE)
+		{
+			error = "SavedPositionsDatabase: failed to expire positions: " + std::string(sqlite3_errmsg(_db));
+		}
+	}
+
+	sqlite3_finalize(stmt);
+
+	if (!error.empty())
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_errors.push_back(error);
+	}
+}
+
+void ETJump::SavedPositionsDatabase::writePositions(const std::map<std::string, DisconnectedClient>& writes)
+{
+	sqlite3_stmt *stmt = nullptr;
+	std::string  error;
+	const auto   now = static_cast<sqlite3_int64>(std::time(nullptr));
+
+	sqlite3_exec(_db, "BEGIN TRANSACTION;", nullptr, nullptr, nullptr);
+
+	auto rc = sqlite3_prepare_v2(_db, insertStatement, -1, &stmt, nullptr);
+	if (rc != SQLITE_OK)
+	{
+		error = "SavedPositionsDatabase: failed to prepare insert statement: " + std::string(sqlite3_errmsg(_db));
+	}
+	else
+	{
+		for (const auto & write : writes)
+		{
+			auto positions = serializePositions(write.second);
+
+			sqlite3_bind_text(stmt, 1, write.first.c_str(), write.first.length(), SQLITE_STATIC);
+			sqlite3_bind_text(stmt, 2, _map.c_str(), _map.length(), SQLITE_STATIC);
+			sqlite3_bind_int(stmt, 3, write.second.progression);
+			sqlite3_bind_text(stmt, 4, positions.c_str(), positions.length(), SQLITE_STATIC);
+			sqlite3_bind_int64(stmt, 5, now);
+
+			rc = sqlite3_step(stmt);
+			if (rc != SQLITE_DONE)
+			{
+				error = "SavedPositionsDatabase: failed to save positions: " + std::string(sqlite3_errmsg(_db));
+				break;
+			}
+			sqlite3_reset(stmt);
+		}
+	}
+
+	sqlite3_finalize(stmt);
+	sqlite3_exec(_db, error.empty() ? "COMMIT;" : "ROLLBACK;", nullptr, nullptr, nullptr);
+
+	if (!error.empty())
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_errors.push_back(error);
+	}
+}
+
+ETJump::SavedPositionsDatabase::FetchResult ETJump::SavedPositionsDatabase::readPositions(const std::string& guid)
+{
+	sqlite3_stmt *stmt = nullptr;
+	std::string  error;
+	FetchResult  result;
+
+	result.guid  = guid;
+	result.found = false;
+
+	auto rc = sqlite3_prepare_v2(_db, selectStatement, -1, &stmt, nullptr);
+	if (rc != SQLITE_OK)
+	{
+		error = "SavedPositionsDatabase: failed to prepare select statement: " + std::string(sqlite3_errmsg(_db));
+	}
+	else
+	{
+		sqlite3_bind_text(stmt, 1, guid.c_str(), guid.length(), SQLITE_STATIC);
+		sqlite3_bind_text(stmt, 2, _map.c_str(), _map.length(), SQLITE_STATIC);
+
+		rc = sqlite3_step(stmt);
+		if (rc == SQLITE_ROW)
+		{
+			auto text = reinterpret_cast<const char *>(sqlite3_column_text(stmt, 1));
+
+			result.positions.progression = sqlite3_column_int(stmt, 0);
+			result.found                 = text && deserializePositions(text, result.positions);
+			if (!result.found)
+			{
+				error = "SavedPositionsDatabase: ignoring malformed positions of " + guid;
+			}
+		}
+		else if (rc != SQLITE_DONE)
+		{
+			error = "SavedPositionsDatabase: failed to load positions: " + std::string(sqlite3_errmsg(_db));
+		}
+	}
+
+	sqlite3_finalize(stmt);
+
+	if (!error.empty())
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_errors.push_back(error);
+	}
+
+	return result;
+}
@@ -0,0 +1,140 @@
+/*
+ * MIT License
+ * 
+ * Copyright (c) 2020 ETJump team <zero@etjump.com>
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <list>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include <sqlite3.h>
+
+#include "etj_save_system.h"
+
+namespace ETJump
+{
+	/**
+	 * Keeps disconnected clients' saved positions for the current map.
+	 * The most recently used entries are kept in memory, and all of them
+	 * are written to an SQLite database in the background so they survive
+	 * map changes and server restarts. Rows record when they were last
+	 * stored, and expired ones are deleted when the database is opened.
+	 *
+	 * The database is only accessed from a worker thread, through its own
+	 * connection. Everything else, including the fetch callbacks and error
+	 * logging, runs on the game thread. The game thread keeps using sqlite
+	 * on other connections while the worker runs, which is why sqlite is
+	 * built with SQLITE_THREADSAFE=2.
+	 */
+	class SavedPositionsDatabase
+	{
+	public:
+		typedef SaveSystem::DisconnectedClient DisconnectedClient;
+		// called with nullptr if the client has no saved positions
+		typedef std::function<void(const DisconnectedClient *positions)> FetchCallback;
+		typedef std::function<void(const std::string& error)> LogError;
+
+		/**
+		 * @param databasePath full path to the database file. If empty,
+		 * positions are only kept in memory.
+		 * @param map current map
+		 * @param cacheSize number of clients kept in memory
+		 * @param expiryDays positions not stored for this many days are
+		 * deleted when the database is opened, 0 keeps them forever
+		 * @param logError called on the game thread for database errors
+		 */
+		SavedPositionsDatabase(const std::string& databasePath, const std::string& map, int cacheSize, int expiryDays, LogError logError);
+		// writes out the pending positions before returning
+		~SavedPositionsDatabase();
+
+		/**
+		 * Stores the positions of a disconnecting client
+		 */
+		void store(const std::string& guid, const DisconnectedClient& positions);
+		/**
+		 * Looks up the positions of a connecting client. The callback is
+		 * called right away if they are in memory, otherwise from
+		 * runFrame once the database has been read.
+		 */
+		void fetch(const std::string& guid, FetchCallback callback);
+		/**
+		 * Calls the callbacks of finished fetches and logs database
+		 * errors
+		 */
+		void runFrame();
+		/**
+		 * Blocks until every stored position has been written
+		 */
+		void flush();
+	private:
+		struct FetchResult
+		{
+			std::string guid;
+			bool found;
+			DisconnectedClient positions;
+		};
+
+		void cache(const std::string& guid, const DisconnectedClient& positions);
+		void work();
+		bool openDatabase();
+		void expirePositions();
+		void writePositions(const std::map<std::string, DisconnectedClient>& writes);
+		FetchResult readPositions(const std::string& guid);
+
+		std::string _databasePath;
+		std::string _map;
+		std::size_t _cacheSize;
+		int _expiryDays;
+		LogError _logError;
+
+		// most recently used first
+		std::list<std::pair<std::string, DisconnectedClient>> _cache;
+		std::unordered_map<std::string, std::list<std::pair<std::string, DisconnectedClient>>::iterator> _cacheIndex;
+		std::multimap<std::string, FetchCallback> _pendingFetches;
+
+		// shared with the worker thread
+		std::mutex _mutex;
+		std::condition_variable _condition;
+		// signalled when the worker has finished a batch of writes
+		std::condition_variable _drained;
+		bool _stopping;
+		bool _writing;
+		// keyed by guid, a later store replaces a pending one
+		std::map<std::string, DisconnectedClient> _writeQueue;
+		std::deque<std::string> _readQueue;
+		std::vector<FetchResult> _results;
+		std::vector<std::string> _errors;
+
+		// worker thread only
+		sqlite3 *_db;
+
+		std::thread _worker;
+	};
+}
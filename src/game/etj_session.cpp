@@ -240,56 +240,30 @@ void Session::GetUserAndLevelData(int clientNum)
 
 void Session::ParsePermissions(int clientNum)
 {
-	clients_[clientNum].permissions.reset();
-	// First parse level commands then user commands (as user commands override level ones)
-	std::string commands = clients_[clientNum].level->commands + clients_[clientNum].user->commands;
+	auto& client = clients_[clientNum];
 
-	const int STATE_ALLOW = 1;
-	const int STATE_DENY  = 2;
-	int       state       = STATE_ALLOW;
-	for (unsigned i = 0; i < commands.length(); i++)
+	// Level commands are parsed once by Levels, user commands override them.
+	// User commands are parsed as a continuation of the level commands.
+	client.permissions = client.level->permissions;
+	if (!client.user->commands.empty())
 	{
-		char c = commands.at(i);
-		if (state == STATE_ALLOW)
-		{
-			if (c == '*')
-			{
-				// Allow all commands
-				for (size_t i = 0; i < MAX_COMMANDS; i++)
-				{
-					clients_[clientNum].permissions.set(i, true);
-				}
-			}
-			else if (c == '+')
-			{
-				// ignore +
-				continue;
-			}
-			else if (c == '-')
-			{
-				state = STATE_DENY;
-			}
-			else
-			{
-				clients_[clientNum].permissions.set(c, true);
-			}
-		}
-		else
-		{
-			if (c == '*')
-			{
-				// Ignore * while in deny-mode
-				continue;
-			}
+		auto userMask = Levels::ParsePermissions(client.user->commands, client.level->permissionsEndInDenyMode);
+		client.permissions &= ~userMask.denied;
+		client.permissions |= userMask.allowed;
+	}
+}
 
-			if (c == '+')
-			{
-				state = STATE_ALLOW;
-			}
-			else
-			{
-				clients_[clientNum].permissions.set(c, false);
-			}
+void Session::LevelEdited(int adminLevel)
+{
+	// level might have been created by the edit, so look it up again
+	auto levelData = game.levels->GetLevel(adminLevel);
+	for (int i = 0; i < level.numConnectedClients; i++)
+	{
+		int clientNum = level.sortedClients[i];
+		if (clients_[clientNum].user && clients_[clientNum].user->level == adminLevel)
+		{
+			clients_[clientNum].level = levelData;
+			ParsePermissions(clientNum);
 		}
 	}
 }
@@ -370,6 +344,7 @@ bool Session::SetLevel(int id, int level)
 	{
 		if (clients_[i].user && clients_[i].user->id == id)
 		{
+			clients_[i].level = game.levels->GetLevel(level);
 			ParsePermissions(i);
 			ChatPrintTo(g_entities + i, va("^3setlevel: ^7you are now a level %d user.", level));
 		}
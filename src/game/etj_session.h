@@ -37,7 +37,7 @@
 class Session
 {
 public:
-	static const unsigned MAX_COMMANDS = 256;
+	static const unsigned MAX_COMMANDS = Levels::MAX_COMMANDS;
 	Session(std::shared_ptr<IAuthentication> database);
 	void ResetClient(int clientNum);
 
@@ -76,6 +76,8 @@ public:
 	void ParsePermissions(int clientNum);
 	bool HasPermission(gentity_t *ent, char flag);
 	void NewName(gentity_t *ent);
+	// Updates permissions of the connected users with that level
+	void LevelEdited(int level);
 	// Returns the amount of users with that level
 	int LevelDeleted(int level);
 	std::vector<Session::Client *> FindUsersByLevel(int level);
@@ -31,9 +31,9 @@
 #undef max
 #endif
 
-#include <boost/format.hpp>
 #include <string>
 #include <vector>
+#include "etj_format.h"
 
 namespace ETJump
 {
@@ -45,24 +45,6 @@ namespace ETJump
 	std::string getValue(const char *value, const std::string& defaultValue = "");
 	std::string getValue(const std::string& value, const std::string& defaultValue = "");
 
-	inline std::string stringFormat(boost::format& fmt)
-	{
-		return fmt.str();
-	}
-
-	template<typename T, typename... Targs>
-	std::string stringFormat(boost::format& fmt, const T& value, const Targs&... Fargs)
-	{
-		fmt % value;
-		return stringFormat(fmt, Fargs...);
-	}
-
-	template<typename T, typename... Targs>
-	std::string stringFormat(const std::string& fmt, const T& value, const Targs&... Fargs)
-	{
-		return stringFormat(boost::format(fmt) % value, Fargs...);
-	}
-
     std::string trimStart(std::string input);
     std::string trimEnd(std::string input);
     std::string trim(const std::string& input);
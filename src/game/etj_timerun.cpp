@@ -49,7 +49,7 @@ std::string millisToString(int millis)
 	seconds = millis / 1000;
 	millis -= seconds * 1000;
 
-	s = (boost::format("%02d:%02d.%03d") % minutes % seconds % millis).str();
+	s = ETJUMP_FORMAT("%02d:%02d.%03d", minutes, seconds, millis);
 
 	return s;
 }
@@ -193,7 +193,7 @@ void Timerun::connectNotify(int clientNum)
 			{
 				fastestCompletionTime = previousRecord->time;
 			}
-			Printer::SendCommand(clientNum, (boost::format("timerun start %d %d %s %d") % idx % player->runStartTime % player->currentRunName % fastestCompletionTime).str());
+			Printer::SendCommand(clientNum, ETJUMP_FORMAT("timerun start %d %d %s %d", idx, player->runStartTime, player->currentRunName, fastestCompletionTime));
 		}
 	}
 }
@@ -209,19 +209,10 @@ void Timerun::startNotify(int clientNum)
 	{
 		fastestCompletionTime = previousRecord->time;
 	}
-	Printer::SendCommand(clientNum, (boost::format("timerun_start %d %s %d")
-	                                 % (player->runStartTime)
-	                                 % player->currentRunName
-	                                 % fastestCompletionTime
-	                                 ).str());
-	Printer::SendCommand(spectators, (boost::format("timerun_start_spec %d %d %s %d")
-	                                  % clientNum
-	                                  % (player->runStartTime)
-	                                  % (player->currentRunName)
-	                                  % fastestCompletionTime
-	                                  ).str());
-
-	Printer::SendCommandToAll((boost::format("timerun start %d %d %s %d") % clientNum % player->runStartTime % player->currentRunName % fastestCompletionTime).str());
+	Printer::SendCommand(clientNum, ETJUMP_FORMAT("timerun_start %d %s %d", player->runStartTime, player->currentRunName, fastestCompletionTime));
+	Printer::SendCommand(spectators, ETJUMP_FORMAT("timerun_start_spec %d %d %s %d", clientNum, player->runStartTime, player->currentRunName, fastestCompletionTime));
+
+	Printer::SendCommandToAll(ETJUMP_FORMAT("timerun start %d %d %s %d", clientNum, player->runStartTime, player->currentRunName, fastestCompletionTime));
 }
 
 bool Timerun::isDebugging(int clientNum)
@@ -277,16 +268,11 @@ void Timerun::stopTimer(int clientNum, int commandTime, std::string runName)
 
 		player->racing = false;
 
-		Printer::SendCommand(clientNum, (boost::format("timerun_stop %d %s")
-		                                 % millis
-		                                 % player->currentRunName).str());
+		Printer::SendCommand(clientNum, ETJUMP_FORMAT("timerun_stop %d %s", millis, player->currentRunName));
 		auto spectators = Utilities::getSpectators(clientNum);
-		Printer::SendCommand(spectators, (boost::format("timerun_stop_spec %d %d %s")
-		                                  % clientNum
-		                                  % millis
-		                                  % player->currentRunName).str());
+		Printer::SendCommand(spectators, ETJUMP_FORMAT("timerun_stop_spec %d %d %s", clientNum, millis, player->currentRunName));
 
-		Printer::SendCommandToAll((boost::format("timerun stop %d %d %s") % clientNum % millis % player->currentRunName).str());
+		Printer::SendCommandToAll(ETJUMP_FORMAT("timerun stop %d %d %s", clientNum, millis, player->currentRunName));
 
 		player->currentRunName = "";
 		Utilities::stopRun(clientNum);
@@ -386,12 +372,12 @@ void Timerun::printRecordsForRun(int clientNum, const std::string& runName)
 		{
 			if (record->userId == self->userId)
 			{
-				buffer   += (boost::format("^7%5s    ^7%s                 ^7%s ^7(^1You^7)\n") % rankToString(rank) % millisToString(record->time) % record->playerName).str();
+				buffer   += ETJUMP_FORMAT("^7%5s    ^7%s                 ^7%s ^7(^1You^7)\n", rankToString(rank), millisToString(record->time), record->playerName);
 			}
 			else
 			{
 				auto diff = foundSelf ? diffToString(selfTime, record->time) : "          "; // Just print bunch of whitespace as difference if client has no record
-				buffer += (boost::format("^7%5s    ^7%s  ^9%s     ^7%s\n") % rankToString(rank) % millisToString(record->time) % diff % record->playerName).str();
+				buffer += ETJUMP_FORMAT("^7%5s    ^7%s  ^9%s     ^7%s\n", rankToString(rank), millisToString(record->time), diff, record->playerName);
 			}
 		}
 		else
@@ -403,7 +389,7 @@ void Timerun::printRecordsForRun(int clientNum, const std::string& runName)
 
 			if (record->userId == self->userId)
 			{
-				buffer   += (boost::format("^7%4s     ^7%s     ^7%s ^7(^1You^7)\n") % rankToString(rank) % millisToString(record->time) % record->playerName).str();
+				buffer   += ETJUMP_FORMAT("^7%4s     ^7%s     ^7%s ^7(^1You^7)\n", rankToString(rank), millisToString(record->time), record->playerName);
 				foundSelf = true;
 			}
 		}
@@ -416,34 +402,51 @@ void Timerun::printRecordsForRun(int clientNum, const std::string& runName)
 	}
 
 	buffer += "^g=============================================================\n";
-	Printer::SendConsoleMessage(clientNum, buffer);
+	Printer::SendConsoleStream(clientNum, buffer);
 }
 
 void Timerun::printCurrentMapRecords(int clientNum)
 {
-	std::string buffer =
-	    "^g=============================================================\n"
-	    " ^2Top records for map: ^7" + _currentMap + "\n"
-	                                                 "^g=============================================================\n";
+	// runs are formatted as they are sent. The next run is looked up by
+	// name as records may be added to the map in between.
+	auto header  = true;
+	auto started = false;
+	std::string previousRun;
+	Printer::SendConsoleStream(clientNum, [this, header, started, previousRun](std::string& output) mutable
+	{
+		if (header)
+		{
+			header = false;
+			output +=
+			    "^g=============================================================\n"
+			    " ^2Top records for map: ^7" + _currentMap + "\n"
+			                                                 "^g=============================================================\n";
+			return true;
+		}
+
+		auto run = started ? _recordsByName.upper_bound(previousRun) : _recordsByName.begin();
+		if (run == _recordsByName.end())
+		{
+			return false;
+		}
+		started     = true;
+		previousRun = run->first;
 
-	for (const auto&run : _recordsByName)
-	{
 		auto rank = 1;
-		buffer += " ^2Run: ^7" + run.first + "\n\n";
-		buffer += "^g Rank   Time        Player\n";
-		for (const auto&record : run.second)
+		output += " ^2Run: ^7" + run->first + "\n\n";
+		output += "^g Rank   Time        Player\n";
+		for (const auto&record : run->second)
 		{
 			if (rank > 3)
 			{
 				break;
 			}
-			buffer += (boost::format("^7 %4s    ^7 %s   %s\n") % rankToString(rank++) % millisToString(record->time) % record->playerName).str();
+			output += ETJUMP_FORMAT("^7 %4s    ^7 %s   %s\n", rankToString(rank++), millisToString(record->time), record->playerName);
 		}
 
-		buffer += "^g=============================================================\n";
-	}
-
-	Printer::SendConsoleMessage(clientNum, buffer);
+		output += "^g=============================================================\n";
+		return true;
+	});
 }
 
 void Timerun::interrupt(int clientNum)
@@ -460,7 +463,7 @@ void Timerun::interrupt(int clientNum)
 
 	Utilities::stopRun(clientNum);
 	Printer::SendCommand(clientNum, "timerun_interrupt");
-	Printer::SendCommandToAll((boost::format("timerun interrupt %d") % clientNum).str());
+	Printer::SendCommandToAll(ETJUMP_FORMAT("timerun interrupt %d", clientNum));
 }
 
 /**
@@ -679,10 +682,7 @@ void Timerun::addNewRecord(Player *player, int clientNum)
 	_recordsByName[player->currentRunName].push_back(std::unique_ptr<Record>(record));
 	_sorted[player->currentRunName] = false;
 	SaveRecord(record, false);
-	Printer::SendCommandToAll((boost::format("record %d \"%s\" %d")
-	                           % clientNum
-	                           % player->currentRunName
-	                           % player->completionTime).str());
+	Printer::SendCommandToAll(ETJUMP_FORMAT("record %d \"%s\" %d", clientNum, player->currentRunName, player->completionTime));
 }
 
 void Timerun::updatePreviousRecord(Record *previousRecord, Player *player, int clientNum)
@@ -692,10 +692,7 @@ void Timerun::updatePreviousRecord(Record *previousRecord, Player *player, int c
 
 	if (previousRecord->time > player->completionTime)
 	{
-		Printer::SendCommandToAll((boost::format("record %d \"%s\" %d")
-		                           % clientNum
-		                           % player->currentRunName
-		                           % player->completionTime).str());
+		Printer::SendCommandToAll(ETJUMP_FORMAT("record %d \"%s\" %d", clientNum, player->currentRunName, player->completionTime));
 
 		previousRecord->time            = player->completionTime;
 		previousRecord->date            = static_cast<int>(currentTime);
@@ -705,10 +702,7 @@ void Timerun::updatePreviousRecord(Record *previousRecord, Player *player, int c
 	}
 	else // Previous record was faster
 	{
-		Printer::SendCommandToAll((boost::format("completion %d \"%s\" %d")
-		                           % clientNum
-		                           % player->currentRunName
-		                           % player->completionTime).str());
+		Printer::SendCommandToAll(ETJUMP_FORMAT("completion %d \"%s\" %d", clientNum, player->currentRunName, player->completionTime));
 	}
 }
 
@@ -0,0 +1,272 @@
+/*
+ * MIT License
+ * 
+ * Copyright (c) 2020 ETJump team <zero@etjump.com>
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <algorithm>
+
+#include "etj_trigger_tree.h"
+
+namespace
+{
+	bool boxesOverlap(const vec3_t amins, const vec3_t amaxs, const vec3_t bmins, const vec3_t bmaxs)
+	{
+		return amins[0] <= bmaxs[0] && amaxs[0] >= bmins[0] &&
+		       amins[1] <= bmaxs[1] && amaxs[1] >= bmins[1] &&
+		       amins[2] <= bmaxs[2] && amaxs[2] >= bmins[2];
+	}
+
+	// triggers that are attached to something or can be picked up are
+	// not worth putting in the tree, they move around too much
+	bool isStaticTrigger(const gentity_t *ent)
+	{
+		return ent->r.bmodel && !ent->client && ent->s.eType != ET_ITEM && !ent->tagParent;
+	}
+}
+
+ETJump::TriggerTree::TriggerTree() : _dirty(false)
+{
+	for (auto& entry : _entries)
+	{
+		entry.state = State::None;
+		VectorClear(entry.absmin);
+		VectorClear(entry.absmax);
+		entry.dynamicIndex = -1;
+	}
+}
+
+ETJump::TriggerTree::~TriggerTree()
+{
+}
+
+void ETJump::TriggerTree::onLinkEntity(const gentity_t *ent)
+{
+	auto  num   = ent->s.number;
+	auto& entry = _entries[num];
+
+	if (!(ent->r.contents & CONTENTS_TRIGGER))
+	{
+		if (entry.state == State::Static)
+		{
+			_dirty = true;
+		}
+		else if (entry.state == State::Dynamic)
+		{
+			removeDynamic(num);
+		}
+		entry.state = State::None;
+		return;
+	}
+
+	switch (entry.state)
+	{
+	case State::None:
+		if (isStaticTrigger(ent))
+		{
+			entry.state = State::Static;
+			VectorCopy(ent->r.absmin, entry.absmin);
+			VectorCopy(ent->r.absmax, entry.absmax);
+			_dirty = true;
+		}
+		else
+		{
+			entry.state        = State::Dynamic;
+			entry.dynamicIndex = _dynamic.size();
+			_dynamic.push_back(num);
+		}
+		break;
+	case State::Static:
+		// linked again at the same place, nothing to do
+		if (VectorCompare(ent->r.absmin, entry.absmin) && VectorCompare(ent->r.absmax, entry.absmax))
+		{
+			break;
+		}
+		// it moved, there's a good chance it will keep moving
+		entry.state        = State::Dynamic;
+		entry.dynamicIndex = _dynamic.size();
+		_dynamic.push_back(num);
+		_dirty = true;
+		break;
+	case State::Dynamic:
+		break;
+	}
+}
+
+void ETJump::TriggerTree::onUnlinkEntity(const gentity_t *ent)
+{
+	// static triggers stay in the tree, unlinked ones are skipped on query
+	if (_entries[ent->s.number].state == State::Dynamic)
+	{
+		removeDynamic(ent->s.number);
+		_entries[ent->s.number].state = State::None;
+	}
+}
+
+void ETJump::TriggerTree::removeDynamic(int entityNum)
+{
+	auto index = _entries[entityNum].dynamicIndex;
+	auto last  = _dynamic.back();
+
+	_dynamic[index]                  = last;
+	_entries[last].dynamicIndex      = index;
+	_entries[entityNum].dynamicIndex = -1;
+	_dynamic.pop_back();
+}
+
+void ETJump::TriggerTree::rebuild()
+{
+	_leafEntities.clear();
+	_nodes.clear();
+
+	for (int i = 0; i < MAX_GENTITIES; i++)
+	{
+		if (_entries[i].state == State::Static)
+		{
+			_leafEntities.push_back(i);
+		}
+	}
+
+	if (!_leafEntities.empty())
+	{
+		_nodes.reserve(2 * _leafEntities.size() / MaxLeafEntities + 1);
+		buildNode(0, _leafEntities.size());
+	}
+
+	_dirty = false;
+}
+
+int ETJump::TriggerTree::buildNode(int first, int count)
+{
+	auto index = static_cast<int>(_nodes.size());
+	_nodes.push_back(Node());
+
+	Node node;
+	VectorCopy(_entries[_leafEntities[first]].absmin, node.mins);
+	VectorCopy(_entries[_leafEntities[first]].absmax, node.maxs);
+	for (int i = first + 1; i < first + count; i++)
+	{
+		AddPointToBounds(_entries[_leafEntities[i]].absmin, node.mins, node.maxs);
+		AddPointToBounds(_entries[_leafEntities[i]].absmax, node.mins, node.maxs);
+	}
+	node.right = -1;
+	node.first = first;
+	node.count = count;
+
+	if (count > MaxLeafEntities)
+	{
+		// split at the median along the longest axis
+		vec3_t size;
+		VectorSubtract(node.maxs, node.mins, size);
+		auto axis = 0;
+		if (size[1] > size[axis])
+		{
+			axis = 1;
+		}
+		if (size[2] > size[axis])
+		{
+			axis = 2;
+		}
+
+		auto begin = _leafEntities.begin() + first;
+		auto half  = count / 2;
+		std::nth_element(begin, begin + half, begin + count, [this, axis](int lhs, int rhs)
+		{
+			return _entries[lhs].absmin[axis] + _entries[lhs].absmax[axis] <
+			       _entries[rhs].absmin[axis] + _entries[rhs].absmax[axis];
+		});
+
+		node.count = 0;
+		buildNode(first, half);
+		node.right = buildNode(first + half, count - half);
+	}
+
+	_nodes[index] = node;
+	return index;
+}
+
+int ETJump::TriggerTree::entitiesInBox(const vec3_t mins, const vec3_t maxs, int *list, int maxcount)
+{
+	if (_dirty)
+	{
+		rebuild();
+	}
+
+	auto num = 0;
+
+	if (!_nodes.empty())
+	{
+		_stack.clear();
+		_stack.push_back(0);
+		while (!_stack.empty() && num < maxcount)
+		{
+			const auto& node = _nodes[_stack.back()];
+			auto nodeIndex   = _stack.back();
+			_stack.pop_back();
+
+			if (!boxesOverlap(mins, maxs, node.mins, node.maxs))
+			{
+				continue;
+			}
+
+			if (node.count > 0)
+			{
+				for (int i = node.first; i < node.first + node.count && num < maxcount; i++)
+				{
+					auto entityNum = _leafEntities[i];
+					const auto& entry = _entries[entityNum];
+					// could have been moved to the dynamic list since the rebuild
+					if (entry.state != State::Static || !g_entities[entityNum].r.linked)
+					{
+						continue;
+					}
+					if (boxesOverlap(mins, maxs, entry.absmin, entry.absmax))
+					{
+						list[num++] = entityNum;
+					}
+				}
+			}
+			else
+			{
+				_stack.push_back(node.right);
+				_stack.push_back(nodeIndex + 1);
+			}
+		}
+	}
+
+	for (auto entityNum : _dynamic)
+	{
+		if (num >= maxcount)
+		{
+			break;
+		}
+
+		const auto *ent = &g_entities[entityNum];
+		if (ent->r.linked && boxesOverlap(mins, maxs, ent->r.absmin, ent->r.absmax))
+		{
+			list[num++] = entityNum;
+		}
+	}
+
+	std::sort(list, list + num);
+
+	return num;
+}
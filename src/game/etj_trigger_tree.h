@@ -0,0 +1,114 @@
+/*
+ * MIT License
+ * 
+ * Copyright (c) 2020 ETJump team <zero@etjump.com>
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <array>
+#include <vector>
+
+#include "g_local.h"
+
+namespace ETJump
+{
+	/**
+	 * Module side index of every linked CONTENTS_TRIGGER entity, so that
+	 * G_TouchTriggers doesn't have to ask the engine for the entities
+	 * around each client on every frame.
+	 *
+	 * Brush triggers that never move are kept in a bounding volume hierarchy,
+	 * which is rebuilt lazily when one of them moves, spawns or goes away.
+	 * Toggling a trigger (unlink + link at the same place) does not require
+	 * a rebuild, unlinked entities are just skipped when querying.
+	 * Everything else (items, portals, moving triggers) is kept in a flat list.
+	 */
+	class TriggerTree
+	{
+	public:
+		TriggerTree();
+		~TriggerTree();
+
+		/**
+		 * Must be called whenever the engine links an entity
+		 * @param ent
+		 */
+		void onLinkEntity(const gentity_t *ent);
+		/**
+		 * Must be called whenever the engine unlinks an entity
+		 * @param ent
+		 */
+		void onUnlinkEntity(const gentity_t *ent);
+		/**
+		 * Module side replacement for trap_EntitiesInBox that only
+		 * returns linked trigger entities. The result is sorted by entity number.
+		 * @param mins
+		 * @param maxs
+		 * @param list
+		 * @param maxcount
+		 * @return the number of entities written to list
+		 */
+		int entitiesInBox(const vec3_t mins, const vec3_t maxs, int *list, int maxcount);
+	private:
+		enum class State
+		{
+			None,
+			Static,
+			Dynamic
+		};
+
+		struct Entry
+		{
+			State state;
+			// static entries remember where they were when added, so we
+			// can tell a toggle from a move when they are linked again
+			vec3_t absmin;
+			vec3_t absmax;
+			// position in _dynamic
+			int dynamicIndex;
+		};
+
+		struct Node
+		{
+			vec3_t mins;
+			vec3_t maxs;
+			// leaf: range in _leafEntities, inner: children are at
+			// index + 1 and right
+			int right;
+			int first;
+			int count;
+		};
+
+		static const int MaxLeafEntities = 4;
+
+		void removeDynamic(int entityNum);
+		void rebuild();
+		int buildNode(int first, int count);
+
+		std::array<Entry, MAX_GENTITIES> _entries;
+		std::vector<int> _dynamic;
+		std::vector<int> _leafEntities;
+		std::vector<Node> _nodes;
+		std::vector<int> _stack;
+		bool _dirty;
+	};
+}
@@ -2,6 +2,7 @@
 #include "g_local.h"
 #include "etj_save_system.h"
 #include "etj_printer.h"
+#include "etj_trigger_tree.h"
 
 /*
 ===============
@@ -327,12 +328,94 @@ void ClientImpacts(gentity_t *ent, pmove_t *pm)
 
 }
 
+/*
+============
+G_CanSweepTriggers
+
+Returns qtrue if the client got from touchTriggersOrigin to the current
+origin by moving, rather than by teleporting, respawning, noclipping etc.
+============
+*/
+static qboolean G_CanSweepTriggers(gclient_t *client)
+{
+	int    msec;
+	vec3_t delta;
+	float  maxDistance;
+
+	if (!client->touchTriggersOriginValid)
+	{
+		return qfalse;
+	}
+
+	if ((client->ps.eFlags & EF_TELEPORT_BIT) != client->touchTriggersTeleportBit)
+	{
+		return qfalse;
+	}
+
+	msec = client->ps.commandTime - client->touchTriggersCommandTime;
+	if (msec <= 0 || msec > 200)
+	{
+		return qfalse;
+	}
+
+	VectorSubtract(client->ps.origin, client->touchTriggersOrigin, delta);
+	if (VectorCompare(delta, vec3_origin))
+	{
+		return qfalse;
+	}
+
+	// allow for acceleration and knockback, but not for position changes
+	// that don't come from the player's own movement
+	maxDistance = 2 * VectorLength(client->ps.velocity) * msec * 0.001f + 32;
+	if (VectorLengthSquared(delta) > maxDistance * maxDistance)
+	{
+		return qfalse;
+	}
+
+	return qtrue;
+}
+
+/*
+============
+G_SweptTriggerContact
+
+Tests whether the player touched the trigger somewhere between start and end.
+The segment is clipped against the trigger bounds first, and the capsule
+is then tested in the middle of the part that overlaps.
+============
+*/
+static qboolean G_SweptTriggerContact(gentity_t *ent, gentity_t *hit, const vec3_t start, const vec3_t end)
+{
+	vec3_t bmins, bmaxs, dir, pos, mins, maxs;
+	float  enter, exit;
+
+	VectorSubtract(hit->r.absmin, ent->r.maxs, bmins);
+	VectorSubtract(hit->r.absmax, ent->r.mins, bmaxs);
+
+	if (!SegmentInBounds(start, end, bmins, bmaxs, &enter, &exit))
+	{
+		return qfalse;
+	}
+
+	VectorSubtract(end, start, dir);
+	VectorMA(start, (enter + exit) * 0.5f, dir, pos);
+	VectorAdd(pos, ent->r.mins, mins);
+	VectorAdd(pos, ent->r.maxs, maxs);
+
+	return trap_EntityContactCapsule(mins, maxs, hit) ? qtrue : qfalse;
+}
+
 /*
 ============
 G_TouchTriggers
 
 Find all trigger entities that ent's current position touches.
 Spectators will only interact with teleporters.
+
+Triggers that the client passed through since the previous call are touched
+as well, so fast players can't skip thin triggers between frames. Triggers
+that client side prediction handles are only tested at the current
+position, so the prediction stays in sync.
 ============
 */
 void    G_TouchTriggers(gentity_t *ent)
@@ -342,6 +425,8 @@ void    G_TouchTriggers(gentity_t *ent)
 	gentity_t     *hit;
 	trace_t       trace;
 	vec3_t        mins, maxs;
+	vec3_t        start, end, point;
+	qboolean      sweep;
 	static vec3_t range = { 40, 40, 52 };
 
 	if (!ent->client)
@@ -358,13 +443,23 @@ void    G_TouchTriggers(gentity_t *ent)
 	// dead clients don't activate triggers!
 	if (ent->client->ps.stats[STAT_HEALTH] <= 0)
 	{
+		ent->client->touchTriggersOriginValid = qfalse;
 		return;
 	}
 
-	VectorSubtract(ent->client->ps.origin, range, mins);
-	VectorAdd(ent->client->ps.origin, range, maxs);
+	VectorCopy(ent->client->ps.origin, end);
+	sweep = G_CanSweepTriggers(ent->client);
+	VectorCopy(sweep ? ent->client->touchTriggersOrigin : end, start);
 
-	num = trap_EntitiesInBox(mins, maxs, touch, MAX_GENTITIES);
+	// the search box covers the whole path since the previous call
+	VectorSubtract(end, range, mins);
+	VectorAdd(end, range, maxs);
+	VectorSubtract(start, range, point);
+	AddPointToBounds(point, mins, maxs);
+	VectorAdd(start, range, point);
+	AddPointToBounds(point, mins, maxs);
+
+	num = ETJump::triggerTree->entitiesInBox(mins, maxs, touch, MAX_GENTITIES);
 
 	// can't use ent->absmin, because that has a one unit pad
 	VectorAdd(ent->client->ps.origin, ent->r.mins, mins);
@@ -415,7 +510,14 @@ void    G_TouchTriggers(gentity_t *ent)
 			if (!trap_EntityContactCapsule(mins, maxs, hit))
 			{
 				//if ( !trap_EntityContact( mins, maxs, hit ) ) {
-				continue;
+				if (!sweep ||
+				    hit->s.eType == ET_TELEPORT_TRIGGER ||
+				    hit->s.eType == ET_PUSH_TRIGGER ||
+				    hit->s.eType == ET_VELOCITY_PUSH_TRIGGER ||
+				    !G_SweptTriggerContact(ent, hit, start, end))
+				{
+					continue;
+				}
 			}
 		}
 
@@ -436,7 +538,19 @@ void    G_TouchTriggers(gentity_t *ent)
 		{
 			ent->touch(ent, hit, &trace);
 		}
+
+		// the path from start to end is no longer valid if the
+		// trigger moved the player somewhere else
+		if (!VectorCompare(end, ent->client->ps.origin))
+		{
+			sweep = qfalse;
+		}
 	}
+
+	ent->client->touchTriggersOriginValid = qtrue;
+	VectorCopy(ent->client->ps.origin, ent->client->touchTriggersOrigin);
+	ent->client->touchTriggersCommandTime = ent->client->ps.commandTime;
+	ent->client->touchTriggersTeleportBit = ent->client->ps.eFlags & EF_TELEPORT_BIT;
 }
 
 /*
@@ -1496,6 +1610,10 @@ void ClientThink_real(gentity_t *ent)
 	{
 		G_TouchTriggers(ent);
 	}
+	else
+	{
+		ent->client->touchTriggersOriginValid = qfalse;
+	}
 
 
 	// execute client events
@@ -1,8 +1,47 @@
 #include "g_local.h"
 
+// head and legs are built outside of the player's bounding box,
+// so rewound clients are culled against slightly padded bounds
+#define ANTILAG_CULL_PADDING 64
+
+static int G_MarkerIndex(const clientMarkerHistory_t *markers, int n)
+{
+	return (markers->top + 1 + n) % MAX_CLIENT_MARKERS;
+}
+
+static void G_UpdateMarkerBounds(clientMarkerHistory_t *markers)
+{
+	int    i;
+	vec3_t point;
+
+	ClearBounds(markers->absmin, markers->absmax);
+	for (i = 0; i < MAX_CLIENT_MARKERS; i++)
+	{
+		VectorAdd(markers->origin[i], markers->mins[i], point);
+		AddPointToBounds(point, markers->absmin, markers->absmax);
+		VectorAdd(markers->origin[i], markers->maxs[i], point);
+		AddPointToBounds(point, markers->absmin, markers->absmax);
+	}
+}
+
+static qboolean G_MarkersNearSegment(const clientMarkerHistory_t *markers, const vec3_t start, const vec3_t end)
+{
+	vec3_t mins, maxs;
+	int    i;
+
+	for (i = 0; i < 3; i++)
+	{
+		mins[i] = markers->absmin[i] - ANTILAG_CULL_PADDING;
+		maxs[i] = markers->absmax[i] + ANTILAG_CULL_PADDING;
+	}
+
+	return SegmentInBounds(start, end, mins, maxs, NULL, NULL);
+}
+
 void G_StoreClientPosition(gentity_t *ent)
 {
-	int top;
+	clientMarkerHistory_t *markers;
+	int                   top;
 
 	if (!(ent->inuse &&
 	      (ent->client->sess.sessionTeam == TEAM_AXIS || ent->client->sess.sessionTeam == TEAM_ALLIES) &&
@@ -15,48 +54,53 @@ void G_StoreClientPosition(gentity_t *ent)
 		return;
 	}
 
-	ent->client->topMarker++;
-	if (ent->client->topMarker >= MAX_CLIENT_MARKERS)
+	markers = &ent->client->markers;
+
+	markers->top++;
+	if (markers->top >= MAX_CLIENT_MARKERS)
 	{
-		ent->client->topMarker = 0;
+		markers->top = 0;
 	}
 
-	top = ent->client->topMarker;
+	top = markers->top;
+
+	VectorCopy(ent->r.mins, markers->mins[top]);
+	VectorCopy(ent->r.maxs, markers->maxs[top]);
+	VectorCopy(ent->s.pos.trBase, markers->origin[top]);
+	markers->time[top] = level.time;
 
-	VectorCopy(ent->r.mins, ent->client->clientMarkers[top].mins);
-	VectorCopy(ent->r.maxs, ent->client->clientMarkers[top].maxs);
-	VectorCopy(ent->s.pos.trBase, ent->client->clientMarkers[top].origin);
-	ent->client->clientMarkers[top].time = level.time;
+	G_UpdateMarkerBounds(markers);
 }
 
 static void G_AdjustSingleClientPosition(gentity_t *ent, int time)
 {
-	int i, j;
+	clientMarkerHistory_t *markers = &ent->client->markers;
+	int                   i, j, lo, hi;
 
 	if (time > level.time)
 	{
 		time = level.time;
 	} // no lerping forward....
 
-	// find a pair of markers which bound the requested time
-	i = j = ent->client->topMarker;
-	do
+	// find a pair of markers which bound the requested time, lo ends up
+	// as the number of markers that aren't newer than the requested time
+	lo = 0;
+	hi = MAX_CLIENT_MARKERS;
+	while (lo < hi)
 	{
-		if (ent->client->clientMarkers[i].time <= time)
+		int mid = (lo + hi) / 2;
+
+		if (markers->time[G_MarkerIndex(markers, mid)] <= time)
 		{
-			break;
+			lo = mid + 1;
 		}
-
-		j = i;
-		i--;
-		if (i < 0)
+		else
 		{
-			i = MAX_CLIENT_MARKERS - 1;
+			hi = mid;
 		}
 	}
-	while (i != ent->client->topMarker);
 
-	if (i == j)    // oops, no valid stored markers
+	if (lo == MAX_CLIENT_MARKERS)    // oops, no valid stored markers
 	{
 		return;
 	}
@@ -70,20 +114,24 @@ static void G_AdjustSingleClientPosition(gentity_t *ent, int time)
 		ent->client->backupMarker.time = level.time;
 	}
 
-	if (i != ent->client->topMarker)
+	j = G_MarkerIndex(markers, lo);
+
+	if (lo > 0)
 	{
-		float frac = (float)(time - ent->client->clientMarkers[i].time) /
-		             (float)(ent->client->clientMarkers[j].time - ent->client->clientMarkers[i].time);
+		float frac;
+
+		i    = G_MarkerIndex(markers, lo - 1);
+		frac = (float)(time - markers->time[i]) / (float)(markers->time[j] - markers->time[i]);
 
-		LerpPosition(ent->client->clientMarkers[i].origin, ent->client->clientMarkers[j].origin, frac, ent->r.currentOrigin);
-		LerpPosition(ent->client->clientMarkers[i].mins, ent->client->clientMarkers[j].mins, frac, ent->r.mins);
-		LerpPosition(ent->client->clientMarkers[i].maxs, ent->client->clientMarkers[j].maxs, frac, ent->r.maxs);
+		LerpPosition(markers->origin[i], markers->origin[j], frac, ent->r.currentOrigin);
+		LerpPosition(markers->mins[i], markers->mins[j], frac, ent->r.mins);
+		LerpPosition(markers->maxs[i], markers->maxs[j], frac, ent->r.maxs);
 	}
 	else
 	{
-		VectorCopy(ent->client->clientMarkers[j].origin, ent->r.currentOrigin);
-		VectorCopy(ent->client->clientMarkers[j].mins, ent->r.mins);
-		VectorCopy(ent->client->clientMarkers[j].maxs, ent->r.maxs);
+		VectorCopy(markers->origin[j], ent->r.currentOrigin);
+		VectorCopy(markers->mins[j], ent->r.mins);
+		VectorCopy(markers->maxs[j], ent->r.maxs);
 	}
 
 	trap_LinkEntity(ent);
@@ -108,7 +156,17 @@ static void G_ReAdjustSingleClientPosition(gentity_t *ent)
 	}
 }
 
-void G_AdjustClientPositions(gentity_t *ent, int time, qboolean forward)
+/*
+==================
+G_AdjustClientPositions
+
+Moves every other client to where they were at the given time, or back
+to where they are now if forward is qfalse. If start is not NULL, only the
+clients whose recent positions are near the segment from start to end are
+moved, as the rest can't be hit by a trace along it anyway.
+==================
+*/
+void G_AdjustClientPositions(gentity_t *ent, int time, qboolean forward, const vec3_t start, const vec3_t end)
 {
 	int       i;
 	gentity_t *list;
@@ -129,6 +187,10 @@ void G_AdjustClientPositions(gentity_t *ent, int time, qboolean forward)
 		{
 			if (forward)
 			{
+				if (start && !G_MarkersNearSegment(&list->client->markers, start, end))
+				{
+					continue;
+				}
 				G_AdjustSingleClientPosition(list, time);
 			}
 			else
@@ -141,9 +203,10 @@ void G_AdjustClientPositions(gentity_t *ent, int time, qboolean forward)
 
 void G_ResetMarkers(gentity_t *ent)
 {
-	int   i, time;
-	char  buffer[MAX_CVAR_VALUE_STRING];
-	float period;
+	clientMarkerHistory_t *markers = &ent->client->markers;
+	int                   i, time;
+	char                  buffer[MAX_CVAR_VALUE_STRING];
+	float                 period;
 
 	trap_Cvar_VariableStringBuffer("sv_fps", buffer, sizeof(buffer) - 1);
 
@@ -157,14 +220,16 @@ void G_ResetMarkers(gentity_t *ent)
 		period = 1000.f / period;
 	}
 
-	ent->client->topMarker = MAX_CLIENT_MARKERS - 1;
+	markers->top = MAX_CLIENT_MARKERS - 1;
 	for (i = MAX_CLIENT_MARKERS - 1, time = level.time; i >= 0; i--, time -= period)
 	{
-		VectorCopy(ent->r.mins, ent->client->clientMarkers[i].mins);
-		VectorCopy(ent->r.maxs, ent->client->clientMarkers[i].maxs);
-		VectorCopy(ent->r.currentOrigin, ent->client->clientMarkers[i].origin);
-		ent->client->clientMarkers[i].time = time;
+		VectorCopy(ent->r.mins, markers->mins[i]);
+		VectorCopy(ent->r.maxs, markers->maxs[i]);
+		VectorCopy(ent->r.currentOrigin, markers->origin[i]);
+		markers->time[i] = time;
 	}
+
+	G_UpdateMarkerBounds(markers);
 }
 
 void G_AttachBodyParts(gentity_t *ent)
@@ -256,7 +321,8 @@ void G_HistoricalTrace(gentity_t *ent, trace_t *results, const vec3_t start, con
 		return;
 	}
 
-	G_AdjustClientPositions(ent, ent->client->pers.cmd.serverTime, qtrue);
+	// box traces are rare enough to not bother culling them
+	G_AdjustClientPositions(ent, ent->client->pers.cmd.serverTime, qtrue, (mins || maxs) ? NULL : start, end);
 
 	G_AttachBodyParts(ent) ;
 
@@ -267,17 +333,18 @@ void G_HistoricalTrace(gentity_t *ent, trace_t *results, const vec3_t start, con
 
 	G_DettachBodyParts();
 
-	G_AdjustClientPositions(ent, 0, qfalse);
+	G_AdjustClientPositions(ent, 0, qfalse, NULL, NULL);
 }
 
-void G_HistoricalTraceBegin(gentity_t *ent)
+// all traces between Begin and End must stay on the segment from start to end
+void G_HistoricalTraceBegin(gentity_t *ent, const vec3_t start, const vec3_t end)
 {
-	G_AdjustClientPositions(ent, ent->client->pers.cmd.serverTime, qtrue);
+	G_AdjustClientPositions(ent, ent->client->pers.cmd.serverTime, qtrue, start, end);
 }
 
 void G_HistoricalTraceEnd(gentity_t *ent)
 {
-	G_AdjustClientPositions(ent, 0, qfalse);
+	G_AdjustClientPositions(ent, 0, qfalse, NULL, NULL);
 }
 
 //bani - Run a trace without fixups (historical fixups will be done externally)
@@ -1,5 +1,7 @@
 #include "g_local.h"
 #include "etj_save_system.h"
+#include "etj_reliable_command_queue.h"
+#include "etj_paced_printer.h"
 
 // g_client.c -- client functions that don't happen every frame
 
@@ -2683,6 +2685,8 @@ void ClientDisconnect(int clientNum)
 	// OSP
 
 	ETJump::saveSystem->savePositionsToDatabase(ent);
+	ETJump::pacedPrinter->cancel(clientNum);
+	ETJump::reliableCommandQueue->clear(clientNum);
 
 	ClearPortals(ent);
 }
@@ -882,6 +882,8 @@ typedef struct
 	int lastBattleSenseBonusTime;
 	int lastHQMineReportTime;
 	int lastCCPulseTime;
+	int lastCCPulseSendTime;            // last time entnfo was actually sent
+	unsigned int lastCCPulseHash;       // hash of the last sent entnfo
 
 	int lastSpawnTime;
 
@@ -935,6 +937,24 @@ typedef struct
 
 #define MAX_CLIENT_MARKERS 10
 
+// antilag position history as a ring of separate arrays, so that the
+// binary search by time only touches the times. The oldest marker is the
+// one after top.
+typedef struct
+{
+	int time[MAX_CLIENT_MARKERS];
+	vec3_t origin[MAX_CLIENT_MARKERS];
+	vec3_t mins[MAX_CLIENT_MARKERS];
+	vec3_t maxs[MAX_CLIENT_MARKERS];
+
+	int top;
+
+	// bounds of all stored positions, used to skip rewinding clients
+	// that are nowhere near the trace
+	vec3_t absmin;
+	vec3_t absmax;
+} clientMarkerHistory_t;
+
 #define NUM_SOLDIERKILL_TIMES 10
 #define SOLDIERKILL_MAXTIME 60000
 
@@ -1057,8 +1077,7 @@ struct gclient_s
 
 	combatstate_t combatState;
 
-	int topMarker;
-	clientMarker_t clientMarkers[MAX_CLIENT_MARKERS];
+	clientMarkerHistory_t markers;
 	clientMarker_t backupMarker;
 
 	gentity_t *tempHead;        // Gordon: storing a temporary head for bullet head shot detection
@@ -1100,6 +1119,13 @@ struct gclient_s
 	// Time when client activated trigger_multiple
 	int multiTriggerActivationTime;
 
+	// Where G_TouchTriggers last tested the client, used to sweep
+	// triggers between frames
+	qboolean touchTriggersOriginValid;
+	vec3_t touchTriggersOrigin;
+	int touchTriggersCommandTime;
+	int touchTriggersTeleportBit;
+
 	// Time when client activated trigger_push
 	int pushTriggerActivationTime;
 
@@ -2036,6 +2062,10 @@ extern vmCvar_t g_customMapVotesFile;
 extern vmCvar_t g_timerunsDatabase;
 // End of timeruns support
 
+extern vmCvar_t g_savedPositionsDatabase;
+extern vmCvar_t g_savedPositionsCacheSize;
+extern vmCvar_t g_savedPositionsExpiry;
+
 // tokens
 extern vmCvar_t g_tokensMode;
 extern vmCvar_t g_tokensPath;
@@ -2076,6 +2106,8 @@ void    trap_Cvar_LatchedVariableStringBuffer(const char *var_name, char *buffer
 void    trap_LocateGameData(gentity_t *gEnts, int numGEntities, int sizeofGEntity_t, playerState_t *gameClients, int sizeofGameClient);
 void    trap_DropClient(int clientNum, const char *reason, int length);
 void    trap_SendServerCommand(int clientNum, const char *text);
+// sends without flushing the client's reliable command queue first
+void    trap_SendServerCommandNow(int clientNum, const char *text);
 void    trap_SetConfigstring(int num, const char *string);
 void    trap_GetConfigstring(int num, char *buffer, int bufferSize);
 void    trap_GetUserinfo(int num, char *buffer, int bufferSize);
@@ -2308,10 +2340,10 @@ void trap_PbStat(int clientNum, const char *category, const char *values) ;
 
 // g_antilag.c
 void G_StoreClientPosition(gentity_t *ent);
-void G_AdjustClientPositions(gentity_t *ent, int time, qboolean forward);
+void G_AdjustClientPositions(gentity_t *ent, int time, qboolean forward, const vec3_t start, const vec3_t end);
 void G_ResetMarkers(gentity_t *ent);
 void G_HistoricalTrace(gentity_t *ent, trace_t *results, const vec3_t start, const vec3_t mins, const vec3_t maxs, const vec3_t end, int passEntityNum, int contentmask);
-void G_HistoricalTraceBegin(gentity_t *ent);
+void G_HistoricalTraceBegin(gentity_t *ent, const vec3_t start, const vec3_t end);
 void G_HistoricalTraceEnd(gentity_t *ent);
 void G_Trace(gentity_t *ent, trace_t *results, const vec3_t start, const vec3_t mins, const vec3_t maxs, const vec3_t end, int passEntityNum, int contentmask);
 
@@ -2365,6 +2397,7 @@ typedef struct mapEntityData_Team_s
 	mapEntityData_t mapEntityData_Team[MAX_GENTITIES];
 	mapEntityData_t *freeMapEntityData;                 // single linked list
 	mapEntityData_t activeMapEntityData;                // double linked list
+	mapEntityData_t *entityIndex[MAX_GENTITIES];        // entNum -> shared (non single client) entry
 } mapEntityData_Team_t;
 
 extern mapEntityData_Team_t mapEntityData[2];
@@ -2372,6 +2405,7 @@ extern mapEntityData_Team_t mapEntityData[2];
 void G_InitMapEntityData(mapEntityData_Team_t *teamList);
 mapEntityData_t *G_FreeMapEntityData(mapEntityData_Team_t *teamList, mapEntityData_t *mEnt);
 mapEntityData_t *G_AllocMapEntityData(mapEntityData_Team_t *teamList);
+mapEntityData_t *G_AllocMapEntityDataForEntity(mapEntityData_Team_t *teamList, int entNum);
 mapEntityData_t *G_FindMapEntityData(mapEntityData_Team_t *teamList, int entNum);
 mapEntityData_t *G_FindMapEntityDataSingleClient(mapEntityData_Team_t *teamList, mapEntityData_t *start, int entNum, int clientNum);
 
@@ -2540,6 +2574,7 @@ typedef struct
 // g_main.c
 //
 void G_UpdateCvars(void);
+void G_CvarSet(const char *var_name);
 void G_wipeCvars(void);
 
 
@@ -2783,6 +2818,12 @@ namespace ETJump
 	extern std::shared_ptr<ETJump::DeathrunSystem> deathrunSystem;
 	class SaveSystem;
 	extern std::shared_ptr<ETJump::SaveSystem> saveSystem;
+	class TriggerTree;
+	extern std::shared_ptr<ETJump::TriggerTree> triggerTree;
+	class ReliableCommandQueue;
+	extern std::shared_ptr<ETJump::ReliableCommandQueue> reliableCommandQueue;
+	class PacedPrinter;
+	extern std::shared_ptr<ETJump::PacedPrinter> pacedPrinter;
 	extern std::shared_ptr<Session> session;
 	extern std::shared_ptr<Database> database;
 }
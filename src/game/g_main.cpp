@@ -5,6 +5,10 @@
 #include "etj_database.h"
 #include "etj_session.h"
 #include "etj_save_system.h"
+#include "etj_trigger_tree.h"
+#include "etj_reliable_command_queue.h"
+#include "etj_paced_printer.h"
+#include "etj_cvar_update_scheduler.h"
 #include "etj_printer.h"
 #include "etj_string_utilities.h"
 
@@ -20,6 +24,7 @@ typedef struct
 	qboolean trackChange;           // track this variable, and announce if changed
 	qboolean fConfigReset;          // OSP: set this var to the default on a config reset
 	qboolean teamShader;            // track and if changed, update shader state
+	qboolean everyFrame;            // polled on every frame instead of in round-robin slices, required for anything pmove reads
 } cvarTable_t;
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -30,6 +35,9 @@ namespace ETJump
 {
 	std::shared_ptr<DeathrunSystem> deathrunSystem;
 	std::shared_ptr<SaveSystem> saveSystem;
+	std::shared_ptr<TriggerTree> triggerTree;
+	std::shared_ptr<ReliableCommandQueue> reliableCommandQueue;
+	std::shared_ptr<PacedPrinter> pacedPrinter;
 	std::shared_ptr<Database> database;
 	std::shared_ptr<Session> session;
 }
@@ -44,6 +52,20 @@ static void initializeETJump()
 	ETJump::database = std::make_shared<Database>();
 	ETJump::session = std::make_shared<Session>(ETJump::database);
 	ETJump::saveSystem = std::make_shared<ETJump::SaveSystem>(ETJump::session);
+	ETJump::triggerTree = std::make_shared<ETJump::TriggerTree>();
+	ETJump::reliableCommandQueue = std::make_shared<ETJump::ReliableCommandQueue>(level.maxclients,
+		[](int clientNum, const std::string& command)
+	{
+		if (level.clients[clientNum].pers.connected != CON_DISCONNECTED)
+		{
+			trap_SendServerCommandNow(clientNum, command.c_str());
+		}
+	});
+	ETJump::pacedPrinter = std::make_shared<ETJump::PacedPrinter>(level.maxclients,
+		[](int clientNum, const std::string& text)
+	{
+		Printer::SendConsoleMessage(clientNum, text);
+	});
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -53,7 +75,18 @@ static void initializeETJump()
 static void shutdownETJump()
 {
 	ETJump::deathrunSystem = nullptr;
+	if (ETJump::saveSystem)
+	{
+		ETJump::saveSystem->saveConnectedPositionsToDatabase();
+	}
 	ETJump::saveSystem = nullptr;
+	ETJump::triggerTree = nullptr;
+	ETJump::pacedPrinter = nullptr;
+	if (ETJump::reliableCommandQueue)
+	{
+		ETJump::reliableCommandQueue->flushAll();
+	}
+	ETJump::reliableCommandQueue = nullptr;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -271,6 +304,10 @@ vmCvar_t g_customMapVotesFile;
 vmCvar_t g_timerunsDatabase;
 // End of timeruns support
 
+vmCvar_t g_savedPositionsDatabase;
+vmCvar_t g_savedPositionsCacheSize;
+vmCvar_t g_savedPositionsExpiry;
+
 vmCvar_t g_chatOptions;
 
 // tokens
@@ -296,7 +333,7 @@ vmCvar_t g_enableVote;
 cvarTable_t gameCvarTable[] =
 {
 	// don't override the cheat state set by the system
-	{ &g_cheats,                    "sv_cheats",                   "",                                                       0,                                               qfalse },
+	{ &g_cheats,                    "sv_cheats",                   "",                                                       0,                                               qfalse, qfalse, qfalse, qfalse, qtrue },
 
 	// noset vars
 	{ NULL,                         "gamename",                    GAME_NAME,                                                CVAR_SERVERINFO | CVAR_ROM,                      0, qfalse},
@@ -305,7 +342,7 @@ cvarTable_t gameCvarTable[] =
 	{ NULL,                         "sv_mapname",                  "",                                                       CVAR_SERVERINFO | CVAR_ROM,                      0, qfalse},
 
 	// latched vars
-	{ &g_gametype,                  "g_gametype",                  "2",                                                      CVAR_SERVERINFO | CVAR_LATCH,                    0, qfalse}, // Arnout: default to GT_WOLF_CAMPAIGN
+	{ &g_gametype,                  "g_gametype",                  "2",                                                      CVAR_SERVERINFO | CVAR_LATCH,                    0, qfalse, qfalse, qfalse, qtrue}, // Arnout: default to GT_WOLF_CAMPAIGN
 
 // JPW NERVE multiplayer stuffs
 	{ &g_redlimbotime,              "g_redlimbotime",              "30000",                                                  CVAR_SERVERINFO | CVAR_LATCH,                    0, qfalse},
@@ -336,7 +373,7 @@ cvarTable_t gameCvarTable[] =
 	{ &g_nextTimeLimit,             "g_nextTimeLimit",             "0",                                                      CVAR_WOLFINFO,                                   0, qfalse},
 	{ &g_currentRound,              "g_currentRound",              "0",                                                      CVAR_WOLFINFO,                                   0, qfalse, qtrue},
 	{ &g_altStopwatchMode,          "g_altStopwatchMode",          "0",                                                      CVAR_ARCHIVE,                                    0, qtrue, qtrue},
-	{ &g_gamestate,                 "gamestate",                   "-1",                                                     CVAR_WOLFINFO | CVAR_ROM,                        0, qfalse},
+	{ &g_gamestate,                 "gamestate",                   "-1",                                                     CVAR_WOLFINFO | CVAR_ROM,                        0, qfalse, qfalse, qfalse, qtrue},
 
 	{ &g_noTeamSwitching,           "g_noTeamSwitching",           "0",                                                      CVAR_ARCHIVE,                                    0, qtrue},
 
@@ -360,14 +397,14 @@ cvarTable_t gameCvarTable[] =
 
 	{ &g_dedicated,                 "dedicated",                   "0",                                                      0,                                               0, qfalse},
 
-	{ &g_knockback,                 "g_knockback",                 "1000",                                                   0,                                               0, qtrue, qtrue},
+	{ &g_knockback,                 "g_knockback",                 "1000",                                                   0,                                               0, qtrue, qtrue, qfalse, qtrue},
 	{ &g_quadfactor,                "g_quadfactor",                "3",                                                      0,                                               0, qtrue},
 
 	{ &g_needpass,                  "g_needpass",                  "0",                                                      CVAR_SERVERINFO | CVAR_ROM,                      0, qtrue},
 	{ &g_forcerespawn,              "g_forcerespawn",              "0",                                                      0,                                               0, qtrue},
 	{ &g_forcerespawn,              "g_forcerespawn",              "0",                                                      0,                                               0, qtrue},
 	{ &g_inactivity,                "g_inactivity",                "0",                                                      0,                                               0, qtrue},
-	{ &g_debugMove,                 "g_debugMove",                 "0",                                                      0,                                               0, qfalse},
+	{ &g_debugMove,                 "g_debugMove",                 "0",                                                      0,                                               0, qfalse, qfalse, qfalse, qtrue},
 	{ &g_debugDamage,               "g_debugDamage",               "0",                                                      CVAR_CHEAT,                                      0, qfalse},
 	{ &g_debugAlloc,                "g_debugAlloc",                "0",                                                      0,                                               0, qfalse},
 	{ &g_debugBullets,              "g_debugBullets",              "0",                                                      CVAR_CHEAT,                                      0, qfalse}, //----(SA)	added
@@ -389,14 +426,14 @@ cvarTable_t gameCvarTable[] =
 	{ &g_userAim,                   "g_userAim",                   "1",                                                      CVAR_CHEAT,                                      0, qfalse},
 
 	{ &g_smoothClients,             "g_smoothClients",             "1",                                                      0,                                               0, qfalse},
-	{ &pmove_fixed,                 "pmove_fixed",                 "0",                                                      0,                                               0, qfalse},
-	{ &pmove_msec,                  "pmove_msec",                  "8",                                                      CVAR_SYSTEMINFO,                                 0, qfalse},
+	{ &pmove_fixed,                 "pmove_fixed",                 "0",                                                      0,                                               0, qfalse, qfalse, qfalse, qtrue},
+	{ &pmove_msec,                  "pmove_msec",                  "8",                                                      CVAR_SYSTEMINFO,                                 0, qfalse, qfalse, qfalse, qtrue},
 
 	{ &g_footstepAudibleRange,      "g_footstepAudibleRange",      "256",                                                    CVAR_CHEAT,                                      0, qfalse},
 
 	{ &g_scriptName,                "g_scriptName",                "",                                                       CVAR_CHEAT,                                      0, qfalse},
 
-	{ &g_antilag,                   "g_antilag",                   "1",                                                      CVAR_SERVERINFO | CVAR_ARCHIVE,                  0, qfalse},
+	{ &g_antilag,                   "g_antilag",                   "1",                                                      CVAR_SERVERINFO | CVAR_ARCHIVE,                  0, qfalse, qfalse, qfalse, qtrue},
 
 	//bani - #184
 	{ NULL,                         "P",                           "",                                                       CVAR_SERVERINFO_NOUPDATE,                        0, qfalse, qfalse},
@@ -437,7 +474,7 @@ cvarTable_t gameCvarTable[] =
 
 	// How fast do we want Allied single player movement?
 //	{ &g_movespeed, "g_movespeed", "127", CVAR_CHEAT, 0, qfalse },
-	{ &g_movespeed,                 "g_movespeed",                 "76",                                                     CVAR_CHEAT,                                      0, qfalse},
+	{ &g_movespeed,                 "g_movespeed",                 "76",                                                     CVAR_CHEAT,                                      0, qfalse, qfalse, qfalse, qtrue},
 
 	// Arnout: LMS
 	{ &g_axiswins,                  "g_axiswins",                  "0",                                                      CVAR_ROM,                                        0, qfalse, qtrue},
@@ -449,7 +486,7 @@ cvarTable_t gameCvarTable[] =
 
 
 #ifdef SAVEGAME_SUPPORT
-	{ &g_reloading,                 "g_reloading",                 "0",                                                      CVAR_ROM },
+	{ &g_reloading,                 "g_reloading",                 "0",                                                      CVAR_ROM,                                        0, qfalse, qfalse, qfalse, qtrue },
 #endif // SAVEGAME_SUPPORT
 
 	// points to the URL for mod information, should not be modified by server admin
@@ -476,7 +513,7 @@ cvarTable_t gameCvarTable[] =
 	{ &g_floodlimit,                "g_floodlimit",                "5",                                                      CVAR_ARCHIVE },
 	{ &g_floodwait,                 "g_floodwait",                 "768",                                                    CVAR_ARCHIVE },
 
-	{ &g_ghostPlayers,              "g_ghostPlayers",              "1",                                                      CVAR_SERVERINFO | CVAR_LATCH },
+	{ &g_ghostPlayers,              "g_ghostPlayers",              "1",                                                      CVAR_SERVERINFO | CVAR_LATCH,                    0, qfalse, qfalse, qfalse, qtrue },
 	{ &g_nofatigue,                 "g_nofatigue",                 "1",                                                      CVAR_ARCHIVE },
 	{ &g_blockCheatCvars,           "g_blockCheatCvars",           "0",                                                      CVAR_ARCHIVE },
 	{ &g_weapons,                   "g_weapons",                   "1",                                                      CVAR_ARCHIVE },
@@ -529,6 +566,10 @@ cvarTable_t gameCvarTable[] =
 	{ &g_timerunsDatabase,          "g_timerunsDatabase",          "timeruns.db",                                            CVAR_ARCHIVE },
 	// End of timeruns support
 
+	{ &g_savedPositionsDatabase,    "g_savedPositionsDatabase",    "savedpositions.db",                                      CVAR_ARCHIVE | CVAR_LATCH },
+	{ &g_savedPositionsCacheSize,   "g_savedPositionsCacheSize",   "64",                                                     CVAR_ARCHIVE | CVAR_LATCH },
+	{ &g_savedPositionsExpiry,      "g_savedPositionsExpiry",      "30",                                                     CVAR_ARCHIVE | CVAR_LATCH },
+
 	{ &g_chatOptions,               "g_chatOptions",               "1",                                                      CVAR_ARCHIVE },
 
 	// tokens
@@ -538,7 +579,7 @@ cvarTable_t gameCvarTable[] =
 
 	{ &g_customVoiceChat,           "g_customVoiceChat",           "1",                                                      CVAR_ARCHIVE },
 
-	{ &shared, "shared", "0", CVAR_SERVERINFO | CVAR_SYSTEMINFO | CVAR_ROM },
+	{ &shared, "shared", "0", CVAR_SERVERINFO | CVAR_SYSTEMINFO | CVAR_ROM, 0, qfalse, qfalse, qfalse, qtrue },
 	{ &vote_minVoteDuration, "vote_minVoteDuration", "5000", CVAR_ARCHIVE },
 	{ &g_moverScale, "g_moverScale", "1.0", 0 },
 	{ &g_debugTrackers, "g_debugTrackers", "0", CVAR_ARCHIVE | CVAR_LATCH },
@@ -550,6 +591,7 @@ cvarTable_t gameCvarTable[] =
 
 // bk001129 - made static to avoid aliasing
 static int gameCvarTableSize = sizeof(gameCvarTable) / sizeof(gameCvarTable[0]);
+static ETJump::CvarUpdateScheduler cvarUpdateScheduler;
 
 void G_InitGame(int levelTime, int randomSeed, int restart);
 void G_RunFrame(int levelTime);
@@ -1488,6 +1530,15 @@ void G_RegisterCvars(void)
 		remapped = (remapped || cv->teamShader) ? qtrue : qfalse;
 	}
 
+	cvarUpdateScheduler.clear();
+	for (i = 0, cv = gameCvarTable; i < gameCvarTableSize; i++, cv++)
+	{
+		if (cv->vmCvar)
+		{
+			cvarUpdateScheduler.add(i, cv->cvarName, cv->everyFrame ? true : false);
+		}
+	}
+
 	if (remapped)
 	{
 		G_RemapTeamShaders();
@@ -1520,6 +1571,19 @@ void G_RegisterCvars(void)
 
 }
 
+/*
+=================
+G_CvarSet
+
+Called when the game sets a cvar, so the change is picked up
+on the next frame instead of when its slice comes around.
+=================
+*/
+void G_CvarSet(const char *var_name)
+{
+	cvarUpdateScheduler.cvarSet(var_name);
+}
+
 /*
 =================
 G_UpdateCvars
@@ -1527,143 +1591,146 @@ G_UpdateCvars
 */
 void G_UpdateCvars(void)
 {
-	int         i;
-	cvarTable_t *cv;
+	static std::vector<cvarTable_t *> modified;
 	qboolean    fToggles          = qfalse;
 	qboolean    fVoteFlags        = qfalse;
 	qboolean    remapped          = qfalse;
 	qboolean    chargetimechanged = qfalse;
 
-	for (i = 0, cv = gameCvarTable ; i < gameCvarTableSize ; i++, cv++)
+	// most cvars are polled in round-robin slices, see CvarUpdateScheduler
+	modified.clear();
+	for (auto index : cvarUpdateScheduler.nextFrame())
 	{
-		if (cv->vmCvar)
-		{
-			trap_Cvar_Update(cv->vmCvar);
-
-			if (cv->modificationCount != cv->vmCvar->modificationCount)
-			{
-				cv->modificationCount = cv->vmCvar->modificationCount;
+		auto cv = &gameCvarTable[index];
 
-				if (cv->trackChange && !(cv->cvarFlags & CVAR_LATCH))
-				{
-					trap_SendServerCommand(-1, va("print \"Server:[lof] %s [lon]changed to[lof] %s\n\"", cv->cvarName, cv->vmCvar->string));
-				}
+		trap_Cvar_Update(cv->vmCvar);
+		if (cv->modificationCount != cv->vmCvar->modificationCount)
+		{
+			cv->modificationCount = cv->vmCvar->modificationCount;
+			modified.push_back(cv);
+		}
+	}
 
-				if (cv->teamShader)
-				{
-					remapped = qtrue;
-				}
+	for (auto cv : modified)
+	{
+		if (cv->trackChange && !(cv->cvarFlags & CVAR_LATCH))
+		{
+			trap_SendServerCommand(-1, va("print \"Server:[lof] %s [lon]changed to[lof] %s\n\"", cv->cvarName, cv->vmCvar->string));
+		}
 
-				if (cv->vmCvar == &g_filtercams)
-				{
-					trap_SetConfigstring(CS_FILTERCAMS, va("%i", g_filtercams.integer));
-				}
+		if (cv->teamShader)
+		{
+			remapped = qtrue;
+		}
 
-				if (cv->vmCvar == &g_soldierChargeTime)
-				{
-					level.soldierChargeTime[0] = g_soldierChargeTime.integer * level.soldierChargeTimeModifier[0];
-					level.soldierChargeTime[1] = g_soldierChargeTime.integer * level.soldierChargeTimeModifier[1];
-					chargetimechanged          = qtrue;
-				}
-				else if (cv->vmCvar == &g_medicChargeTime)
-				{
-					level.medicChargeTime[0] = g_medicChargeTime.integer * level.medicChargeTimeModifier[0];
-					level.medicChargeTime[1] = g_medicChargeTime.integer * level.medicChargeTimeModifier[1];
-					chargetimechanged        = qtrue;
-				}
-				else if (cv->vmCvar == &g_engineerChargeTime)
-				{
-					level.engineerChargeTime[0] = g_engineerChargeTime.integer * level.engineerChargeTimeModifier[0];
-					level.engineerChargeTime[1] = g_engineerChargeTime.integer * level.engineerChargeTimeModifier[1];
-					chargetimechanged           = qtrue;
-				}
-				else if (cv->vmCvar == &g_LTChargeTime)
-				{
-					level.lieutenantChargeTime[0] = g_LTChargeTime.integer * level.lieutenantChargeTimeModifier[0];
-					level.lieutenantChargeTime[1] = g_LTChargeTime.integer * level.lieutenantChargeTimeModifier[1];
-					chargetimechanged             = qtrue;
-				}
-				else if (cv->vmCvar == &g_covertopsChargeTime)
-				{
-					level.covertopsChargeTime[0] = g_covertopsChargeTime.integer * level.covertopsChargeTimeModifier[0];
-					level.covertopsChargeTime[1] = g_covertopsChargeTime.integer * level.covertopsChargeTimeModifier[1];
-					chargetimechanged            = qtrue;
-				}
-				else if (cv->vmCvar == &match_readypercent)
-				{
-					if (match_readypercent.integer < 1)
-					{
-						trap_Cvar_Set(cv->cvarName, "1");
-					}
-					else if (match_readypercent.integer > 100)
-					{
-						trap_Cvar_Set(cv->cvarName, "100");
-					}
-				}
-				else if (cv->vmCvar == &g_warmup)
-				{
-					if (g_gamestate.integer != GS_PLAYING && !G_IsSinglePlayerGame())
-					{
-						level.warmupTime = level.time + (((g_warmup.integer < 10) ? 11 : g_warmup.integer + 1) * 1000);
-						trap_SetConfigstring(CS_WARMUP, va("%i", level.warmupTime));
-					}
-				}
-				// Moved this check out of the main world think loop
-				else if (cv->vmCvar == &g_gametype)
-				{
-					int  worldspawnflags = g_entities[ENTITYNUM_WORLD].spawnflags;
-					int  gt;
-					char buffer[32];
+		if (cv->vmCvar == &g_filtercams)
+		{
+			trap_SetConfigstring(CS_FILTERCAMS, va("%i", g_filtercams.integer));
+		}
 
-					trap_Cvar_LatchedVariableStringBuffer("g_gametype", buffer, sizeof(buffer));
+		if (cv->vmCvar == &g_soldierChargeTime)
+		{
+			level.soldierChargeTime[0] = g_soldierChargeTime.integer * level.soldierChargeTimeModifier[0];
+			level.soldierChargeTime[1] = g_soldierChargeTime.integer * level.soldierChargeTimeModifier[1];
+			chargetimechanged          = qtrue;
+		}
+		else if (cv->vmCvar == &g_medicChargeTime)
+		{
+			level.medicChargeTime[0] = g_medicChargeTime.integer * level.medicChargeTimeModifier[0];
+			level.medicChargeTime[1] = g_medicChargeTime.integer * level.medicChargeTimeModifier[1];
+			chargetimechanged        = qtrue;
+		}
+		else if (cv->vmCvar == &g_engineerChargeTime)
+		{
+			level.engineerChargeTime[0] = g_engineerChargeTime.integer * level.engineerChargeTimeModifier[0];
+			level.engineerChargeTime[1] = g_engineerChargeTime.integer * level.engineerChargeTimeModifier[1];
+			chargetimechanged           = qtrue;
+		}
+		else if (cv->vmCvar == &g_LTChargeTime)
+		{
+			level.lieutenantChargeTime[0] = g_LTChargeTime.integer * level.lieutenantChargeTimeModifier[0];
+			level.lieutenantChargeTime[1] = g_LTChargeTime.integer * level.lieutenantChargeTimeModifier[1];
+			chargetimechanged             = qtrue;
+		}
+		else if (cv->vmCvar == &g_covertopsChargeTime)
+		{
+			level.covertopsChargeTime[0] = g_covertopsChargeTime.integer * level.covertopsChargeTimeModifier[0];
+			level.covertopsChargeTime[1] = g_covertopsChargeTime.integer * level.covertopsChargeTimeModifier[1];
+			chargetimechanged            = qtrue;
+		}
+		else if (cv->vmCvar == &match_readypercent)
+		{
+			if (match_readypercent.integer < 1)
+			{
+				trap_Cvar_Set(cv->cvarName, "1");
+			}
+			else if (match_readypercent.integer > 100)
+			{
+				trap_Cvar_Set(cv->cvarName, "100");
+			}
+		}
+		else if (cv->vmCvar == &g_warmup)
+		{
+			if (g_gamestate.integer != GS_PLAYING && !G_IsSinglePlayerGame())
+			{
+				level.warmupTime = level.time + (((g_warmup.integer < 10) ? 11 : g_warmup.integer + 1) * 1000);
+				trap_SetConfigstring(CS_WARMUP, va("%i", level.warmupTime));
+			}
+		}
+		// Moved this check out of the main world think loop
+		else if (cv->vmCvar == &g_gametype)
+		{
+			int  worldspawnflags = g_entities[ENTITYNUM_WORLD].spawnflags;
+			int  gt;
+			char buffer[32];
 
-					if (!level.latchGametype && g_gamestate.integer == GS_PLAYING &&
-					    (((g_gametype.integer == GT_WOLF || g_gametype.integer == GT_WOLF_CAMPAIGN) && (worldspawnflags & NO_GT_WOLF)) ||
-					     (g_gametype.integer == GT_WOLF_STOPWATCH && (worldspawnflags & NO_STOPWATCH)) ||
-					     (g_gametype.integer == GT_WOLF_LMS && (worldspawnflags & NO_LMS)))
-					    )
-					{
+			trap_Cvar_LatchedVariableStringBuffer("g_gametype", buffer, sizeof(buffer));
 
-						if (!(worldspawnflags & NO_GT_WOLF))
-						{
-							gt = GT_WOLF;   // Default wolf
-						}
-						else
-						{
-							gt = GT_WOLF_LMS;   // Last man standing
-						}
+			if (!level.latchGametype && g_gamestate.integer == GS_PLAYING &&
+			    (((g_gametype.integer == GT_WOLF || g_gametype.integer == GT_WOLF_CAMPAIGN) && (worldspawnflags & NO_GT_WOLF)) ||
+			     (g_gametype.integer == GT_WOLF_STOPWATCH && (worldspawnflags & NO_STOPWATCH)) ||
+			     (g_gametype.integer == GT_WOLF_LMS && (worldspawnflags & NO_LMS)))
+			    )
+			{
 
-						level.latchGametype = qtrue;
-						AP("print \"Invalid gametype was specified, Restarting\n\"");
-						trap_SendConsoleCommand(EXEC_APPEND, va("wait 2 ; g_gametype %i ; map_restart 10 0\n", gt));
-					}
-				}
-				else if (cv->vmCvar == &pmove_msec)
+				if (!(worldspawnflags & NO_GT_WOLF))
 				{
-					if (pmove_msec.integer < 8)
-					{
-						trap_Cvar_Set(cv->cvarName, "8");
-					}
-					else if (pmove_msec.integer > 33)
-					{
-						trap_Cvar_Set(cv->cvarName, "33");
-					}
+					gt = GT_WOLF;   // Default wolf
 				}
-				// OSP - Update vote info for clients, if necessary
-				else if (!G_IsSinglePlayerGame())
+				else
 				{
-					if (cv->vmCvar == &vote_allow_map ||
-					    cv->vmCvar == &vote_allow_matchreset ||
-						cv->vmCvar == &vote_allow_randommap ||
-						cv->vmCvar == &g_enableVote)
-					{
-						fVoteFlags = qtrue;
-					}
-					else
-					{
-						fToggles = (G_checkServerToggle(cv->vmCvar) || fToggles) ? qtrue : qfalse;
-					}
+					gt = GT_WOLF_LMS;   // Last man standing
 				}
+
+				level.latchGametype = qtrue;
+				AP("print \"Invalid gametype was specified, Restarting\n\"");
+				trap_SendConsoleCommand(EXEC_APPEND, va("wait 2 ; g_gametype %i ; map_restart 10 0\n", gt));
+			}
+		}
+		else if (cv->vmCvar == &pmove_msec)
+		{
+			if (pmove_msec.integer < 8)
+			{
+				trap_Cvar_Set(cv->cvarName, "8");
+			}
+			else if (pmove_msec.integer > 33)
+			{
+				trap_Cvar_Set(cv->cvarName, "33");
+			}
+		}
+		// OSP - Update vote info for clients, if necessary
+		else if (!G_IsSinglePlayerGame())
+		{
+			if (cv->vmCvar == &vote_allow_map ||
+			    cv->vmCvar == &vote_allow_matchreset ||
+				cv->vmCvar == &vote_allow_randommap ||
+				cv->vmCvar == &g_enableVote)
+			{
+				fVoteFlags = qtrue;
+			}
+			else
+			{
+				fToggles = (G_checkServerToggle(cv->vmCvar) || fToggles) ? qtrue : qfalse;
 			}
 		}
 	}
@@ -4101,6 +4168,11 @@ uebrgpiebrpgibqeripgubeqrpigubqifejbgipegbrtibgurepqgbn%i", level.time)
 	G_CheckReloadStatus();
 #endif // SAVEGAME_SUPPORT
 	ETJump_RunFrame(levelTime);
+
+	ETJump::saveSystem->runFrame();
+	ETJump::pacedPrinter->runFrame();
+	// send everything the frame printed
+	ETJump::reliableCommandQueue->flush(levelTime);
 }
 
 // Is this a single player type game - sp or coop?
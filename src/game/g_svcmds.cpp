@@ -4,6 +4,7 @@
 // this file holds commands that can be executed by the server console, but not remote clients
 
 #include "g_local.h"
+#include "etj_reliable_command_queue.h"
 
 
 /*
@@ -1044,6 +1045,14 @@ qboolean    ConsoleCommand(void)
 		return qtrue;
 	}
 
+	if (!Q_stricmp(cmd, "reliable_command_stats"))
+	{
+		auto& counters = ETJump::reliableCommandQueue->counters();
+		G_Printf("Reliable commands: %u queued, %u sent, %u merged, %u deferred, %u dropped\n",
+		         counters.queued, counters.sent, counters.merged, counters.deferred, counters.dropped);
+		return qtrue;
+	}
+
 	if (OnConsoleCommand())
 	{
 		return qtrue;
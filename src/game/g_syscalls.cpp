@@ -1,6 +1,8 @@
 // Copyright (C) 1999-2000 Id Software, Inc.
 //
 #include "g_local.h"
+#include "etj_trigger_tree.h"
+#include "etj_reliable_command_queue.h"
 
 // this file is only included when building a dll
 // g_syscalls.asm is included instead when building a qvm
@@ -102,6 +104,7 @@ void    trap_Cvar_Update(vmCvar_t *cvar)
 void trap_Cvar_Set(const char *var_name, const char *value)
 {
 	syscall(G_CVAR_SET, var_name, value);
+	G_CvarSet(var_name);
 }
 
 int trap_Cvar_VariableIntegerValue(const char *var_name)
@@ -131,6 +134,24 @@ void trap_DropClient(int clientNum, const char *reason, int length)
 }
 
 void trap_SendServerCommand(int clientNum, const char *text)
+{
+	// messages queued earlier in the frame must not arrive after this
+	if (ETJump::reliableCommandQueue)
+	{
+		if (clientNum < 0)
+		{
+			ETJump::reliableCommandQueue->flushAll();
+		}
+		else
+		{
+			ETJump::reliableCommandQueue->flushClient(clientNum);
+		}
+	}
+
+	trap_SendServerCommandNow(clientNum, text);
+}
+
+void trap_SendServerCommandNow(int clientNum, const char *text)
 {
 	int len = strlen(text);
 	// rain - #433 - commands over 1022 chars will crash the
@@ -237,11 +258,21 @@ qboolean trap_AreasConnected(int area1, int area2)
 void trap_LinkEntity(gentity_t *ent)
 {
 	syscall(G_LINKENTITY, ent);
+
+	if (ETJump::triggerTree)
+	{
+		ETJump::triggerTree->onLinkEntity(ent);
+	}
 }
 
 void trap_UnlinkEntity(gentity_t *ent)
 {
 	syscall(G_UNLINKENTITY, ent);
+
+	if (ETJump::triggerTree)
+	{
+		ETJump::triggerTree->onUnlinkEntity(ent);
+	}
 }
 
 
@@ -75,6 +75,11 @@ mapEntityData_t *G_FreeMapEntityData(mapEntityData_Team_t *teamList, mapEntityDa
 		G_Error("G_FreeMapEntityData: not active");
 	}
 
+	if (mEnt->entNum >= 0 && mEnt->entNum < MAX_GENTITIES && teamList->entityIndex[mEnt->entNum] == mEnt)
+	{
+		teamList->entityIndex[mEnt->entNum] = NULL;
+	}
+
 	// remove from the doubly linked active list
 	mEnt->prev->next = mEnt->next;
 	mEnt->next->prev = mEnt->prev;
@@ -116,6 +121,26 @@ mapEntityData_t *G_AllocMapEntityData(mapEntityData_Team_t *teamList)
 	return mEnt;
 }
 
+/*
+=============================
+G_AllocMapEntityDataForEntity
+
+allocates a shared entry for entNum and indexes it
+so G_FindMapEntityData doesn't have to walk the list
+=============================
+*/
+mapEntityData_t *G_AllocMapEntityDataForEntity(mapEntityData_Team_t *teamList, int entNum)
+{
+	mapEntityData_t *mEnt = G_AllocMapEntityData(teamList);
+
+	mEnt->entNum = entNum;
+	if (entNum >= 0 && entNum < MAX_GENTITIES)
+	{
+		teamList->entityIndex[entNum] = mEnt;
+	}
+	return mEnt;
+}
+
 /*
 ===================
 G_FindMapEntityData
@@ -123,22 +148,12 @@ G_FindMapEntityData
 */
 mapEntityData_t *G_FindMapEntityData(mapEntityData_Team_t *teamList, int entNum)
 {
-	mapEntityData_t *mEnt;
-
-	for (mEnt = teamList->activeMapEntityData.next; mEnt && mEnt != &teamList->activeMapEntityData; mEnt = mEnt->next)
+	if (entNum < 0 || entNum >= MAX_GENTITIES)
 	{
-		if (mEnt->singleClient >= 0)
-		{
-			continue;
-		}
-		if (entNum == mEnt->entNum)
-		{
-			return(mEnt);
-		}
+		return(NULL);
 	}
 
-	// not found
-	return(NULL);
+	return(teamList->entityIndex[entNum]);
 }
 
 /*
@@ -380,8 +395,7 @@ void G_UpdateTeamMapData_Construct(gentity_t *ent)
 		mEnt     = G_FindMapEntityData(teamList, num);
 		if (!mEnt)
 		{
-			mEnt         = G_AllocMapEntityData(teamList);
-			mEnt->entNum = num;
+			mEnt = G_AllocMapEntityDataForEntity(teamList, num);
 		}
 		VectorCopy(ent->s.pos.trBase, mEnt->org);
 		mEnt->data      = mEnt->entNum; //ent->s.modelindex2;
@@ -393,8 +407,7 @@ void G_UpdateTeamMapData_Construct(gentity_t *ent)
 		mEnt     = G_FindMapEntityData(teamList, num);
 		if (!mEnt)
 		{
-			mEnt         = G_AllocMapEntityData(teamList);
-			mEnt->entNum = num;
+			mEnt = G_AllocMapEntityDataForEntity(teamList, num);
 		}
 		VectorCopy(ent->s.pos.trBase, mEnt->org);
 		mEnt->data      = mEnt->entNum; //ent->s.modelindex2;
@@ -411,8 +424,7 @@ void G_UpdateTeamMapData_Construct(gentity_t *ent)
 		mEnt     = G_FindMapEntityData(teamList, num);
 		if (!mEnt)
 		{
-			mEnt         = G_AllocMapEntityData(teamList);
-			mEnt->entNum = num;
+			mEnt = G_AllocMapEntityDataForEntity(teamList, num);
 		}
 		VectorCopy(ent->s.pos.trBase, mEnt->org);
 		mEnt->data      = mEnt->entNum; //ent->s.modelindex2;
@@ -430,8 +442,7 @@ void G_UpdateTeamMapData_Construct(gentity_t *ent)
 		mEnt     = G_FindMapEntityData(teamList, num);
 		if (!mEnt)
 		{
-			mEnt         = G_AllocMapEntityData(teamList);
-			mEnt->entNum = num;
+			mEnt = G_AllocMapEntityDataForEntity(teamList, num);
 		}
 		VectorCopy(ent->s.pos.trBase, mEnt->org);
 		mEnt->data      = mEnt->entNum; //ent->s.modelindex2;
@@ -454,8 +465,7 @@ void G_UpdateTeamMapData_Tank(gentity_t *ent)
 	mEnt     = G_FindMapEntityData(teamList, num);
 	if (!mEnt)
 	{
-		mEnt         = G_AllocMapEntityData(teamList);
-		mEnt->entNum = num;
+		mEnt = G_AllocMapEntityDataForEntity(teamList, num);
 	}
 	VectorCopy(ent->s.pos.trBase, mEnt->org);
 	mEnt->data      = ent->s.modelindex2;
@@ -474,8 +484,7 @@ void G_UpdateTeamMapData_Tank(gentity_t *ent)
 	mEnt     = G_FindMapEntityData(teamList, num);
 	if (!mEnt)
 	{
-		mEnt         = G_AllocMapEntityData(teamList);
-		mEnt->entNum = num;
+		mEnt = G_AllocMapEntityDataForEntity(teamList, num);
 	}
 	VectorCopy(ent->s.pos.trBase, mEnt->org);
 	mEnt->data      = ent->s.modelindex2;
@@ -503,8 +512,7 @@ void G_UpdateTeamMapData_Destruct(gentity_t *ent)
 		mEnt     = G_FindMapEntityData(teamList, num);
 		if (!mEnt)
 		{
-			mEnt         = G_AllocMapEntityData(teamList);
-			mEnt->entNum = num;
+			mEnt = G_AllocMapEntityDataForEntity(teamList, num);
 		}
 		VectorCopy(ent->s.pos.trBase, mEnt->org);
 		mEnt->data      = mEnt->entNum; //ent->s.modelindex2;
@@ -522,8 +530,7 @@ void G_UpdateTeamMapData_Destruct(gentity_t *ent)
 				mEnt     = G_FindMapEntityData(teamList, num);
 				if (!mEnt)
 				{
-					mEnt         = G_AllocMapEntityData(teamList);
-					mEnt->entNum = num;
+					mEnt = G_AllocMapEntityDataForEntity(teamList, num);
 				}
 				VectorCopy(ent->s.pos.trBase, mEnt->org);
 				mEnt->data      = mEnt->entNum; //ent->s.modelindex2;
@@ -540,8 +547,7 @@ void G_UpdateTeamMapData_Destruct(gentity_t *ent)
 		mEnt     = G_FindMapEntityData(teamList, num);
 		if (!mEnt)
 		{
-			mEnt         = G_AllocMapEntityData(teamList);
-			mEnt->entNum = num;
+			mEnt = G_AllocMapEntityDataForEntity(teamList, num);
 		}
 		VectorCopy(ent->s.pos.trBase, mEnt->org);
 		mEnt->data      = mEnt->entNum; //ent->s.modelindex2;
@@ -559,8 +565,7 @@ void G_UpdateTeamMapData_Destruct(gentity_t *ent)
 				mEnt     = G_FindMapEntityData(teamList, num);
 				if (!mEnt)
 				{
-					mEnt         = G_AllocMapEntityData(teamList);
-					mEnt->entNum = num;
+					mEnt = G_AllocMapEntityDataForEntity(teamList, num);
 				}
 				VectorCopy(ent->s.pos.trBase, mEnt->org);
 				mEnt->data      = mEnt->entNum; //ent->s.modelindex2;
@@ -601,8 +606,7 @@ void G_UpdateTeamMapData_Player(gentity_t *ent, qboolean forceAllied, qboolean f
 		mEnt     = G_FindMapEntityData(teamList, num);
 		if (!mEnt)
 		{
-			mEnt         = G_AllocMapEntityData(teamList);
-			mEnt->entNum = num;
+			mEnt = G_AllocMapEntityDataForEntity(teamList, num);
 		}
 		VectorCopy(ent->client->ps.origin, mEnt->org);
 		mEnt->yaw       = ent->client->ps.viewangles[YAW];
@@ -625,8 +629,7 @@ void G_UpdateTeamMapData_Player(gentity_t *ent, qboolean forceAllied, qboolean f
 		mEnt     = G_FindMapEntityData(teamList, num);
 		if (!mEnt)
 		{
-			mEnt         = G_AllocMapEntityData(teamList);
-			mEnt->entNum = num;
+			mEnt = G_AllocMapEntityDataForEntity(teamList, num);
 		}
 
 		VectorCopy(ent->client->ps.origin, mEnt->org);
@@ -731,8 +734,7 @@ void G_UpdateTeamMapData_LandMine(gentity_t *ent, qboolean forceAllied, qboolean
 		mEnt     = G_FindMapEntityData(teamList, num);
 		if (!mEnt)
 		{
-			mEnt         = G_AllocMapEntityData(teamList);
-			mEnt->entNum = num;
+			mEnt = G_AllocMapEntityDataForEntity(teamList, num);
 		}
 
 		VectorCopy(ent->r.currentOrigin, mEnt->org);
@@ -751,8 +753,7 @@ void G_UpdateTeamMapData_LandMine(gentity_t *ent, qboolean forceAllied, qboolean
 		mEnt     = G_FindMapEntityData(teamList, num);
 		if (!mEnt)
 		{
-			mEnt         = G_AllocMapEntityData(teamList);
-			mEnt->entNum = num;
+			mEnt = G_AllocMapEntityDataForEntity(teamList, num);
 		}
 
 		VectorCopy(ent->r.currentOrigin, mEnt->org);
@@ -788,8 +789,7 @@ void G_UpdateTeamMapData_CommandmapMarker(gentity_t *ent)
 		mEnt     = G_FindMapEntityData(teamList, num);
 		if (!mEnt)
 		{
-			mEnt         = G_AllocMapEntityData(teamList);
-			mEnt->entNum = num;
+			mEnt = G_AllocMapEntityDataForEntity(teamList, num);
 		}
 		VectorCopy(ent->s.origin, mEnt->org);
 		mEnt->data      = ent->parent->s.teamNum;
@@ -804,8 +804,7 @@ void G_UpdateTeamMapData_CommandmapMarker(gentity_t *ent)
 		mEnt     = G_FindMapEntityData(teamList, num);
 		if (!mEnt)
 		{
-			mEnt         = G_AllocMapEntityData(teamList);
-			mEnt->entNum = num;
+			mEnt = G_AllocMapEntityDataForEntity(teamList, num);
 		}
 		VectorCopy(ent->s.origin, mEnt->org);
 		mEnt->data      = ent->parent ? ent->parent->s.teamNum : -1;
@@ -815,6 +814,39 @@ void G_UpdateTeamMapData_CommandmapMarker(gentity_t *ent)
 	}
 }
 
+/*
+========================
+G_SendMapEntityInfoBuffer
+
+skips resending entnfo when it matches what the client already has,
+but still refreshes it every now and then in case cgame was restarted
+========================
+*/
+#define MAPENTITYINFO_REFRESH_TIME 10000
+
+static void G_SendMapEntityInfoBuffer(gentity_t *e, const char *buffer)
+{
+	unsigned int hash = 2166136261u;
+	const char   *c;
+
+	for (c = buffer; *c; c++)
+	{
+		hash ^= (unsigned char)*c;
+		hash *= 16777619u;
+	}
+
+	if (hash == e->client->pers.lastCCPulseHash
+	    && level.time - e->client->pers.lastCCPulseSendTime < MAPENTITYINFO_REFRESH_TIME
+	    && level.time >= e->client->pers.lastCCPulseSendTime)
+	{
+		return;
+	}
+
+	e->client->pers.lastCCPulseHash     = hash;
+	e->client->pers.lastCCPulseSendTime = level.time;
+	trap_SendServerCommand(e - g_entities, buffer);
+}
+
 void G_SendSpectatorMapEntityInfo(gentity_t *e)
 {
 	// special version, sends different set of ents - only the objectives, but also team info (string is split in two basically)
@@ -905,7 +937,7 @@ void G_SendSpectatorMapEntityInfo(gentity_t *e)
 		G_PushMapEntityToBuffer(buffer, sizeof(buffer), mEnt);
 	}
 
-	trap_SendServerCommand(e - g_entities, buffer);
+	G_SendMapEntityInfoBuffer(e, buffer);
 }
 
 void G_SendMapEntityInfo(gentity_t *e)
@@ -979,7 +1011,7 @@ void G_SendMapEntityInfo(gentity_t *e)
 		G_PushMapEntityToBuffer(buffer, sizeof(buffer), mEnt);
 	}
 
-	trap_SendServerCommand(e - g_entities, buffer);
+	G_SendMapEntityInfoBuffer(e, buffer);
 }
 
 void G_UpdateTeamMapData(void)
@@ -994,6 +1026,10 @@ void G_UpdateTeamMapData(void)
 	}
 	level.lastMapEntityUpdate = level.time;
 
+	// every tracked entity is refreshed even if it didn't move, startTime
+	// is what keeps its entry fresh (status 2) and players from being freed
+	// in G_SendMapEntityInfo. with the entNum index each refresh is a few
+	// stores, so skipping unchanged entities wouldn't save anything.
 	for (i = 0, ent = g_entities; i < level.num_entities; i++, ent++)
 	{
 		if (!ent->inuse)
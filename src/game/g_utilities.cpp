@@ -5,6 +5,7 @@
 
 #include "utilities.hpp"
 #include "etj_local.h"
+#include "etj_printer.h"
 
 using std::string;
 using std::vector;
@@ -347,19 +348,9 @@ void FinishBufferPrint(gentity_t *ent, bool insertNewLine)
 {
 	if (ent)
 	{
-		boost::format toPrint("print \"%s\"");
-		if (insertNewLine)
-		{
-			toPrint % (bigTextBuffer + NEWLINE);
-			trap_SendServerCommand(ClientNum(ent),
-			                       toPrint.str().c_str());
-		}
-		else
-		{
-			toPrint % bigTextBuffer;
-			trap_SendServerCommand(ClientNum(ent),
-			                       toPrint.str().c_str());
-		}
+		// long buffers are sent over several frames
+		Printer::SendConsoleStream(ClientNum(ent), insertNewLine ? bigTextBuffer + NEWLINE : bigTextBuffer);
+		bigTextBuffer.clear();
 	}
 	else
 	{
@@ -394,13 +385,7 @@ void BufferPrint(gentity_t *ent, const string& msg)
 	}
 	else
 	{
-		if (msg.length() + bigTextBuffer.length() > 1009)
-		{
-			std::string toSend = std::string("print \"" + bigTextBuffer + "\"");
-			trap_SendServerCommand(ClientNum(ent),
-			                       toSend.c_str());
-			bigTextBuffer.clear();
-		}
+		// split into packets when the buffer is sent
 		bigTextBuffer += msg;
 	}
 }
@@ -413,42 +398,53 @@ void BufferPrint(gentity_t *ent, const string& msg)
  * Argument handling
  */
 
+// The argument vectors are resized and assigned in place rather than
+// cleared, so the strings keep their buffers between commands.
 Arguments GetArgs()
 {
 	int                   argc = trap_Argc();
 	static vector<string> argv;
-	argv.clear();
+	argv.resize(argc);
 
 	for (int i = 0; i < argc; i++)
 	{
 		char arg[MAX_TOKEN_CHARS];
 		trap_Argv(i, arg, sizeof(arg));
-		argv.push_back(arg);
+		argv[i].assign(arg);
 	}
 	return &argv;
 }
 
-Arguments GetSayArgs(int start /*= 0*/)
+const ETJump::ArgumentTokenizer& TokenizeSayArgs()
 {
-	int argc = Q_SayArgc();
+	static ETJump::ArgumentTokenizer tokens;
+	tokens.tokenize(ConcatArgs(0));
+	return tokens;
+}
 
+Arguments GetSayArgs(const ETJump::ArgumentTokenizer& tokens, int start)
+{
 	static vector<string> argv;
-	argv.clear();
 
-	if (start >= argc)
+	if (start >= tokens.argc())
 	{
+		argv.clear();
 		return &argv;
 	}
 
-	for (int i = start; i < argc; i++)
+	argv.resize(tokens.argc() - start);
+	for (int i = start; i < tokens.argc(); i++)
 	{
-		char arg[MAX_TOKEN_CHARS];
-		Q_SayArgv(i, arg, sizeof(arg));
-		argv.push_back(arg);
+		argv[i - start].assign(tokens.argv(i), tokens.length(i));
 	}
 	return &argv;
 }
 
+Arguments GetSayArgs(int start /*= 0*/)
+{
+	return GetSayArgs(TokenizeSayArgs(), start);
+}
+
 /*
  * Conversions
  */
@@ -566,17 +562,7 @@ void CharPtrToString(const char *p, std::string& s)
 
 std::string SayArgv(int n)
 {
-	if (n >= Q_SayArgc())
-	{
-		return "";
-	}
-	else
-	{
-		char arg[MAX_TOKEN_CHARS] = "\0";
-		Q_SayArgv(n, arg, sizeof(arg));
-
-		return arg;
-	}
+	return TokenizeSayArgs().argv(n);
 }
 
 static void FS_ReplaceSeparators(char *path)
@@ -794,12 +780,7 @@ void BufferPrinter::Print(std::string const& data)
 	}
 	else
 	{
-		if (data.length() + buffer_.length() > 1009)
-		{
-			std::string toSend = std::string("print \"" + buffer_ + "\"");
-			trap_SendServerCommand(ClientNum(ent_), toSend.c_str());
-			buffer_.clear();
-		}
+		// split into packets when the buffer is sent
 		buffer_ += data;
 	}
 }
@@ -808,17 +789,9 @@ void BufferPrinter::Finish(bool insertNewLine)
 {
 	if (ent_)
 	{
-		boost::format toPrint("print \"%s\"");
-		if (insertNewLine)
-		{
-			toPrint % (buffer_ + NEWLINE);
-			trap_SendServerCommand(ClientNum(ent_), toPrint.str().c_str());
-		}
-		else
-		{
-			toPrint % buffer_;
-			trap_SendServerCommand(ClientNum(ent_), toPrint.str().c_str());
-		}
+		// long buffers are sent over several frames
+		Printer::SendConsoleStream(ClientNum(ent_), insertNewLine ? buffer_ + NEWLINE : buffer_);
+		buffer_.clear();
 	}
 	else
 	{
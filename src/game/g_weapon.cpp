@@ -3659,7 +3659,7 @@ void Bullet_Fire(gentity_t *ent, float spread, int damage, qboolean distance_fal
 
 	Bullet_Endpos(ent, spread, &end);
 
-	G_HistoricalTraceBegin(ent);
+	G_HistoricalTraceBegin(ent, muzzleTrace, end);
 
 	Bullet_Fire_Extended(ent, ent, muzzleTrace, end, spread, damage, distance_falloff);
 
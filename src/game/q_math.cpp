@@ -1243,6 +1243,69 @@ qboolean PointInBounds(const vec3_t v, const vec3_t mins, const vec3_t maxs)
 	return qtrue;
 }
 
+/*
+=================
+SegmentInBounds
+
+Clips the segment from start to end against the box. Returns qfalse if
+they don't overlap, otherwise enter and exit (if not NULL) are set to the
+fractions where the segment enters and leaves the box.
+=================
+*/
+qboolean SegmentInBounds(const vec3_t start, const vec3_t end, const vec3_t mins, const vec3_t maxs, float *enter, float *exit)
+{
+	float tEnter = 0, tExit = 1;
+	int   i;
+
+	for (i = 0; i < 3; i++)
+	{
+		float dir = end[i] - start[i];
+		float t0, t1;
+
+		if (Q_fabs(dir) < 0.001f)
+		{
+			if (start[i] < mins[i] || start[i] > maxs[i])
+			{
+				return qfalse;
+			}
+			continue;
+		}
+
+		t0 = (mins[i] - start[i]) / dir;
+		t1 = (maxs[i] - start[i]) / dir;
+		if (t0 > t1)
+		{
+			float tmp = t0;
+			t0 = t1;
+			t1 = tmp;
+		}
+
+		if (t0 > tEnter)
+		{
+			tEnter = t0;
+		}
+		if (t1 < tExit)
+		{
+			tExit = t1;
+		}
+		if (tEnter > tExit)
+		{
+			return qfalse;
+		}
+	}
+
+	if (enter)
+	{
+		*enter = tEnter;
+	}
+	if (exit)
+	{
+		*exit = tExit;
+	}
+
+	return qtrue;
+}
+
 
 int VectorCompare(const vec3_t v1, const vec3_t v2)
 {
@@ -656,6 +656,7 @@ float RadiusFromBounds(const vec3_t mins, const vec3_t maxs);
 void ClearBounds(vec3_t mins, vec3_t maxs);
 void AddPointToBounds(const vec3_t v, vec3_t mins, vec3_t maxs);
 qboolean PointInBounds(const vec3_t v, const vec3_t mins, const vec3_t maxs);
+qboolean SegmentInBounds(const vec3_t start, const vec3_t end, const vec3_t mins, const vec3_t maxs, float *enter, float *exit);
 int VectorCompare(const vec3_t v1, const vec3_t v2);
 vec_t VectorLength(const vec3_t v);
 vec_t VectorLengthSquared(const vec3_t v);
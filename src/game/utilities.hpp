@@ -5,6 +5,7 @@
 #include <vector>
 #include <boost/format.hpp>
 #include "etj_local.h"
+#include "etj_argument_tokenizer.h"
 
 typedef float vec_t;
 typedef vec_t vec2_t[2];
@@ -40,6 +41,9 @@ typedef std::vector<std::string>::const_iterator ConstArgIter;
 typedef std::vector<std::string>::iterator ArgIter;
 Arguments GetArgs();
 Arguments GetSayArgs(int start = 0);
+Arguments GetSayArgs(const ETJump::ArgumentTokenizer& tokens, int start);
+// tokenizes the current command as a chat line, valid until the next call
+const ETJump::ArgumentTokenizer& TokenizeSayArgs();
 // returns an empty string if not so many args
 std::string SayArgv(int arg);
 
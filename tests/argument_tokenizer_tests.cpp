@@ -0,0 +1,160 @@
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <gtest/gtest.h>
+#include "../src/game/etj_argument_tokenizer.h"
+
+using namespace ETJump;
+
+// counts every heap allocation made by the test binary, so tests can
+// check that a piece of code doesn't allocate
+static std::atomic<long> allocations(0);
+
+void *operator new(std::size_t size)
+{
+    ++allocations;
+    auto ptr = std::malloc(size ? size : 1);
+    if (!ptr)
+    {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+void *operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+void operator delete(void *ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void *ptr) noexcept
+{
+    std::free(ptr);
+}
+
+class ArgumentTokenizerTests : public testing::Test
+{
+public:
+    void SetUp() override
+    {
+
+    }
+
+    void TearDown() override
+    {
+
+    }
+
+    ArgumentTokenizer tokenizer;
+};
+
+TEST_F(ArgumentTokenizerTests, tokenize_ShouldReturnNoArgumentsForEmptyLine)
+{
+    tokenizer.tokenize("");
+
+    EXPECT_EQ(tokenizer.argc(), 0);
+    EXPECT_STREQ(tokenizer.argv(0), "");
+    EXPECT_EQ(tokenizer.length(0), 0);
+}
+
+TEST_F(ArgumentTokenizerTests, tokenize_ShouldSplitOnSpaces)
+{
+    tokenizer.tokenize("say !setlevel player 5");
+
+    ASSERT_EQ(tokenizer.argc(), 4);
+    EXPECT_STREQ(tokenizer.argv(0), "say");
+    EXPECT_STREQ(tokenizer.argv(1), "!setlevel");
+    EXPECT_STREQ(tokenizer.argv(2), "player");
+    EXPECT_STREQ(tokenizer.argv(3), "5");
+    EXPECT_EQ(tokenizer.length(1), 9);
+}
+
+TEST_F(ArgumentTokenizerTests, tokenize_ShouldIgnoreRepeatedLeadingAndTrailingSpaces)
+{
+    tokenizer.tokenize("  say   !mute  player  ");
+
+    ASSERT_EQ(tokenizer.argc(), 3);
+    EXPECT_STREQ(tokenizer.argv(0), "say");
+    EXPECT_STREQ(tokenizer.argv(1), "!mute");
+    EXPECT_STREQ(tokenizer.argv(2), "player");
+}
+
+TEST_F(ArgumentTokenizerTests, argv_ShouldReturnEmptyStringWhenOutOfRange)
+{
+    tokenizer.tokenize("say hello");
+
+    EXPECT_STREQ(tokenizer.argv(-1), "");
+    EXPECT_STREQ(tokenizer.argv(2), "");
+}
+
+TEST_F(ArgumentTokenizerTests, argsFrom_ShouldReturnRestOfTheOriginalLine)
+{
+    tokenizer.tokenize("say !rename player  new name");
+
+    EXPECT_STREQ(tokenizer.argsFrom(3), "new name");
+    EXPECT_STREQ(tokenizer.argsFrom(1), "!rename player  new name");
+    EXPECT_STREQ(tokenizer.argsFrom(5), "");
+}
+
+TEST_F(ArgumentTokenizerTests, tokenize_ShouldReplacePreviousArguments)
+{
+    tokenizer.tokenize("say one two three");
+    tokenizer.tokenize("say four");
+
+    ASSERT_EQ(tokenizer.argc(), 2);
+    EXPECT_STREQ(tokenizer.argv(1), "four");
+}
+
+TEST_F(ArgumentTokenizerTests, tokenize_ShouldTruncateTooLongLines)
+{
+    std::string line(ArgumentTokenizer::MaxLineLength * 2, 'a');
+    tokenizer.tokenize(line.c_str());
+
+    ASSERT_EQ(tokenizer.argc(), 1);
+    EXPECT_EQ(tokenizer.length(0), ArgumentTokenizer::MaxLineLength - 1);
+}
+
+TEST_F(ArgumentTokenizerTests, tokenize_ShouldStopAtMaxArguments)
+{
+    std::string line;
+    for (int i = 0; i < ArgumentTokenizer::MaxArguments + 10; i++)
+    {
+        line += "a ";
+    }
+    tokenizer.tokenize(line.c_str());
+
+    ASSERT_EQ(tokenizer.argc(), ArgumentTokenizer::MaxArguments);
+    EXPECT_STREQ(tokenizer.argv(ArgumentTokenizer::MaxArguments - 1), "a");
+}
+
+TEST_F(ArgumentTokenizerTests, tokenize_ShouldNotAllocate)
+{
+    const std::string line = "say !setlevel some_player 5 with a few more words of chat";
+    std::size_t total = 0;
+
+    auto before = allocations.load();
+    for (auto i = 0; i < 100; ++i)
+    {
+        tokenizer.tokenize(line.c_str());
+        for (auto n = 0; n < tokenizer.argc(); ++n)
+        {
+            total += tokenizer.length(n);
+        }
+        total += std::char_traits<char>::length(tokenizer.argsFrom(1));
+    }
+    auto after = allocations.load();
+
+    // make sure the counter is actually hooked up
+    auto copy = new std::string(line);
+    EXPECT_GT(allocations.load(), after);
+    delete copy;
+
+    EXPECT_EQ(after - before, 0);
+    EXPECT_EQ(tokenizer.argc(), 11);
+    EXPECT_GT(total, 0u);
+}
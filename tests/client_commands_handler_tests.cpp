@@ -79,3 +79,76 @@ TEST_F(ClientCommandsHandlerTests, SubscribeShouldBeCaseInsensitive)
 	handler->check("command", std::vector<std::string>());
 	ASSERT_TRUE(called);
 }
+
+TEST_F(ClientCommandsHandlerTests, UnsubcribeShouldReturnWhetherCommandExisted)
+{
+	handler->subscribe("command", [](const std::vector<std::string>& args) {});
+	ASSERT_FALSE(handler->unsubcribe("secondCommand"));
+	ASSERT_TRUE(handler->unsubcribe("COMMAND"));
+	ASSERT_FALSE(handler->check("command", std::vector<std::string>()));
+}
+
+TEST_F(ClientCommandsHandlerTests, SubscribeShouldRejectDuplicateCommands)
+{
+	ASSERT_TRUE(handler->subscribe("command", [](const std::vector<std::string>& args) {}));
+	ASSERT_FALSE(handler->subscribeRaw("Command", [] {}));
+}
+
+TEST_F(ClientCommandsHandlerTests, CheckShouldOnlyCollectArgumentsForHandlersThatTakeThem)
+{
+	auto collected = 0;
+	auto rawCalled = false;
+	std::vector<std::string> received;
+	handler->subscribeRaw("raw", [&rawCalled] { rawCalled = true; });
+	handler->subscribe("args", [&received](const std::vector<std::string>& args) { received = args; });
+
+	auto getArguments = [&collected]
+	{
+		++collected;
+		return std::vector<std::string>{ "1", "2" };
+	};
+
+	ASSERT_TRUE(handler->check("raw", getArguments));
+	ASSERT_TRUE(rawCalled);
+	ASSERT_EQ(collected, 0);
+
+	ASSERT_TRUE(handler->check("ARGS", getArguments));
+	ASSERT_EQ(collected, 1);
+	ASSERT_EQ(received, std::vector<std::string>({ "1", "2" }));
+}
+
+TEST_F(ClientCommandsHandlerTests, CallbackShouldBeAbleToUnsubscribeItself)
+{
+	auto called = 0;
+	handler->subscribeRaw("once", [&]
+	{
+		++called;
+		handler->unsubcribe("once");
+	});
+
+	ASSERT_TRUE(handler->check("once", std::vector<std::string>()));
+	ASSERT_FALSE(handler->check("once", std::vector<std::string>()));
+	ASSERT_EQ(called, 1);
+}
+
+TEST_F(ClientCommandsHandlerTests, StatsShouldCountCalls)
+{
+	handler->subscribeRaw("first", [] {});
+	handler->subscribeRaw("second", [] {});
+	handler->check("first", std::vector<std::string>());
+	handler->check("first", std::vector<std::string>());
+	handler->check("second", std::vector<std::string>());
+
+	auto stats = handler->stats();
+	ASSERT_EQ(stats.size(), 2u);
+	for (const auto& command : stats)
+	{
+		ASSERT_EQ(command.calls, command.command == "first" ? 2u : 1u);
+	}
+
+	handler->resetStats();
+	for (const auto& command : handler->stats())
+	{
+		ASSERT_EQ(command.calls, 0u);
+	}
+}
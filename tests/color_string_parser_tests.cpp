@@ -340,4 +340,82 @@ TEST_F(ColorStringParsingTests, parseColorString_ShouldParse_EmptyHexValue)
 	vec4_t outColor;
 	parseColorString(colorString, outColor);
 	ASSERT_TRUE(Vector4Compare(outColor, expectedColor));
-}
\ No newline at end of file
+}
+
+class ColorStringParsingExactTests : public testing::Test
+{
+public:
+	void SetUp() override {
+	}
+
+	void TearDown() override {
+	}
+
+	static void expectColor(const char *colorString, float r, float g, float b, float a)
+	{
+		vec4_t outColor;
+		parseColorString(colorString, outColor);
+		EXPECT_FLOAT_EQ(outColor[0], r) << colorString;
+		EXPECT_FLOAT_EQ(outColor[1], g) << colorString;
+		EXPECT_FLOAT_EQ(outColor[2], b) << colorString;
+		EXPECT_FLOAT_EQ(outColor[3], a) << colorString;
+	}
+};
+
+TEST_F(ColorStringParsingExactTests, parseColorString_ParsesEveryChannel)
+{
+	expectColor(" MdRed ", colorMdRed[0], colorMdRed[1], colorMdRed[2], 1.f);
+	expectColor("0.25 0.5 0.75 0.5", 0.25f, 0.5f, 0.75f, 0.5f);
+	expectColor("255 0 127.5 51", 1.f, 0.f, 0.5f, 0.2f);
+	expectColor("-5 +1 .5 300", 0.f, 1.f, 0.5f, 1.f);
+	expectColor("1 1 1 1 1", 1.f, 1.f, 1.f, 1.f);
+	expectColor("#ff000080", 1.f, 0.f, 0.f, 128 / 255.f);
+	expectColor("0XFF8000", 1.f, 128 / 255.f, 0.f, 1.f);
+	expectColor("#fff", 15 / 255.f, 1.f, 0.f, 1.f);
+	expectColor("#ff00ff00ff", 1.f, 0.f, 1.f, 0.f);
+}
+
+TEST_F(ColorStringParsingExactTests, parseColorString_SetsBlackOnInvalidInput)
+{
+	expectColor("", 0.f, 0.f, 0.f, 1.f);
+	expectColor("   ", 0.f, 0.f, 0.f, 1.f);
+	expectColor("1.", 0.f, 0.f, 0.f, 1.f);
+	expectColor("#ffzz00", 0.f, 0.f, 0.f, 1.f);
+	expectColor("0x", 0.f, 0.f, 0.f, 1.f);
+	expectColor("red1", 0.f, 0.f, 0.f, 1.f);
+}
+
+TEST_F(ColorStringParsingExactTests, parseColorString_CachedResultMatchesParsedResult)
+{
+	const std::string colorString{ "0x00ff00" };
+	vec4_t first;
+	vec4_t second;
+	parseColorString(colorString, first);
+	parseColorString(colorString, second);
+	for (auto i = 0; i < 4; i++)
+	{
+		EXPECT_FLOAT_EQ(first[i], second[i]);
+	}
+	EXPECT_FLOAT_EQ(second[1], 1.f);
+}
+
+TEST_F(ColorStringParsingExactTests, parseColorCvar_ReparsesOnlyWhenModified)
+{
+	vmCvar_t cvar{};
+	snprintf(cvar.string, sizeof(cvar.string), "red");
+	cvar.modificationCount = 1;
+
+	vec4_t color;
+	parseColorCvar(cvar, color);
+	EXPECT_FLOAT_EQ(color[0], 1.f);
+
+	// string changed but the cvar was not updated yet
+	snprintf(cvar.string, sizeof(cvar.string), "blue");
+	parseColorCvar(cvar, color);
+	EXPECT_FLOAT_EQ(color[0], 1.f);
+
+	cvar.modificationCount++;
+	parseColorCvar(cvar, color);
+	EXPECT_FLOAT_EQ(color[0], 0.f);
+	EXPECT_FLOAT_EQ(color[2], 1.f);
+}
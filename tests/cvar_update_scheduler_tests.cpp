@@ -0,0 +1,101 @@
+#include <algorithm>
+#include <vector>
+#include <gtest/gtest.h>
+#include "../src/game/etj_cvar_update_scheduler.h"
+
+using namespace ETJump;
+
+class CvarUpdateSchedulerTests : public testing::Test
+{
+public:
+    void SetUp() override
+    {
+
+    }
+
+    void TearDown() override
+    {
+
+    }
+
+    static bool contains(const std::vector<int>& frame, int index)
+    {
+        return std::find(frame.begin(), frame.end(), index) != frame.end();
+    }
+};
+
+TEST_F(CvarUpdateSchedulerTests, nextFrame_ShouldPollEveryFrameCvarsOnEachFrame)
+{
+    CvarUpdateScheduler scheduler(1);
+    scheduler.add(0, "cg_fov", false);
+    scheduler.add(1, "pmove_fixed", true);
+    scheduler.add(2, "cg_drawGun", false);
+
+    for (auto i = 0; i < 4; ++i)
+    {
+        auto frame = scheduler.nextFrame();
+        EXPECT_TRUE(contains(frame, 1));
+        EXPECT_EQ(frame.size(), 2u);
+    }
+}
+
+TEST_F(CvarUpdateSchedulerTests, nextFrame_ShouldPollEveryCvarWithinACycle)
+{
+    CvarUpdateScheduler scheduler(2);
+    for (auto i = 0; i < 5; ++i)
+    {
+        scheduler.add(i, "cvar", false);
+    }
+
+    std::vector<int> polled;
+    for (auto i = 0; i < 3; ++i)
+    {
+        auto frame = scheduler.nextFrame();
+        polled.insert(polled.end(), frame.begin(), frame.end());
+    }
+
+    for (auto i = 0; i < 5; ++i)
+    {
+        EXPECT_TRUE(contains(polled, i));
+    }
+}
+
+TEST_F(CvarUpdateSchedulerTests, cvarSet_ShouldPollCvarOnNextFrameOnly)
+{
+    CvarUpdateScheduler scheduler(1);
+    scheduler.add(0, "cg_fov", false);
+    scheduler.add(1, "cg_drawGun", false);
+    scheduler.add(2, "etj_drawSpeed2", false);
+
+    scheduler.cvarSet("ETJ_DRAWSPEED2");
+    scheduler.cvarSet("etj_drawspeed2");
+    auto frame = scheduler.nextFrame();
+    EXPECT_EQ(std::count(frame.begin(), frame.end(), 2), 1);
+
+    frame = scheduler.nextFrame();
+    EXPECT_FALSE(contains(frame, 2));
+}
+
+TEST_F(CvarUpdateSchedulerTests, cvarSet_ShouldIgnoreUnknownCvars)
+{
+    CvarUpdateScheduler scheduler(1);
+    scheduler.add(0, "cg_fov", false);
+
+    scheduler.cvarSet("cg_fo");
+    scheduler.cvarSet("cg_fovx");
+    scheduler.cvarSet(nullptr);
+
+    EXPECT_EQ(scheduler.nextFrame().size(), 1u);
+}
+
+TEST_F(CvarUpdateSchedulerTests, clear_ShouldRemoveAllCvars)
+{
+    CvarUpdateScheduler scheduler;
+    scheduler.add(0, "cg_fov", true);
+    scheduler.add(1, "cg_drawGun", false);
+    scheduler.cvarSet("cg_fov");
+
+    scheduler.clear();
+
+    EXPECT_TRUE(scheduler.nextFrame().empty());
+}
@@ -0,0 +1,159 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include "../src/cgame/etj_event_loop.h"
+
+using namespace ETJump;
+
+class EventLoopTests : public testing::Test
+{
+public:
+    void SetUp() override
+    {
+        now = 0;
+    }
+
+    void TearDown() override
+    {
+
+    }
+
+    EventLoop makeLoop()
+    {
+        return EventLoop([this]
+        {
+            return now;
+        });
+    }
+
+    int64_t now;
+};
+
+TEST_F(EventLoopTests, run_ShouldRunTasksWhenTheyAreDue)
+{
+    auto loop = makeLoop();
+    std::vector<int> order;
+    loop.schedule([&] { order.push_back(2); }, 200);
+    loop.schedule([&] { order.push_back(1); }, 100);
+
+    loop.run();
+    ASSERT_TRUE(order.empty());
+
+    now = 150;
+    loop.run();
+    ASSERT_EQ(order, std::vector<int>({ 1 }));
+
+    now = 200;
+    loop.run();
+    ASSERT_EQ(order, std::vector<int>({ 1, 2 }));
+    ASSERT_FALSE(loop.hasPendingEvents());
+}
+
+TEST_F(EventLoopTests, run_ShouldRunImmediateTasksFirst)
+{
+    auto loop = makeLoop();
+    std::vector<int> order;
+    loop.schedule([&] { order.push_back(2); }, 0);
+    loop.schedule([&] { order.push_back(1); }, 0, TaskPriorities::Immediate);
+
+    loop.run();
+    ASSERT_EQ(order, std::vector<int>({ 1, 2 }));
+}
+
+TEST_F(EventLoopTests, pendingEventsCount_ShouldCountAllScheduledTasks)
+{
+    auto loop = makeLoop();
+    loop.schedule([] {}, 100);
+    loop.schedule([] {}, 100);
+    auto id = loop.schedule([] {}, 100, TaskPriorities::Immediate);
+    ASSERT_EQ(loop.pendingEventsCount(), 3);
+
+    loop.unschedule(id);
+    ASSERT_EQ(loop.pendingEventsCount(), 2);
+}
+
+TEST_F(EventLoopTests, unschedule_ShouldNotAffectTaskReusingTheSlot)
+{
+    auto loop = makeLoop();
+    auto ran = false;
+    auto id = loop.schedule([] {}, 0);
+    loop.run();
+
+    loop.schedule([&] { ran = true; }, 0);
+    ASSERT_FALSE(loop.unschedule(id));
+
+    loop.run();
+    ASSERT_TRUE(ran);
+}
+
+TEST_F(EventLoopTests, schedule_ShouldRunTasksScheduledByTasksOnNextRun)
+{
+    auto loop = makeLoop();
+    auto count = 0;
+    for (auto i = 0; i < 32; i++)
+    {
+        loop.schedule([&]
+        {
+            ++count;
+            loop.schedule([&] { ++count; }, 0);
+        }, 0);
+    }
+
+    loop.run();
+    ASSERT_EQ(count, 32);
+    ASSERT_EQ(loop.pendingEventsCount(), 32);
+
+    loop.run();
+    ASSERT_EQ(count, 64);
+    ASSERT_FALSE(loop.hasPendingEvents());
+}
+
+TEST_F(EventLoopTests, schedulePersistent_ShouldRunUntilUnscheduled)
+{
+    auto loop = makeLoop();
+    auto count = 0;
+    auto id = 0;
+    id = loop.schedulePersistent([&]
+    {
+        if (++count == 3)
+        {
+            loop.unschedule(id);
+        }
+    }, 10);
+
+    for (auto i = 0; i < 10; i++)
+    {
+        now += 10;
+        loop.run();
+    }
+
+    ASSERT_EQ(count, 3);
+    ASSERT_FALSE(loop.hasPendingEvents());
+}
+
+TEST_F(EventLoopTests, execute_ShouldRunTaskOnlyOnce)
+{
+    auto loop = makeLoop();
+    auto count = 0;
+    auto id = loop.schedule([&] { ++count; }, 100);
+
+    loop.execute(id);
+    now = 100;
+    loop.run();
+
+    ASSERT_EQ(count, 1);
+    ASSERT_FALSE(loop.hasPendingEvents());
+}
+
+TEST_F(EventLoopTests, shutdown_ShouldRunRemainingTasks)
+{
+    auto loop = makeLoop();
+    std::vector<int> order;
+    loop.schedule([&] { order.push_back(2); }, 100);
+    auto id = loop.schedule([&] { order.push_back(3); }, 100);
+    loop.schedule([&] { order.push_back(1); }, 500, TaskPriorities::Immediate);
+    loop.unschedule(id);
+
+    loop.shutdown();
+    ASSERT_EQ(order, std::vector<int>({ 1, 2 }));
+    ASSERT_FALSE(loop.hasPendingEvents());
+}
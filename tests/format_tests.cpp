@@ -0,0 +1,124 @@
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <boost/format.hpp>
+#include <gtest/gtest.h>
+#include "../src/game/etj_format.h"
+
+using namespace ETJump;
+
+class FormatTests : public testing::Test
+{
+public:
+    void SetUp() override
+    {
+
+    }
+
+    void TearDown() override
+    {
+
+    }
+};
+
+TEST_F(FormatTests, stringFormat_ShouldFormatIntegers)
+{
+    EXPECT_EQ("01:05.007", stringFormat("%02d:%02d.%03d", 1, 5, 7));
+    EXPECT_EQ("-12|  34|56   |ff", stringFormat("%d|%4i|%-5u|%x", -12, 34, 56u, 255));
+    EXPECT_EQ("-0012|+5|-9223372036854775808", stringFormat("%05d|%+d|%d", -12, 5, -9223372036854775807LL - 1));
+}
+
+TEST_F(FormatTests, stringFormat_ShouldFormatFloats)
+{
+    EXPECT_EQ("321 654", stringFormat("%.0f %.0f", 321.4f, 653.6));
+    EXPECT_EQ("1.50", stringFormat("%.2f", 1.5));
+}
+
+TEST_F(FormatTests, stringFormat_ShouldFormatStrings)
+{
+    std::string name = "player";
+    char buffer[] = "buffer";
+    EXPECT_EQ("player buffer literal", stringFormat("%s %s %s", name, buffer, "literal"));
+    EXPECT_EQ("pla|    ab|ab    ", stringFormat("%.3s|%6s|%-6s", name, "ab", "ab"));
+}
+
+TEST_F(FormatTests, stringFormat_ShouldConvertArgumentsByTypeLikeBoost)
+{
+    EXPECT_EQ("5 text 1.5", stringFormat("%s %d %d", 5, "text", 1.5));
+    EXPECT_EQ((boost::format("%s %d %d") % 5 % "text" % 1.5).str(), stringFormat("%s %d %d", 5, "text", 1.5));
+}
+
+TEST_F(FormatTests, stringFormat_ShouldHandlePercentAndMissingArguments)
+{
+    EXPECT_EQ("100% done", stringFormat("%d%% done", 100));
+    EXPECT_EQ("a  b", stringFormat("a %s b"));
+}
+
+TEST_F(FormatTests, formatTo_ShouldGrowPastBuffer)
+{
+    FormatBuffer<8> buffer;
+    formatTo(buffer, "%s-%s", "long", "string");
+    EXPECT_EQ("long-string", buffer.str());
+    EXPECT_STREQ("long-string", buffer.c_str());
+    EXPECT_EQ(11u, buffer.length());
+
+    buffer.clear();
+    formatTo(buffer, "%d", 42);
+    EXPECT_STREQ("42", buffer.c_str());
+}
+
+TEST_F(FormatTests, checkedFormat_ShouldMatchArgumentTypes)
+{
+    static_assert(FormatMatcher<FormatTypes<int, int, int>>::matches("%02d:%02d.%03d"), "");
+    static_assert(FormatMatcher<FormatTypes<float, const char *>>::matches("%.0f %% %s"), "");
+    static_assert(!FormatMatcher<FormatTypes<int>>::matches("%s"), "");
+    static_assert(!FormatMatcher<FormatTypes<const char *>>::matches("%d"), "");
+    static_assert(!FormatMatcher<FormatTypes<int, int>>::matches("%d"), "");
+    static_assert(!FormatMatcher<FormatTypes<int>>::matches("%d %d"), "");
+
+    auto minutes = 1, seconds = 2, millis = 3;
+    FormatBuffer<16> buffer;
+    ETJUMP_FORMAT_TO(buffer, "%02d:%02d.%03d", minutes, seconds, millis);
+    EXPECT_STREQ("01:02.003", buffer.c_str());
+    EXPECT_EQ("speed 320", ETJUMP_FORMAT("speed %.0f", 320.0f));
+}
+
+// Run with --gtest_also_run_disabled_tests to compare against boost::format
+TEST_F(FormatTests, DISABLED_benchmark_ShouldBeFasterThanBoostFormat)
+{
+    const auto iterations = 200000;
+    std::size_t total = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for (auto i = 0; i < iterations; ++i)
+    {
+        total += (boost::format("%02d:%02d.%03d") % (i / 60000) % (i / 1000 % 60) % (i % 1000)).str().length();
+    }
+    auto boostTime = std::chrono::steady_clock::now() - start;
+
+    start = std::chrono::steady_clock::now();
+    for (auto i = 0; i < iterations; ++i)
+    {
+        total += stringFormat("%02d:%02d.%03d", i / 60000, i / 1000 % 60, i % 1000).length();
+    }
+    auto stringFormatTime = std::chrono::steady_clock::now() - start;
+
+    start = std::chrono::steady_clock::now();
+    for (auto i = 0; i < iterations; ++i)
+    {
+        FormatBuffer<16> buffer;
+        ETJUMP_FORMAT_TO(buffer, "%02d:%02d.%03d", i / 60000, i / 1000 % 60, i % 1000);
+        total += buffer.length();
+    }
+    auto bufferTime = std::chrono::steady_clock::now() - start;
+
+    auto toNanos = [iterations](std::chrono::steady_clock::duration duration)
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count() / iterations;
+    };
+    printf("boost::format %lld ns, stringFormat %lld ns, FormatBuffer %lld ns per call (%zu)\n",
+           static_cast<long long>(toNanos(boostTime)), static_cast<long long>(toNanos(stringFormatTime)),
+           static_cast<long long>(toNanos(bufferTime)), total);
+
+    EXPECT_LT(bufferTime, boostTime);
+}
@@ -0,0 +1,133 @@
+#include <string>
+#include <utility>
+#include <vector>
+#include <gtest/gtest.h>
+#include "../src/game/etj_paced_printer.h"
+
+using namespace ETJump;
+
+class PacedPrinterTests : public testing::Test
+{
+public:
+    void SetUp() override
+    {
+        sent.clear();
+    }
+
+    void TearDown() override
+    {
+
+    }
+
+    PacedPrinter::SendText sender()
+    {
+        return [this](int clientNum, const std::string& text)
+        {
+            sent.push_back(std::make_pair(clientNum, text));
+        };
+    }
+
+    // produces count lines of length 100, counting how many were produced
+    static PacedPrinter::Producer lines(int count, int *produced)
+    {
+        return [count, produced](std::string& output)
+        {
+            if (*produced >= count)
+            {
+                return false;
+            }
+            output += std::string(99, 'a') + "\n";
+            ++*produced;
+            return true;
+        };
+    }
+
+    std::vector<std::pair<int, std::string>> sent;
+};
+
+TEST_F(PacedPrinterTests, runFrame_ShouldSendOnePacketPerFrame)
+{
+    PacedPrinter printer(1, sender());
+    auto produced = 0;
+    printer.print(0, lines(25, &produced));
+
+    printer.runFrame();
+    ASSERT_EQ(1u, sent.size());
+    EXPECT_EQ(900u, sent[0].second.length());
+    // only the lines that fit in the first packet and the next one are produced
+    EXPECT_EQ(10, produced);
+
+    printer.runFrame();
+    printer.runFrame();
+    printer.runFrame();
+    EXPECT_EQ(3u, sent.size());
+    EXPECT_EQ(25, produced);
+    EXPECT_FALSE(printer.isPrinting(0));
+}
+
+TEST_F(PacedPrinterTests, runFrame_ShouldSplitLongTextAtLineBreaks)
+{
+    PacedPrinter printer(1, sender());
+    std::string text = std::string(600, 'a') + "\n" + std::string(600, 'b') + "\n";
+    printer.print(0, text);
+
+    printer.runFrame();
+    printer.runFrame();
+    ASSERT_EQ(2u, sent.size());
+    EXPECT_EQ(std::string(600, 'a') + "\n", sent[0].second);
+    EXPECT_EQ(std::string(600, 'b') + "\n", sent[1].second);
+}
+
+TEST_F(PacedPrinterTests, runFrame_ShouldSplitTextWithoutLineBreaks)
+{
+    PacedPrinter printer(1, sender(), 2);
+    printer.print(0, std::string(PacedPrinter::MaxPacketLength + 1, 'a'));
+
+    printer.runFrame();
+    ASSERT_EQ(2u, sent.size());
+    EXPECT_EQ(PacedPrinter::MaxPacketLength, sent[0].second.length());
+    EXPECT_EQ(1u, sent[1].second.length());
+}
+
+TEST_F(PacedPrinterTests, print_ShouldQueueOutputInOrder)
+{
+    PacedPrinter printer(1, sender());
+    printer.print(0, "first\n");
+    printer.print(0, "second\n");
+
+    printer.runFrame();
+    ASSERT_EQ(1u, sent.size());
+    EXPECT_EQ("first\nsecond\n", sent[0].second);
+}
+
+TEST_F(PacedPrinterTests, sendNext_ShouldSendOnePacketRightAway)
+{
+    PacedPrinter printer(2, sender());
+    auto produced = 0;
+    printer.print(1, lines(25, &produced));
+
+    EXPECT_TRUE(printer.sendNext(1));
+    ASSERT_EQ(1u, sent.size());
+    EXPECT_EQ(1, sent[0].first);
+    EXPECT_EQ(900u, sent[0].second.length());
+    EXPECT_FALSE(printer.sendNext(0));
+
+    printer.runFrame();
+    printer.runFrame();
+    EXPECT_EQ(3u, sent.size());
+    EXPECT_FALSE(printer.isPrinting(1));
+}
+
+TEST_F(PacedPrinterTests, cancel_ShouldStopOutput)
+{
+    PacedPrinter printer(2, sender());
+    auto produced = 0;
+    printer.print(1, lines(100, &produced));
+    printer.runFrame();
+
+    EXPECT_TRUE(printer.cancel(1));
+    printer.runFrame();
+    EXPECT_EQ(1u, sent.size());
+    EXPECT_EQ(1, sent[0].first);
+    EXPECT_FALSE(printer.cancel(1));
+}
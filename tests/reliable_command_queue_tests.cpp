@@ -0,0 +1,170 @@
+#include <string>
+#include <utility>
+#include <vector>
+#include <gtest/gtest.h>
+#include "../src/game/etj_reliable_command_queue.h"
+
+using namespace ETJump;
+
+class ReliableCommandQueueTests : public testing::Test
+{
+public:
+    void SetUp() override
+    {
+        sent.clear();
+    }
+
+    void TearDown() override
+    {
+
+    }
+
+    ReliableCommandQueue::SendCommand sender()
+    {
+        return [this](int clientNum, const std::string& command)
+        {
+            sent.push_back(std::make_pair(clientNum, command));
+        };
+    }
+
+    std::vector<std::pair<int, std::string>> sent;
+};
+
+TEST_F(ReliableCommandQueueTests, flush_ShouldMergeAdjacentPrints)
+{
+    ReliableCommandQueue queue(2, sender());
+    queue.print(0, ReliableCommandQueue::Priority::Normal, "first\n");
+    queue.print(0, ReliableCommandQueue::Priority::Normal, "second\n");
+    queue.print(1, ReliableCommandQueue::Priority::Normal, "other\n");
+    queue.flush(0);
+
+    ASSERT_EQ(2u, sent.size());
+    EXPECT_EQ(0, sent[0].first);
+    EXPECT_EQ("print \"first\nsecond\n\"", sent[0].second);
+    EXPECT_EQ("print \"other\n\"", sent[1].second);
+    EXPECT_EQ(1u, queue.counters().merged);
+}
+
+TEST_F(ReliableCommandQueueTests, flush_ShouldNotMergePrintsOverPacketLimit)
+{
+    ReliableCommandQueue queue(1, sender());
+    std::string half(ReliableCommandQueue::MaxPrintLength / 2 + 1, 'a');
+    queue.print(0, ReliableCommandQueue::Priority::Normal, half);
+    queue.print(0, ReliableCommandQueue::Priority::Normal, half);
+    queue.flush(0);
+
+    EXPECT_EQ(2u, sent.size());
+    EXPECT_EQ(0u, queue.counters().merged);
+}
+
+TEST_F(ReliableCommandQueueTests, flush_ShouldSendEachLeftPrintSeparately)
+{
+    ReliableCommandQueue queue(1, sender());
+    queue.leftPrint(0, ReliableCommandQueue::Priority::Normal, "a\n");
+    queue.leftPrint(0, ReliableCommandQueue::Priority::Normal, "b\n");
+    queue.flush(0);
+
+    ASSERT_EQ(2u, sent.size());
+    EXPECT_EQ("cpm \"a\n\"", sent[0].second);
+    EXPECT_EQ("cpm \"b\n\"", sent[1].second);
+    EXPECT_EQ(0u, queue.counters().merged);
+}
+
+TEST_F(ReliableCommandQueueTests, flush_ShouldKeepQueueOrderAcrossPriorities)
+{
+    ReliableCommandQueue queue(1, sender());
+    queue.print(0, ReliableCommandQueue::Priority::Normal, "first");
+    queue.command(0, ReliableCommandQueue::Priority::Command, "timerun_stop 0 run");
+    queue.print(0, ReliableCommandQueue::Priority::Low, "second");
+    queue.print(0, ReliableCommandQueue::Priority::Normal, "third");
+    queue.flush(0);
+
+    ASSERT_EQ(4u, sent.size());
+    EXPECT_EQ("print \"first\"", sent[0].second);
+    EXPECT_EQ("timerun_stop 0 run", sent[1].second);
+    EXPECT_EQ("print \"second\"", sent[2].second);
+    EXPECT_EQ("print \"third\"", sent[3].second);
+    EXPECT_EQ(0u, queue.counters().merged);
+}
+
+TEST_F(ReliableCommandQueueTests, flush_ShouldSendCommandsPastDeferredPrints)
+{
+    ReliableCommandQueue queue(1, sender());
+    for (auto i = 0; i < ReliableCommandQueue::CommandBurst + 1; ++i)
+    {
+        queue.command(0, ReliableCommandQueue::Priority::Normal, "cmd");
+    }
+    queue.command(0, ReliableCommandQueue::Priority::Command, "timerun_stop 0 run");
+    queue.flush(0);
+
+    ASSERT_EQ(static_cast<std::size_t>(ReliableCommandQueue::CommandBurst + 1), sent.size());
+    EXPECT_EQ("timerun_stop 0 run", sent.back().second);
+    EXPECT_EQ(1u, queue.counters().deferred);
+}
+
+TEST_F(ReliableCommandQueueTests, flush_ShouldDeferMessagesOverBudget)
+{
+    ReliableCommandQueue queue(1, sender());
+    for (auto i = 0; i < ReliableCommandQueue::CommandBurst + 4; ++i)
+    {
+        queue.command(0, ReliableCommandQueue::Priority::Normal, "cmd");
+    }
+    queue.flush(0);
+
+    EXPECT_EQ(static_cast<std::size_t>(ReliableCommandQueue::CommandBurst), sent.size());
+    EXPECT_EQ(4u, queue.counters().deferred);
+
+    // a second refills enough budget for the rest
+    queue.flush(1000);
+    EXPECT_EQ(static_cast<std::size_t>(ReliableCommandQueue::CommandBurst + 4), sent.size());
+}
+
+TEST_F(ReliableCommandQueueTests, flush_ShouldKeepBudgetForNormalMessagesFromLowPriority)
+{
+    ReliableCommandQueue queue(1, sender());
+    for (auto i = 0; i < ReliableCommandQueue::CommandBurst; ++i)
+    {
+        queue.command(0, ReliableCommandQueue::Priority::Low, "bp");
+    }
+    queue.flush(0);
+
+    EXPECT_EQ(static_cast<std::size_t>(ReliableCommandQueue::CommandBurst / 2 + 1), sent.size());
+}
+
+TEST_F(ReliableCommandQueueTests, flush_ShouldNeverDeferCommands)
+{
+    ReliableCommandQueue queue(1, sender());
+    for (auto i = 0; i < ReliableCommandQueue::CommandBurst * 2; ++i)
+    {
+        queue.command(0, ReliableCommandQueue::Priority::Command, "cmd");
+    }
+    queue.flush(0);
+
+    EXPECT_EQ(static_cast<std::size_t>(ReliableCommandQueue::CommandBurst * 2), sent.size());
+}
+
+TEST_F(ReliableCommandQueueTests, flushClient_ShouldSendOnlyThatClientsMessagesRegardlessOfBudget)
+{
+    ReliableCommandQueue queue(2, sender());
+    for (auto i = 0; i < ReliableCommandQueue::CommandBurst; ++i)
+    {
+        queue.command(0, ReliableCommandQueue::Priority::Command, "command");
+    }
+    queue.leftPrint(0, ReliableCommandQueue::Priority::Low, "banner");
+    queue.leftPrint(1, ReliableCommandQueue::Priority::Normal, "other");
+    queue.flushClient(0);
+
+    ASSERT_EQ(static_cast<std::size_t>(ReliableCommandQueue::CommandBurst + 1), sent.size());
+    EXPECT_EQ(0, sent.back().first);
+    EXPECT_EQ("cpm \"banner\"", sent.back().second);
+}
+
+TEST_F(ReliableCommandQueueTests, clear_ShouldRemoveQueuedMessages)
+{
+    ReliableCommandQueue queue(1, sender());
+    queue.print(0, ReliableCommandQueue::Priority::Normal, "text");
+    queue.clear(0);
+    queue.flushAll();
+
+    EXPECT_EQ(0u, sent.size());
+}
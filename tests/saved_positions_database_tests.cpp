@@ -0,0 +1,130 @@
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+#include "../src/game/etj_saved_positions_database.h"
+
+using namespace ETJump;
+
+class SavedPositionsDatabaseTests : public testing::Test
+{
+public:
+    void SetUp() override
+    {
+        path = testing::TempDir() + "saved_positions_database_tests.db";
+        removeDatabase();
+        errors.clear();
+    }
+
+    void TearDown() override
+    {
+        removeDatabase();
+    }
+
+    void removeDatabase()
+    {
+        std::remove(path.c_str());
+        std::remove((path + "-wal").c_str());
+        std::remove((path + "-shm").c_str());
+    }
+
+    SavedPositionsDatabase::LogError logger()
+    {
+        return [this](const std::string& error)
+        {
+            errors.push_back(error);
+        };
+    }
+
+    static SaveSystem::DisconnectedClient positions(float x)
+    {
+        SaveSystem::DisconnectedClient client;
+        client.progression = 7;
+        client.alliesSavedPositions[0].isValid = true;
+        client.alliesSavedPositions[0].origin[0] = x;
+        client.alliesSavedPositions[0].origin[1] = -2.5f;
+        client.alliesSavedPositions[0].vangles[1] = 90;
+        client.axisSavedPositions[2].isValid = true;
+        client.axisSavedPositions[2].origin[2] = 128.125f;
+        return client;
+    }
+
+    // runs frames until the fetch callback has been called
+    static bool fetch(SavedPositionsDatabase& database, const std::string& guid,
+                      bool& found, SaveSystem::DisconnectedClient& result)
+    {
+        auto called = false;
+        database.fetch(guid, [&](const SaveSystem::DisconnectedClient *positions)
+        {
+            called = true;
+            found = positions != nullptr;
+            if (positions)
+            {
+                result = *positions;
+            }
+        });
+
+        for (auto i = 0; i < 500 && !called; ++i)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            database.runFrame();
+        }
+        return called;
+    }
+
+    std::string path;
+    std::vector<std::string> errors;
+};
+
+TEST_F(SavedPositionsDatabaseTests, store_ShouldSurviveRecreatingTheDatabase)
+{
+    {
+        SavedPositionsDatabase database(path, "map", 4, 30, logger());
+        database.store("guid", positions(64.5f));
+    }
+
+    SavedPositionsDatabase database(path, "map", 4, 30, logger());
+    auto found = false;
+    SaveSystem::DisconnectedClient result;
+    ASSERT_TRUE(fetch(database, "guid", found, result));
+    ASSERT_TRUE(found);
+
+    EXPECT_EQ(7, result.progression);
+    EXPECT_TRUE(result.alliesSavedPositions[0].isValid);
+    EXPECT_FLOAT_EQ(64.5f, result.alliesSavedPositions[0].origin[0]);
+    EXPECT_FLOAT_EQ(-2.5f, result.alliesSavedPositions[0].origin[1]);
+    EXPECT_FLOAT_EQ(90, result.alliesSavedPositions[0].vangles[1]);
+    EXPECT_FALSE(result.alliesSavedPositions[1].isValid);
+    EXPECT_TRUE(result.axisSavedPositions[2].isValid);
+    EXPECT_FLOAT_EQ(128.125f, result.axisSavedPositions[2].origin[2]);
+    EXPECT_TRUE(errors.empty());
+}
+
+TEST_F(SavedPositionsDatabaseTests, flush_ShouldWriteStoredPositions)
+{
+    SavedPositionsDatabase writer(path, "map", 4, 30, logger());
+    writer.store("guid", positions(1));
+    writer.flush();
+
+    SavedPositionsDatabase reader(path, "map", 4, 30, logger());
+    auto found = false;
+    SaveSystem::DisconnectedClient result;
+    ASSERT_TRUE(fetch(reader, "guid", found, result));
+    EXPECT_TRUE(found);
+}
+
+TEST_F(SavedPositionsDatabaseTests, fetch_ShouldNotFindPositionsOfOtherMaps)
+{
+    {
+        SavedPositionsDatabase database(path, "map", 4, 30, logger());
+        database.store("guid", positions(1));
+    }
+
+    SavedPositionsDatabase database(path, "other", 4, 30, logger());
+    auto found = true;
+    SaveSystem::DisconnectedClient result;
+    ASSERT_TRUE(fetch(database, "guid", found, result));
+    EXPECT_FALSE(found);
+}
@@ -0,0 +1,115 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <vector>
+#include "../src/cgame/etj_snaphud_zones.h"
+#include "../src/game/q_shared.h"
+
+using namespace ETJump;
+
+class SnapZoneCacheTests : public testing::Test
+{
+public:
+    void SetUp() override
+    {
+
+    }
+
+    void TearDown() override
+    {
+
+    }
+
+    // zones as computed every frame before they were cached
+    static std::vector<float> referenceZones(float speed)
+    {
+        float zones[SnapZoneCache::MaxZones];
+        int count = 0;
+        float step;
+
+        speed /= 125;
+
+        for (step = floor(speed + 0.5) - 0.5; step > 0 && count < SnapZoneCache::MaxZones - 2; step--)
+        {
+            zones[count] = RAD2DEG(acos(step / speed));
+            count++;
+            zones[count] = RAD2DEG(asin(step / speed));
+            count++;
+        }
+
+        if (!count)
+        {
+            return {};
+        }
+
+        std::sort(zones, zones + count);
+        zones[count] = zones[0] + 90;
+        return std::vector<float>(zones, zones + count + 1);
+    }
+};
+
+TEST_F(SnapZoneCacheTests, zones_ShouldMatchDirectComputation)
+{
+    SnapZoneCache cache(4);
+
+    for (int i = 0; i < 2; ++i)
+    {
+        for (float speed = 0; speed < 10000; speed += 7.25f)
+        {
+            EXPECT_EQ(referenceZones(speed), cache.zones(speed)) << "speed " << speed;
+        }
+    }
+
+    const float speeds[] = { 256, 352, 256, 320 * 0.8f, 320 * 1.1f, 256 };
+    for (auto speed : speeds)
+    {
+        EXPECT_EQ(referenceZones(speed), cache.zones(speed)) << "speed " << speed;
+    }
+}
+
+TEST_F(SnapZoneCacheTests, zones_ShouldBeSortedAndClosed)
+{
+    SnapZoneCache cache(1);
+    const auto& zones = cache.zones(352);
+
+    ASSERT_GT(zones.size(), 2);
+    EXPECT_TRUE(std::is_sorted(zones.begin(), zones.end() - 1));
+    EXPECT_FLOAT_EQ(zones.front() + 90, zones.back());
+}
+
+TEST_F(SnapZoneCacheTests, zones_ShouldBeEmptyWithoutSnaps)
+{
+    EXPECT_TRUE(SnapZoneCache::computeZones(0).empty());
+    EXPECT_TRUE(SnapZoneCache::computeZones(62).empty());
+    EXPECT_FALSE(SnapZoneCache::computeZones(63).empty());
+}
+
+TEST_F(SnapZoneCacheTests, zones_ShouldLimitZoneCount)
+{
+    EXPECT_EQ(SnapZoneCache::MaxZones - 1, SnapZoneCache::computeZones(100000).size());
+}
+
+TEST_F(SnapZoneCacheTests, zones_ShouldDropLeastRecentlyUsedTable)
+{
+    SnapZoneCache cache(2);
+
+    cache.zones(256);
+    cache.zones(320);
+    cache.zones(256);
+    cache.zones(352);
+
+    EXPECT_EQ(2, cache.size());
+    EXPECT_TRUE(cache.contains(256));
+    EXPECT_TRUE(cache.contains(352));
+    EXPECT_FALSE(cache.contains(320));
+}
+
+TEST_F(SnapZoneCacheTests, clear_ShouldRemoveAllTables)
+{
+    SnapZoneCache cache(2);
+
+    cache.zones(256);
+    cache.clear();
+
+    EXPECT_EQ(0, cache.size());
+    EXPECT_FALSE(cache.contains(256));
+}
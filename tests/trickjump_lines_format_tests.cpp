@@ -0,0 +1,222 @@
+#include <gtest/gtest.h>
+#include <cstring>
+#include <vector>
+#include "../src/cgame/etj_trickjump_lines_format.h"
+
+using namespace ETJump;
+
+class TrickjumpLinesFormatTests : public testing::Test
+{
+public:
+    void SetUp() override
+    {
+
+    }
+
+    void TearDown() override
+    {
+
+    }
+
+    static TrickjumpLines::Node node(float x, float y, float z, float speed)
+    {
+        TrickjumpLines::Node n;
+        n.coor[0] = x;
+        n.coor[1] = y;
+        n.coor[2] = z;
+        n.speed = speed;
+        return n;
+    }
+
+    static TrickjumpLines::Route route(const std::string& name)
+    {
+        TrickjumpLines::Route r;
+        r.name = name;
+        r.color[0] = 255;
+        r.color[1] = 128;
+        r.color[2] = 0;
+        r.color[3] = 255;
+        r.width = 8.0f;
+        r.trails = {
+            { node(0, 0, 0, 320), node(10.5f, -20.25f, 4, 350.5f), node(-1000, 2000, -300, 1200) },
+            { node(-1000, 2000, -300, 1200), node(-990, 1990, -280.125f, 1180) }
+        };
+        for (int i = 0; i < 3; ++i)
+        {
+            r.start[i] = r.trails.front().front().coor[i];
+            r.end[i] = r.trails.back().back().coor[i];
+            r.mins[i] = -1000 + i;
+            r.maxs[i] = 2000 + i;
+        }
+        return r;
+    }
+
+    static bool readAll(const std::vector<unsigned char>& file, std::vector<TrickjumpLines::Route>& routes)
+    {
+        TrickjumpLinesFormat::Header header;
+        std::vector<uint32_t> sizes;
+        std::string error;
+
+        if (!TrickjumpLinesFormat::readHeader(file.data(), file.size(), header, error))
+        {
+            return false;
+        }
+
+        const auto *index = file.data() + TrickjumpLinesFormat::HeaderSize;
+        if (!TrickjumpLinesFormat::readIndex(header, index, header.indexSize, routes, sizes, error))
+        {
+            return false;
+        }
+
+        const auto *data = index + header.indexSize;
+        for (size_t i = 0; i < routes.size(); ++i)
+        {
+            if (!TrickjumpLinesFormat::readTrails(data, sizes[i], routes[i].trails))
+            {
+                return false;
+            }
+            data += sizes[i];
+        }
+        return data == file.data() + file.size();
+    }
+};
+
+TEST_F(TrickjumpLinesFormatTests, write_ShouldRoundTripRoutes)
+{
+    auto first = route("first");
+    auto second = route("second");
+    second.trails.pop_back();
+
+    const auto file = TrickjumpLinesFormat::write({ &first, &second });
+    ASSERT_TRUE(TrickjumpLinesFormat::isBinary(file.data(), file.size()));
+
+    std::vector<TrickjumpLines::Route> routes;
+    ASSERT_TRUE(readAll(file, routes));
+    ASSERT_EQ(2, routes.size());
+
+    const TrickjumpLines::Route *expected[] = { &first, &second };
+    for (size_t r = 0; r < routes.size(); ++r)
+    {
+        EXPECT_EQ(expected[r]->name, routes[r].name);
+        EXPECT_EQ(0, memcmp(expected[r]->color, routes[r].color, sizeof(routes[r].color)));
+        EXPECT_FLOAT_EQ(expected[r]->width, routes[r].width);
+        for (int i = 0; i < 3; ++i)
+        {
+            EXPECT_FLOAT_EQ(expected[r]->start[i], routes[r].start[i]);
+            EXPECT_FLOAT_EQ(expected[r]->end[i], routes[r].end[i]);
+            EXPECT_FLOAT_EQ(expected[r]->mins[i], routes[r].mins[i]);
+            EXPECT_FLOAT_EQ(expected[r]->maxs[i], routes[r].maxs[i]);
+        }
+
+        ASSERT_EQ(expected[r]->trails.size(), routes[r].trails.size());
+        for (size_t t = 0; t < routes[r].trails.size(); ++t)
+        {
+            ASSERT_EQ(expected[r]->trails[t].size(), routes[r].trails[t].size());
+            for (size_t n = 0; n < routes[r].trails[t].size(); ++n)
+            {
+                // these values are exactly representable after quantization
+                for (int i = 0; i < 3; ++i)
+                {
+                    EXPECT_FLOAT_EQ(expected[r]->trails[t][n].coor[i], routes[r].trails[t][n].coor[i]);
+                }
+                EXPECT_FLOAT_EQ(expected[r]->trails[t][n].speed, routes[r].trails[t][n].speed);
+            }
+        }
+    }
+}
+
+TEST_F(TrickjumpLinesFormatTests, write_ShouldQuantizeCoordinatesAndSpeed)
+{
+    auto r = route("quantized");
+    r.trails = { { node(1.01f, -2.3f, 100.06f, 319.99f) } };
+
+    const auto file = TrickjumpLinesFormat::write({ &r });
+    std::vector<TrickjumpLines::Route> routes;
+    ASSERT_TRUE(readAll(file, routes));
+
+    const auto& n = routes[0].trails[0][0];
+    EXPECT_NEAR(1.01f, n.coor[0], 0.5f / TrickjumpLinesFormat::CoordinateScale);
+    EXPECT_NEAR(-2.3f, n.coor[1], 0.5f / TrickjumpLinesFormat::CoordinateScale);
+    EXPECT_NEAR(100.06f, n.coor[2], 0.5f / TrickjumpLinesFormat::CoordinateScale);
+    EXPECT_NEAR(319.99f, n.speed, 0.5f / TrickjumpLinesFormat::SpeedScale);
+}
+
+TEST_F(TrickjumpLinesFormatTests, write_ShouldBeSmallerThanFourFloatsPerNode)
+{
+    auto r = route("long");
+    r.trails.clear();
+    std::vector<TrickjumpLines::Node> trail;
+    for (int i = 0; i < 1000; ++i)
+    {
+        trail.push_back(node(i * 12.5f, i * -3.0f, 50 + (i % 10), 320 + i * 0.5f));
+    }
+    r.trails.push_back(trail);
+
+    const auto file = TrickjumpLinesFormat::write({ &r });
+    EXPECT_LT(file.size(), trail.size() * 4 * sizeof(float) / 2);
+}
+
+TEST_F(TrickjumpLinesFormatTests, isBinary_ShouldNotAcceptJson)
+{
+    const std::string json = "[{\"name\":\"route\"}]";
+    EXPECT_FALSE(TrickjumpLinesFormat::isBinary(reinterpret_cast<const unsigned char *>(json.data()), json.size()));
+}
+
+TEST_F(TrickjumpLinesFormatTests, readIndex_ShouldFailOnTruncatedIndex)
+{
+    auto r = route("truncated");
+    const auto file = TrickjumpLinesFormat::write({ &r });
+
+    TrickjumpLinesFormat::Header header;
+    std::string error;
+    ASSERT_TRUE(TrickjumpLinesFormat::readHeader(file.data(), file.size(), header, error));
+
+    std::vector<TrickjumpLines::Route> routes;
+    std::vector<uint32_t> sizes;
+    EXPECT_FALSE(TrickjumpLinesFormat::readIndex(header, file.data() + TrickjumpLinesFormat::HeaderSize,
+        header.indexSize - 1, routes, sizes, error));
+}
+
+TEST_F(TrickjumpLinesFormatTests, readTrails_ShouldFailOnTruncatedData)
+{
+    auto r = route("truncated");
+    const auto file = TrickjumpLinesFormat::write({ &r });
+
+    std::vector<TrickjumpLines::Route> routes;
+    ASSERT_TRUE(readAll(file, routes));
+
+    TrickjumpLinesFormat::Header header;
+    std::string error;
+    ASSERT_TRUE(TrickjumpLinesFormat::readHeader(file.data(), file.size(), header, error));
+    const auto *data = file.data() + TrickjumpLinesFormat::HeaderSize + header.indexSize;
+    const auto size = file.size() - TrickjumpLinesFormat::HeaderSize - header.indexSize;
+
+    std::vector<std::vector<TrickjumpLines::Node>> trails;
+    EXPECT_TRUE(TrickjumpLinesFormat::readTrails(data, size, trails));
+    EXPECT_FALSE(TrickjumpLinesFormat::readTrails(data, size - 1, trails));
+}
+
+TEST_F(TrickjumpLinesFormatTests, readTrails_ShouldFailOnOutOfRangeCoordinates)
+{
+    // one trail of two nodes, each moving x by the largest positive delta
+    const unsigned char data[] = {
+        1, 2,
+        0xfe, 0xff, 0xff, 0xff, 0x0f, 0, 0, 0,
+        0xfe, 0xff, 0xff, 0xff, 0x0f, 0, 0, 0
+    };
+
+    std::vector<std::vector<TrickjumpLines::Node>> trails;
+    EXPECT_FALSE(TrickjumpLinesFormat::readTrails(data, sizeof(data), trails));
+}
+
+TEST_F(TrickjumpLinesFormatTests, write_ShouldClampCoordinatesOutOfRange)
+{
+    auto r = route("far");
+    r.trails = { { node(1e30f, -1e30f, 0, 320), node(-1e30f, 1e30f, 0, 320) } };
+
+    const auto file = TrickjumpLinesFormat::write({ &r });
+    std::vector<TrickjumpLines::Route> routes;
+    ASSERT_TRUE(readAll(file, routes));
+    EXPECT_GT(routes[0].trails[0][0].coor[0], 0);
+    EXPECT_LT(routes[0].trails[0][1].coor[0], 0);
+}